@@ -3,8 +3,29 @@
 
     #include <WString.h>
     #include <pgmspace.h>
+    #include <HtmlTemplate.h>
 
-    const char PROGMEM HTML_PAGE_TEMPLATE[] = {
+    // *****************************************************************************
+    // Slots which may appear as ${name} in the templates below, the names must be 
+    // in the same order as the HtmlSlot values.
+    // *****************************************************************************
+    enum HtmlSlot {
+        HS_TITLE,
+        HS_HEADING,
+        HS_CONTENT,
+        HS_SETTINGS,
+        HS_FIRMWARE_VERSION
+    };
+
+    constexpr const char* HTML_SLOT_NAMES[] = {
+        "title",
+        "heading",
+        "content",
+        "settings",
+        "firmware_version"
+    };
+
+    constexpr char PROGMEM HTML_PAGE_TEMPLATE[] = {
         "<!DOCTYPE HTML> "
         "<html lang=\"en\"> "
         "<head> "
@@ -25,7 +46,7 @@
         "</html>"
     };
 
-    const char PROGMEM ADMIN_PAGE[] = {
+    constexpr char PROGMEM ADMIN_PAGE[] = {
         "<form name=\"settings\" method=\"POST\" id=\"settings\" action=\"update\"> "
             "<h2>Configuration</h2> "
             "Settings as JSON: <textarea name=\"data\" rows=\"25\" cols=\"90\">${settings}</textarea>"
@@ -34,9 +55,13 @@
         "</form>"
     };
 
-    const char PROGMEM ROOT_PAGE[] = {
+    constexpr char PROGMEM ROOT_PAGE[] = {
         "Device:\tFriendlyNeighbor Panic Button<br>"
         "Firmware Version:\t${firmware_version}<br>"
     };
 
+    constexpr auto HTML_PAGE_PARTS = HTML_SPLIT(HTML_PAGE_TEMPLATE, HTML_SLOT_NAMES);
+    constexpr auto ADMIN_PAGE_PARTS = HTML_SPLIT(ADMIN_PAGE, HTML_SLOT_NAMES);
+    constexpr auto ROOT_PAGE_PARTS = HTML_SPLIT(ROOT_PAGE, HTML_SLOT_NAMES);
+
 #endif
\ No newline at end of file
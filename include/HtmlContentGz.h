@@ -0,0 +1,77 @@
+// GENERATED by scripts/gzip_html.py from HtmlContent.h, DO NOT EDIT.
+
+#ifndef HtmlContentGz_h
+    #define HtmlContentGz_h
+
+    #include <pgmspace.h>
+    #include <HtmlTemplate.h>
+
+    // HTML_PAGE_TEMPLATE: 619 bytes as 357 compressed
+    const uint8_t PROGMEM HTML_PAGE_TEMPLATE_GZ[] = {
+        0xB2, 0x51, 0x74, 0xF1, 0x77, 0x0E, 0x89, 0x0C, 0x70, 0x55, 0xF0, 0x08, 0xF1, 0xF5, 0xB1, 0x53,
+        0xB0, 0xC9, 0x28, 0xC9, 0xCD, 0x51, 0xC8, 0x49, 0xCC, 0x4B, 0xB7, 0x55, 0x4A, 0xCD, 0x53, 0x02,
+        0x09, 0xA4, 0x26, 0xA6, 0x00, 0xA9, 0x92, 0xCC, 0x92, 0x9C, 0x54, 0x3B, 0x00, 0x00, 0x00, 0x00,
+        0xFF, 0xFF, 0x94, 0x91, 0xE1, 0x6A, 0x83, 0x30, 0x14, 0x85, 0x5F, 0xE5, 0x52, 0xD9, 0xCF, 0xA0,
+        0x56, 0x5C, 0x4B, 0x74, 0x85, 0x8D, 0x75, 0xEF, 0x11, 0x4D, 0x34, 0x97, 0x66, 0x89, 0xC4, 0x38,
+        0xED, 0x46, 0xDF, 0x7D, 0x31, 0xD5, 0x6E, 0x3F, 0x0A, 0x63, 0x17, 0x42, 0xB8, 0x1F, 0x39, 0xE7,
+        0xDE, 0x43, 0xCA, 0xD8, 0xA1, 0x53, 0xE2, 0x00, 0x65, 0xEF, 0xCE, 0xF3, 0x5D, 0x19, 0x7E, 0x86,
+        0x2F, 0xA8, 0x58, 0x7D, 0x6A, 0xAD, 0x19, 0x34, 0x27, 0xB5, 0x51, 0xC6, 0x52, 0x88, 0xDE, 0x42,
+        0x15, 0xB0, 0xF6, 0x49, 0xA8, 0x02, 0x2E, 0x20, 0x53, 0xAF, 0x70, 0x62, 0x72, 0x84, 0x29, 0x6C,
+        0x35, 0x85, 0x5A, 0x68, 0x27, 0x6C, 0x71, 0xCF, 0x25, 0xDF, 0xEF, 0xF6, 0x2F, 0xC9, 0x8F, 0xCB,
+        0xEA, 0x5A, 0x19, 0xCB, 0x85, 0x07, 0x59, 0x37, 0xAD, 0x0D, 0xB1, 0x8C, 0xE3, 0xD0, 0x53, 0x48,
+        0xF3, 0x19, 0xFA, 0x39, 0xDB, 0xFF, 0xCC, 0x79, 0x7E, 0xFD, 0x73, 0xCE, 0x05, 0xA2, 0xD1, 0xB2,
+        0xAE, 0x13, 0xF6, 0x7E, 0xE4, 0xE3, 0xE3, 0x31, 0x88, 0x3A, 0xC6, 0x39, 0xEA, 0x96, 0xC2, 0x36,
+        0x99, 0x65, 0xEF, 0xCC, 0xB6, 0xA8, 0x89, 0x12, 0x8D, 0xA3, 0xC0, 0x06, 0x67, 0x6E, 0xC8, 0x62,
+        0x2B, 0x7F, 0xB1, 0x89, 0x8C, 0xC8, 0x9D, 0xA4, 0xB0, 0xCB, 0x93, 0x6B, 0xAE, 0x89, 0xF4, 0x92,
+        0x71, 0x33, 0x86, 0x05, 0x6E, 0x27, 0xCA, 0xB2, 0x6C, 0x5E, 0x06, 0x75, 0x63, 0xFC, 0x26, 0x8D,
+        0xD1, 0x8E, 0xF4, 0xF8, 0x29, 0xFC, 0xAB, 0xA0, 0x0B, 0x60, 0x14, 0x57, 0xF3, 0xCA, 0x28, 0x5E,
+        0x80, 0x42, 0x2D, 0x88, 0x5C, 0x50, 0x9A, 0x27, 0x0F, 0x73, 0x9A, 0x32, 0x5E, 0x7E, 0xB1, 0x8C,
+        0xA5, 0x60, 0xDC, 0xDF, 0x1C, 0x3F, 0x00, 0xF9, 0xD3, 0x66, 0x89, 0xB9, 0xF1, 0x48, 0xA6, 0x87,
+        0x6F, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x15, 0x00, 0xEA, 0xFF, 0x3C, 0x2F, 0x68, 0x31, 0x3E,
+        0x20, 0x3C, 0x64, 0x69, 0x76, 0x20, 0x69, 0x64, 0x3D, 0x22, 0x69, 0x6E, 0x66, 0x6F, 0x22, 0x3E,
+        0xB2, 0xD1, 0x4F, 0xC9, 0x2C, 0xB3, 0x53, 0xB0, 0x81, 0x51, 0x19, 0x25, 0xB9, 0x39, 0x76, 0x00,
+        0x00, 0x00, 0x00, 0xFF, 0xFF,
+    };
+    const HtmlDeflatedSegment HTML_PAGE_TEMPLATE_GZ_SEGMENTS[] = {
+        {0, 50},
+        {50, 260},
+        {310, 26},
+        {336, 21}
+    };
+    const HtmlDeflated HTML_PAGE_TEMPLATE_DEFLATED = {HTML_PAGE_TEMPLATE_GZ, HTML_PAGE_TEMPLATE_GZ_SEGMENTS};
+
+    // ADMIN_PAGE: 205 bytes as 174 compressed
+    const uint8_t PROGMEM ADMIN_PAGE_GZ[] = {
+        0x4C, 0x8D, 0x41, 0x0A, 0xC2, 0x30, 0x10, 0x45, 0xAF, 0x32, 0xCC, 0x05, 0x94, 0x82, 0x0B, 0x25,
+        0xC9, 0xC6, 0x9D, 0x0B, 0x5B, 0x48, 0x2F, 0x30, 0x34, 0xD3, 0x36, 0x60, 0x32, 0x92, 0x4C, 0xB1,
+        0xC7, 0x37, 0x42, 0x17, 0xEE, 0x3E, 0xEF, 0xF1, 0xF8, 0x66, 0x96, 0x92, 0x20, 0x53, 0x62, 0x8B,
+        0x95, 0x55, 0x63, 0x5E, 0x2A, 0x42, 0x62, 0x5D, 0x25, 0x58, 0x1C, 0x7A, 0x3F, 0x22, 0xC4, 0xF0,
+        0xEF, 0x68, 0xD2, 0x28, 0xD9, 0xE2, 0xF6, 0x0E, 0xA4, 0x8C, 0x0E, 0xCC, 0xDA, 0xB9, 0xBB, 0xE4,
+        0x39, 0x2E, 0x5B, 0xA1, 0x9F, 0x33, 0xA7, 0x46, 0xC0, 0x1F, 0x05, 0x50, 0x85, 0x87, 0xEF, 0x9F,
+        0x37, 0x30, 0xCA, 0xBB, 0x52, 0x61, 0x3A, 0xFE, 0x5A, 0x4F, 0x08, 0x45, 0x3E, 0xD5, 0x62, 0x77,
+        0x41, 0x98, 0xE4, 0xD5, 0xD6, 0xF5, 0x8C, 0xEE, 0x0B, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x2C, 0x00,
+        0xD3, 0xFF, 0x3C, 0x2F, 0x74, 0x65, 0x78, 0x74, 0x61, 0x72, 0x65, 0x61, 0x3E, 0x3C, 0x62, 0x72,
+        0x3E, 0x20, 0x3C, 0x69, 0x6E, 0x70, 0x75, 0x74, 0x20, 0x74, 0x79, 0x70, 0x65, 0x3D, 0x22, 0x73,
+        0x75, 0x62, 0x6D, 0x69, 0x74, 0x22, 0x3E, 0x3C, 0x2F, 0x66, 0x6F, 0x72, 0x6D, 0x3E,
+    };
+    const HtmlDeflatedSegment ADMIN_PAGE_GZ_SEGMENTS[] = {
+        {0, 125},
+        {125, 49}
+    };
+    const HtmlDeflated ADMIN_PAGE_DEFLATED = {ADMIN_PAGE_GZ, ADMIN_PAGE_GZ_SEGMENTS};
+
+    // ROOT_PAGE: 82 bytes as 73 compressed
+    const uint8_t PROGMEM ROOT_PAGE_GZ[] = {
+        0x00, 0x3B, 0x00, 0xC4, 0xFF, 0x44, 0x65, 0x76, 0x69, 0x63, 0x65, 0x3A, 0x09, 0x46, 0x72, 0x69,
+        0x65, 0x6E, 0x64, 0x6C, 0x79, 0x4E, 0x65, 0x69, 0x67, 0x68, 0x62, 0x6F, 0x72, 0x20, 0x50, 0x61,
+        0x6E, 0x69, 0x63, 0x20, 0x42, 0x75, 0x74, 0x74, 0x6F, 0x6E, 0x3C, 0x62, 0x72, 0x3E, 0x46, 0x69,
+        0x72, 0x6D, 0x77, 0x61, 0x72, 0x65, 0x20, 0x56, 0x65, 0x72, 0x73, 0x69, 0x6F, 0x6E, 0x3A, 0x09,
+        0x00, 0x04, 0x00, 0xFB, 0xFF, 0x3C, 0x62, 0x72, 0x3E,
+    };
+    const HtmlDeflatedSegment ROOT_PAGE_GZ_SEGMENTS[] = {
+        {0, 64},
+        {64, 9}
+    };
+    const HtmlDeflated ROOT_PAGE_DEFLATED = {ROOT_PAGE_GZ, ROOT_PAGE_GZ_SEGMENTS};
+
+#endif
@@ -0,0 +1,282 @@
+/*
+ * AlertDispatcher - Queues alert messages as jobs and delivers them one
+ * recipient at a time. Each recipient of a job has its own delivery status
+ * and failed recipients are retried with a growing delay between attempts.
+ * The work is done in small steps from the scheduler so the device stays
+ * responsive while messages are being delivered.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include "AlertDispatcher.h"
+
+/**
+ * #### CLASS CONSTRUCTOR ####
+ *
+ * @param sender The function which sends a message of the given type to a
+ * single recipient, returning true on success, as AlertSender.
+ * @param clock The function used to get the current time in milliseconds
+ * as ClockFunction.
+*/
+AlertDispatcher::AlertDispatcher(AlertSender sender, ClockFunction clock) {
+    this->sender = sender;
+    this->clock = clock;
+    for (int i = 0; i < ALERT_QUEUE_SIZE; i++) {
+        jobs[i].isActive = false;
+    }
+}
+
+/**
+ * Sets how many recipients jobs are delivered to, the first count of the
+ * recipients of the Settings. Jobs already queued keep the recipients
+ * they were queued for.
+ *
+ * @param count The number of recipients as uint8_t.
+ *
+ * @return Returns true if all of them will be delivered to, or false if
+ * there were more than SETTINGS_MAX_RECIPIENTS and only that many will
+ * be, as bool.
+*/
+bool AlertDispatcher::setRecipientCount(uint8_t count) {
+    if (count > SETTINGS_MAX_RECIPIENTS) { // Too many...
+        recipientCount = SETTINGS_MAX_RECIPIENTS;
+
+        return false;
+    }
+    recipientCount = count;
+
+    return true;
+}
+
+/**
+ * Sets the function which is called each time a job has finished, that is
+ * when every one of its recipients has either been sent to or has failed.
+ *
+ * @param callback The function to call as AlertJobCallback.
+*/
+void AlertDispatcher::onJobComplete(AlertJobCallback callback) {
+    onComplete = callback;
+}
+
+/**
+ * Queues a message of the given type to all recipients.
+ *
+ * @param type The type of message to send as MessageType.
+ *
+ * @return Returns true if the job was queued otherwise false as bool.
+*/
+bool AlertDispatcher::enqueue(MessageType type) {
+
+    return enqueue(type, 0xFFFFFFFFUL);
+}
+
+/**
+ * Queues a message of the given type to the recipients selected by the
+ * given mask, where bit 0 is the first recipient. Queueing a cancel will
+ * skip any recipients of earlier alerts which haven't been sent to yet,
+ * since there is no point in them getting an alert that was canceled.
+ * A cancel always gets in, if the queue is full then waiting jobs are
+ * dropped to make room for it.
+ *
+ * @param type The type of message to send as MessageType.
+ * @param recipientMask The recipients to send to as uint32_t.
+ *
+ * @return Returns true if the job was queued otherwise false as bool.
+*/
+bool AlertDispatcher::enqueue(MessageType type, uint32_t recipientMask) {
+    if (type == MT_CANCEL) {
+        makeRoomForCancel();
+    }
+    if (jobCount >= ALERT_QUEUE_SIZE) { // No room...
+
+        return false;
+    }
+
+    if (type == MT_CANCEL) {
+        for (uint8_t j = 0; j < jobCount; j++) {
+            AlertJob &queued = jobs[(jobHead + j) % ALERT_QUEUE_SIZE];
+            for (uint8_t i = 0; i < recipientCount; i++) {
+                if (queued.type != MT_CANCEL && queued.recipients[i].status == RS_PENDING) {
+                    queued.recipients[i].status = RS_SKIPPED;
+                }
+            }
+        }
+    }
+
+    AlertJob &job = jobs[(jobHead + jobCount) % ALERT_QUEUE_SIZE];
+    job.type = type;
+    job.isActive = true;
+    uint32_t now = clock();
+    for (uint8_t i = 0; i < SETTINGS_MAX_RECIPIENTS; i++) {
+        bool isSelected = (i < recipientCount && (recipientMask & (1UL << i)) != 0UL);
+        job.recipients[i] = {(isSelected ? RS_PENDING : RS_UNUSED), 0U, now};
+    }
+    jobCount ++;
+
+    return true;
+}
+
+/**
+ * Does the next small piece of delivery work. Only the oldest job is
+ * worked on so messages go out in the order they were queued. At most
+ * one recipient is sent to per step. Once none of the job's recipients
+ * are left pending the job is completed.
+*/
+void AlertDispatcher::step() {
+    if (jobCount == 0U) { // Nothing to do...
+
+        return;
+    }
+
+    AlertJob &job = jobs[jobHead];
+    uint32_t now = clock();
+    bool isPending = false;
+    for (uint8_t i = 0; i < recipientCount; i++) {
+        AlertRecipient &recip = job.recipients[i];
+        if (recip.status != RS_PENDING) {
+            continue;
+        }
+
+        isPending = true;
+        if (!isDue(now, recip.nextAttempt)) { // Waiting to retry...
+            continue;
+        }
+
+        recip.attempts ++;
+        if (sender(job.type, i)) { // Delivered...
+            recip.status = RS_SENT;
+        } else if (recip.attempts >= ALERT_MAX_ATTEMPTS) { // Giving up...
+            recip.status = RS_FAILED;
+        } else { // Retry later with backoff...
+            recip.nextAttempt = clock() + (ALERT_RETRY_BASE_MS << (recip.attempts - 1U));
+        }
+
+        return;
+    }
+
+    if (!isPending) {
+        completeJob(job);
+    }
+}
+
+/**
+ * @return Returns true if there are no jobs queued or in progress as bool.
+*/
+bool AlertDispatcher::isIdle() {
+
+    return (jobCount == 0U);
+}
+
+/**
+ * @param type The type of message to look for as MessageType.
+ *
+ * @return Returns true if a job of the given type is queued or in
+ * progress as bool.
+*/
+bool AlertDispatcher::isQueued(MessageType type) {
+    for (uint8_t j = 0; j < jobCount; j++) {
+        if (jobs[(jobHead + j) % ALERT_QUEUE_SIZE].type == type) {
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @return Returns the number of recipients as uint8_t.
+*/
+uint8_t AlertDispatcher::getRecipientCount() {
+
+    return recipientCount;
+}
+
+/**
+ * Builds a mask of the recipients of the given job which have the given
+ * status, suitable for passing to 'enqueue'.
+ *
+ * @param job The job to build the mask from as AlertJob reference.
+ * @param status The status to select as RecipientStatus.
+ *
+ * @return Returns the mask as uint32_t.
+*/
+uint32_t AlertDispatcher::maskOf(AlertJob &job, RecipientStatus status) {
+    uint32_t mask = 0UL;
+    for (uint8_t i = 0; i < SETTINGS_MAX_RECIPIENTS; i++) {
+        if (job.recipients[i].status == status) {
+            mask |= (1UL << i);
+        }
+    }
+
+    return mask;
+}
+
+/*
+=================================================================
+Private Functions
+=================================================================
+*/
+
+/**
+ * #### PRIVATE ####
+ * Removes the finished job from the queue and reports its results. A copy
+ * of the job is reported so the callback is free to queue new jobs.
+*/
+void AlertDispatcher::completeJob(AlertJob &job) {
+    AlertJob finished = job;
+    job.isActive = false;
+    jobHead = (jobHead + 1U) % ALERT_QUEUE_SIZE;
+    jobCount --;
+
+    uint8_t sent = 0U;
+    uint8_t failed = 0U;
+    for (uint8_t i = 0; i < recipientCount; i++) {
+        if (finished.recipients[i].status == RS_SENT) {
+            sent ++;
+        } else if (finished.recipients[i].status == RS_FAILED) {
+            failed ++;
+        }
+    }
+
+    if (onComplete != nullptr) {
+        onComplete(finished, sent, failed);
+    }
+}
+
+/**
+ * #### PRIVATE ####
+ * Frees a place in a full queue for a cancel. The oldest job is kept as
+ * it may be part way through a send. Waiting alerts and partials are
+ * dropped first, since a cancel would skip their recipients anyway, and
+ * only if that isn't enough are waiting cancels dropped, as the new one
+ * goes to the same recipients. Dropped jobs aren't reported as complete.
+*/
+void AlertDispatcher::makeRoomForCancel() {
+    for (uint8_t pass = 0; pass < 2 && jobCount >= ALERT_QUEUE_SIZE; pass++) {
+        uint8_t kept = 1U;
+        for (uint8_t j = 1; j < jobCount; j++) {
+            AlertJob &queued = jobs[(jobHead + j) % ALERT_QUEUE_SIZE];
+            if (pass == 1 || queued.type != MT_CANCEL) { // Dropped...
+                queued.isActive = false;
+                continue;
+            }
+            if (kept != j) { // Close the gap...
+                jobs[(jobHead + kept) % ALERT_QUEUE_SIZE] = queued;
+                queued.isActive = false;
+            }
+            kept ++;
+        }
+        jobCount = kept;
+    }
+}
+
+/**
+ * #### PRIVATE ####
+ * Wraparound safe check of whether the given deadline has been reached.
+*/
+bool AlertDispatcher::isDue(uint32_t now, uint32_t deadline) {
+
+    return ((int32_t)(now - deadline) >= 0);
+}
@@ -0,0 +1,93 @@
+/*
+ * AlertDispatcher - Queues alert messages as jobs and delivers them one
+ * recipient at a time. Each recipient of a job has its own delivery status
+ * and failed recipients are retried with a growing delay between attempts.
+ * The work is done in small steps from the scheduler so the device stays
+ * responsive while messages are being delivered.
+ *
+ * Recipients are known by their index in the recipients of the Settings,
+ * so no addresses are copied here. The actual sending of a message to a
+ * single recipient is done by the AlertSender function given during
+ * construction, which looks the address up by that index.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef AlertDispatcher_h
+    #define AlertDispatcher_h
+
+    #include <stdint.h>
+    #include <string.h>
+    #include <Scheduler.h>
+    #include <Settings.h>
+
+    static_assert(SETTINGS_MAX_RECIPIENTS <= 32, "Recipients are selected by a 32 bit mask!");
+
+    #define ALERT_QUEUE_SIZE 4
+    #define ALERT_MAX_ATTEMPTS 3
+    #define ALERT_RETRY_BASE_MS 5000UL
+
+    enum MessageType {
+        MT_ALERT,
+        MT_PARTIAL,
+        MT_CANCEL
+    };
+
+    enum RecipientStatus {
+        RS_UNUSED,
+        RS_PENDING,
+        RS_SENT,
+        RS_FAILED,
+        RS_SKIPPED
+    };
+
+    struct AlertRecipient {
+        RecipientStatus    status                      ;
+        uint8_t            attempts                    ;
+        uint32_t           nextAttempt                 ;
+    };
+
+    struct AlertJob {
+        MessageType        type                        ;
+        bool               isActive                    ;
+        AlertRecipient     recipients  [SETTINGS_MAX_RECIPIENTS];
+    };
+
+    typedef bool (*AlertSender)(MessageType type, uint8_t recipient);
+    typedef void (*AlertJobCallback)(AlertJob &job, uint8_t sentCount, uint8_t failedCount);
+
+    class AlertDispatcher {
+        private:
+            AlertJob jobs[ALERT_QUEUE_SIZE];
+            uint8_t jobHead = 0U;
+            uint8_t jobCount = 0U;
+
+            uint8_t recipientCount = 0U;
+
+            AlertSender sender;
+            AlertJobCallback onComplete = nullptr;
+            ClockFunction clock;
+
+            void completeJob(AlertJob &job);
+            void makeRoomForCancel();
+            static bool isDue(uint32_t now, uint32_t deadline);
+
+        public:
+            AlertDispatcher(AlertSender sender, ClockFunction clock);
+
+            bool setRecipientCount(uint8_t count);
+            void onJobComplete(AlertJobCallback callback);
+
+            bool enqueue(MessageType type);
+            bool enqueue(MessageType type, uint32_t recipientMask);
+            void step();
+
+            bool isIdle();
+            bool isQueued(MessageType type);
+            uint8_t getRecipientCount();
+
+            static uint32_t maskOf(AlertJob &job, RecipientStatus status);
+    };
+
+#endif
@@ -0,0 +1,210 @@
+/*
+ * ButtonMonitor - Turns raw button edges into debounced button events.
+ * Edges are pushed into a small queue from the pin change interrupts, each
+ * stamped with the time it happened, and are later worked through by the
+ * main loop. Because of this a press that happens while the main loop is
+ * busy is still seen, with its original timing, once the loop gets to it.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include "ButtonMonitor.h"
+
+/**
+ * #### CLASS CONSTRUCTOR ####
+ *
+ * @param debounceMs How long a level must be held before it is believed,
+ * in millis as uint32_t.
+ * @param longPressMs How long a button must be held before a long press
+ * event is given, in millis as uint32_t.
+*/
+ButtonMonitor::ButtonMonitor(uint32_t debounceMs, uint32_t longPressMs) {
+    this->debounceMs = debounceMs;
+    this->longPressMs = longPressMs;
+    begin(false, false);
+}
+
+/**
+ * Sets the starting level of the buttons and clears any queued edges or
+ * events. This should be called just before the interrupts are attached.
+ *
+ * @param panicLevel True if the panic button is currently pressed as bool.
+ * @param cancelLevel True if the cancel button is currently pressed as bool.
+*/
+void ButtonMonitor::begin(bool panicLevel, bool cancelLevel) {
+    bool levels[BUTTON_COUNT] = {panicLevel, cancelLevel};
+    for (int i = 0; i < BUTTON_COUNT; i++) {
+        buttons[i] = {levels[i], levels[i], 0UL, 0UL, true};
+    }
+
+    edgeHead = 0U;
+    edgeTail = 0U;
+    isEdgeOverflow = false;
+    eventHead = 0U;
+    eventTail = 0U;
+    isChordActive = false;
+}
+
+/**
+ * #### INTERRUPT SAFE ####
+ * Queues a raw edge of the given button. This is meant to be called from
+ * the pin change interrupt, with the level read from the pin at that time.
+ * If the queue is full the edge is dropped and the overflow is flagged.
+ *
+ * @param button The ButtonId of the button as uint8_t.
+ * @param level True if the button is pressed as bool.
+ * @param timestamp The time of the edge in millis as uint32_t.
+*/
+void IRAM_ATTR ButtonMonitor::pushEdge(uint8_t button, bool level, uint32_t timestamp) {
+    uint8_t next = (edgeHead + 1U) & (BUTTON_EDGE_QUEUE_SIZE - 1U);
+    if (next == edgeTail || button >= BUTTON_COUNT) { // Queue full or bad button...
+        isEdgeOverflow = true;
+
+        return;
+    }
+
+    edges[edgeHead].button = button;
+    edges[edgeHead].level = level;
+    edges[edgeHead].timestamp = timestamp;
+    edgeHead = next;
+}
+
+/**
+ * Works through all queued edges in the order they happened and then
+ * advances the debounce, long press and chord tracking up to the given
+ * time. Any resulting events are then available from 'pollEvent'.
+ *
+ * @param now The current time in millis as uint32_t.
+*/
+void ButtonMonitor::update(uint32_t now) {
+    while (edgeTail != edgeHead) { // Edges to process...
+        uint8_t button = edges[edgeTail].button;
+        bool level = edges[edgeTail].level;
+        uint32_t timestamp = edges[edgeTail].timestamp;
+        edgeTail = (edgeTail + 1U) & (BUTTON_EDGE_QUEUE_SIZE - 1U);
+
+        settle(button, timestamp);
+        buttons[button].candidateLevel = level;
+        buttons[button].candidateSince = timestamp;
+    }
+
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        settle(i, now);
+    }
+
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) { // Check for long presses...
+        ButtonTrack &track = buttons[i];
+        if (
+            track.stableLevel
+            && !track.isLongPressSent
+            && !isChordActive
+            && (now - track.pressedAt) >= longPressMs
+        ) {
+            track.isLongPressSent = true;
+            emit(BE_LONG_PRESS, i, track.pressedAt + longPressMs);
+        }
+    }
+}
+
+/**
+ * Takes the oldest pending event if there is one.
+ *
+ * @param event Where to store the event as ButtonEvent reference.
+ *
+ * @return Returns true if an event was taken otherwise false as bool.
+*/
+bool ButtonMonitor::pollEvent(ButtonEvent &event) {
+    if (eventTail == eventHead) {
+
+        return false;
+    }
+
+    event = events[eventTail];
+    eventTail = (eventTail + 1U) & (BUTTON_EVENT_QUEUE_SIZE - 1U);
+
+    return true;
+}
+
+/**
+ * @param button The ButtonId of the button as uint8_t.
+ *
+ * @return Returns true if the debounced state of the button is pressed
+ * otherwise false as bool.
+*/
+bool ButtonMonitor::isPressed(uint8_t button) {
+
+    return (button < BUTTON_COUNT && buttons[button].stableLevel);
+}
+
+/**
+ * Used to find out if edges have been lost because the queue was full,
+ * the flag is cleared by the call.
+ *
+ * @return Returns true if edges were lost otherwise false as bool.
+*/
+bool ButtonMonitor::hadOverflow() {
+    bool result = isEdgeOverflow;
+    isEdgeOverflow = false;
+
+    return result;
+}
+
+/*
+=================================================================
+Private Functions
+=================================================================
+*/
+
+/**
+ * #### PRIVATE ####
+ * Commits the pending level of a button if it has remained unchanged
+ * for the debounce time as of the given time.
+*/
+void ButtonMonitor::settle(uint8_t button, uint32_t now) {
+    ButtonTrack &track = buttons[button];
+    if (track.candidateLevel != track.stableLevel && (now - track.candidateSince) >= debounceMs) {
+        commit(button);
+    }
+}
+
+/**
+ * #### PRIVATE ####
+ * Makes the pending level of a button its stable level and gives the
+ * related press, release or chord events.
+*/
+void ButtonMonitor::commit(uint8_t button) {
+    ButtonTrack &track = buttons[button];
+    track.stableLevel = track.candidateLevel;
+
+    if (track.stableLevel) { // Pressed...
+        track.pressedAt = track.candidateSince;
+        track.isLongPressSent = false;
+        emit(BE_PRESSED, button, track.candidateSince);
+
+        if (!isChordActive && buttons[BTN_PANIC].stableLevel && buttons[BTN_CANCEL].stableLevel) {
+            isChordActive = true;
+            emit(BE_CHORD, button, track.candidateSince);
+        }
+    } else { // Released...
+        emit(BE_RELEASED, button, track.candidateSince);
+
+        if (!buttons[BTN_PANIC].stableLevel && !buttons[BTN_CANCEL].stableLevel) {
+            isChordActive = false;
+        }
+    }
+}
+
+/**
+ * #### PRIVATE ####
+ * Queues an event, if the event queue is full the oldest event is lost.
+*/
+void ButtonMonitor::emit(ButtonEventType type, uint8_t button, uint32_t timestamp) {
+    uint8_t next = (eventHead + 1U) & (BUTTON_EVENT_QUEUE_SIZE - 1U);
+    if (next == eventTail) { // Full, drop oldest...
+        eventTail = (eventTail + 1U) & (BUTTON_EVENT_QUEUE_SIZE - 1U);
+    }
+
+    events[eventHead] = {type, button, timestamp};
+    eventHead = next;
+}
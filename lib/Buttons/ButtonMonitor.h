@@ -0,0 +1,95 @@
+/*
+ * ButtonMonitor - Turns raw button edges into debounced button events.
+ * Edges are pushed into a small queue from the pin change interrupts, each
+ * stamped with the time it happened, and are later worked through by the
+ * main loop. Because of this a press that happens while the main loop is
+ * busy is still seen, with its original timing, once the loop gets to it.
+ *
+ * The class does not read any pins itself, the levels and times are given
+ * to it, so it can be fed synthetic edges when built for the host.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef ButtonMonitor_h
+    #define ButtonMonitor_h
+
+    #include <stdint.h>
+
+    #ifdef ARDUINO
+        #include <Arduino.h>
+    #endif
+
+    #ifndef IRAM_ATTR
+        #define IRAM_ATTR
+    #endif
+
+    #define BUTTON_COUNT 2
+    #define BUTTON_EDGE_QUEUE_SIZE 32 // Must be a power of 2
+    #define BUTTON_EVENT_QUEUE_SIZE 8 // Must be a power of 2
+
+    enum ButtonId {
+        BTN_PANIC = 0,
+        BTN_CANCEL = 1
+    };
+
+    enum ButtonEventType {
+        BE_PRESSED,
+        BE_RELEASED,
+        BE_LONG_PRESS,
+        BE_CHORD
+    };
+
+    struct ButtonEvent {
+        ButtonEventType    type                        ;
+        uint8_t            button                      ; // Not meaningful for BE_CHORD
+        uint32_t           timestamp                   ;
+    };
+
+    class ButtonMonitor {
+        private:
+            struct Edge {
+                uint8_t        button                      ;
+                bool           level                       ;
+                uint32_t       timestamp                   ;
+            };
+
+            struct ButtonTrack {
+                bool           stableLevel                 ;
+                bool           candidateLevel              ;
+                uint32_t       candidateSince              ;
+                uint32_t       pressedAt                   ;
+                bool           isLongPressSent             ;
+            } buttons[BUTTON_COUNT];
+
+            volatile Edge edges[BUTTON_EDGE_QUEUE_SIZE];
+            volatile uint8_t edgeHead = 0U;
+            volatile uint8_t edgeTail = 0U;
+            volatile bool isEdgeOverflow = false;
+
+            ButtonEvent events[BUTTON_EVENT_QUEUE_SIZE];
+            uint8_t eventHead = 0U;
+            uint8_t eventTail = 0U;
+
+            uint32_t debounceMs;
+            uint32_t longPressMs;
+            bool isChordActive = false;
+
+            void settle(uint8_t button, uint32_t now);
+            void commit(uint8_t button);
+            void emit(ButtonEventType type, uint8_t button, uint32_t timestamp);
+
+        public:
+            ButtonMonitor(uint32_t debounceMs, uint32_t longPressMs);
+
+            void begin(bool panicLevel, bool cancelLevel);
+            void IRAM_ATTR pushEdge(uint8_t button, bool level, uint32_t timestamp);
+            void update(uint32_t now);
+            bool pollEvent(ButtonEvent &event);
+
+            bool isPressed(uint8_t button);
+            bool hadOverflow();
+    };
+
+#endif
@@ -33,6 +33,9 @@ void DisplayWrapper::begin() {
   
   disp->clearDisplay();
   disp->display();
+  memset(shadow, 0, sizeof(shadow));
+  lastText[0] = '\0';
+  isTextCurrent = true;
 
   yield();
 }
@@ -41,9 +44,12 @@ void DisplayWrapper::begin() {
  * Clears the display when called.
 */
 void DisplayWrapper::clear() {
+    if (remember("", false)) { // Already clear...
+
+        return;
+    }
     disp->clearDisplay();
-    disp->display();
-    yield();
+    requestFlush();
 }
 
 /**
@@ -55,9 +61,9 @@ void DisplayWrapper::clear() {
  * @param text The text to show on the screen as String.
 */
 void DisplayWrapper::print(String text) {
+    isTextCurrent = false;
     disp->print(text);
-    disp->display();
-    yield();
+    requestFlush();
 }
 
 /**
@@ -70,22 +76,44 @@ void DisplayWrapper::print(String text) {
  * @param text The text to show on the screen as String.
 */
 void DisplayWrapper::println(String text) {
+    isTextCurrent = false;
     disp->println(text);
-    disp->display();
-    yield();
+    requestFlush();
 }
 
 /**
- * Clears the display and then shows the given text.
+ * Clears the display and then shows the given text. If the text is
+ * already what is being shown then nothing is done, so this can be
+ * called repeatedly without redrawing the display each time.
  * 
  * @param text The text to show on the screen as String.
 */
 void DisplayWrapper::show(String text) {
+    if (remember(text.c_str(), false)) { // Already showing...
+
+        return;
+    }
     disp->clearDisplay();
     disp->setCursor(0, 0);
     disp->print(text);
-    disp->display();
-    yield();
+    requestFlush();
+}
+
+/**
+ * Clears the display and then shows the given text, which is kept in 
+ * flash. If the text is already what is being shown then nothing is done.
+ * 
+ * @param text The text to show on the screen as __FlashStringHelper.
+*/
+void DisplayWrapper::show(const __FlashStringHelper* text) {
+    if (remember((PGM_P)text, true)) { // Already showing...
+
+        return;
+    }
+    disp->clearDisplay();
+    disp->setCursor(0, 0);
+    disp->print(text);
+    requestFlush();
 }
 
 /**
@@ -110,7 +138,37 @@ void DisplayWrapper::ledFlash() {
   isLedFlashing = true;
 }
 
+/**
+ * Sets how many bytes of the frame buffer may be sent to the panel each
+ * time run is called. When set, showing something only draws it into the
+ * frame buffer and returns, and the panel is updated a chunk at a time
+ * from run, so no single call holds up the loop for a whole transfer.
+ * When 0, which is the default, the panel is updated before returning,
+ * which is what is needed before the scheduler is running.
+ * 
+ * @param bytesPerRun The most bytes to send per call of run as uint16_t.
+*/
+void DisplayWrapper::setFlushBudget(uint16_t bytesPerRun) {
+    flushBudget = bytesPerRun;
+}
+
+/**
+ * @return Returns true if the panel has yet to be fully updated as bool.
+*/
+bool DisplayWrapper::isFlushing() {
+
+    return isFlushPending;
+}
+
+/**
+ * Meant to be called often, this flashes the LED when flashing and sends
+ * the next chunk of any pending update to the panel.
+*/
 void DisplayWrapper::run() {
+  if (isFlushPending) {
+    flushChunk(flushBudget);
+  }
+
   static unsigned long lastSwitch = 0UL;
   if (isLedFlashing && millis() - lastSwitch >= 1000UL) {
     if (ledStatus == LOW) {
@@ -121,4 +179,147 @@ void DisplayWrapper::run() {
     digitalWrite(ledPin, ledStatus);
     lastSwitch = millis();
   }
-}
\ No newline at end of file
+}
+
+/*
+=================================================================
+Private Functions
+=================================================================
+*/
+
+/**
+ * #### PRIVATE ####
+ * Checks the given text against the text currently shown, and remembers
+ * it as the text now being shown. Text too long to remember is always
+ * treated as changed.
+ * 
+ * @param text The text to be shown as const char*.
+ * @param isProgmem True if the text is kept in flash as bool.
+ * 
+ * @return Returns true if the text is already being shown as bool.
+*/
+bool DisplayWrapper::remember(const char* text, bool isProgmem) {
+    if (
+        isTextCurrent 
+        && (isProgmem ? strcmp_P(lastText, text) : strcmp(lastText, text)) == 0
+    ) {
+
+        return true;
+    }
+
+    size_t length = (isProgmem ? strlen_P(text) : strlen(text));
+    isTextCurrent = (length < sizeof(lastText));
+    if (isTextCurrent) {
+        if (isProgmem) {
+            strcpy_P(lastText, text);
+        } else {
+            strcpy(lastText, text);
+        }
+    }
+
+    return false;
+}
+
+/**
+ * #### PRIVATE ####
+ * Starts sending the frame buffer to the panel, from the start, and 
+ * when there is no flush budget sends all of it right away.
+*/
+void DisplayWrapper::requestFlush() {
+    flushPage = 0;
+    flushColumn = 0;
+    isFlushPending = true;
+    if (flushBudget == 0U) {
+        flushChunk(sizeof(shadow));
+    }
+}
+
+/**
+ * #### PRIVATE ####
+ * Sends up to the given number of bytes of the parts of the frame buffer
+ * which differ from what the panel is showing. Each page of 8 pixel rows
+ * is compared against the shadow copy and only the span of columns from
+ * the first to the last changed byte is sent, so small changes don't cost
+ * a full 512 byte transfer. Where it got to is kept so the next call can
+ * carry on from there, and since sent bytes are copied to the shadow a 
+ * restart after the frame buffer changes again only sends what differs.
+ * 
+ * @param budget The most bytes to send as uint16_t.
+*/
+void DisplayWrapper::flushChunk(uint16_t budget) {
+    uint8_t* buffer = disp->getBuffer();
+    bool isSent = false;
+    while (budget > 0U && flushPage < SCREEN_PAGES) {
+        uint8_t* row = buffer + (flushPage * SCREEN_WIDTH);
+        uint8_t* shadowRow = shadow + (flushPage * SCREEN_WIDTH);
+
+        uint8_t first = flushColumn;
+        while (first < SCREEN_WIDTH && row[first] == shadowRow[first]) {
+            first ++;
+        }
+        if (first == SCREEN_WIDTH) { // Rest of page unchanged...
+            flushPage ++;
+            flushColumn = 0;
+            continue;
+        }
+        uint8_t last = SCREEN_WIDTH - 1;
+        while (row[last] == shadowRow[last]) {
+            last --;
+        }
+        if ((last - first) + 1 > budget) { // Send what the budget allows...
+            last = first + (budget - 1);
+        }
+
+        const uint8_t window[] = {
+            SSD1306_PAGEADDR, flushPage, flushPage, 
+            SSD1306_COLUMNADDR, first, last
+        };
+        uint16_t length = (last - first) + 1;
+        sendCommands(window, sizeof(window));
+        sendData(row + first, length);
+        memcpy(shadowRow + first, row + first, length);
+        budget -= length;
+        isSent = true;
+
+        flushColumn = last + 1;
+        if (flushColumn >= SCREEN_WIDTH) {
+            flushPage ++;
+            flushColumn = 0;
+        }
+    }
+
+    if (flushPage >= SCREEN_PAGES) { // Panel is up to date...
+        isFlushPending = false;
+    }
+    if (isSent) {
+        yield();
+    }
+}
+
+/**
+ * #### PRIVATE ####
+ * Sends the given commands to the panel in a single transmission.
+*/
+void DisplayWrapper::sendCommands(const uint8_t* commands, uint8_t count) {
+    Wire.beginTransmission(SCREEN_ADDRESS);
+    Wire.write((uint8_t)0x00); // Co = 0, D/C = 0
+    Wire.write(commands, count);
+    Wire.endTransmission();
+}
+
+/**
+ * #### PRIVATE ####
+ * Sends the given bytes to the panel's memory, split into transmissions
+ * which fit the I2C buffer.
+*/
+void DisplayWrapper::sendData(const uint8_t* data, uint16_t length) {
+    while (length > 0) {
+        uint16_t chunk = (length > SCREEN_I2C_CHUNK) ? SCREEN_I2C_CHUNK : length;
+        Wire.beginTransmission(SCREEN_ADDRESS);
+        Wire.write((uint8_t)0x40); // Co = 0, D/C = 1
+        Wire.write(data, chunk);
+        Wire.endTransmission();
+        data += chunk;
+        length -= chunk;
+    }
+}
@@ -2,8 +2,19 @@
     #define DisplayWrapper_h
 
     #include <Adafruit_SSD1306.h>
+    #include <Wire.h>
 
     #define SCREEN_ADDRESS 0x3C
+    #define SCREEN_WIDTH 128
+    #define SCREEN_HEIGHT 32
+    #define SCREEN_PAGES (SCREEN_HEIGHT / 8)
+    #define SCREEN_TEXT_SIZE 85 // 4 lines of 21 chars + 1 null
+
+    #if defined(BUFFER_LENGTH)
+        #define SCREEN_I2C_CHUNK (BUFFER_LENGTH - 1) // Leaves room for the control byte
+    #else
+        #define SCREEN_I2C_CHUNK 31
+    #endif
 
     class DisplayWrapper {
         private:
@@ -13,6 +24,21 @@
             unsigned int ledStatus = LOW;
             bool isLedFlashing = false;
 
+            uint8_t shadow[SCREEN_WIDTH * SCREEN_PAGES]; // What the panel currently shows
+            char lastText[SCREEN_TEXT_SIZE];
+            bool isTextCurrent = false;
+
+            uint16_t flushBudget = 0U;
+            bool isFlushPending = false;
+            uint8_t flushPage = 0;
+            uint8_t flushColumn = 0;
+
+            bool remember(const char* text, bool isProgmem);
+            void requestFlush();
+            void flushChunk(uint16_t budget);
+            void sendCommands(const uint8_t* commands, uint8_t count);
+            void sendData(const uint8_t* data, uint16_t length);
+
         public:
             DisplayWrapper(Adafruit_SSD1306* display, int ledPin);
 
@@ -21,10 +47,13 @@
             void println(String text);
             void clear();
             void show(String text);
+            void show(const __FlashStringHelper* text);
             void ledOn();
             void ledOff();
             void ledFlash();
 
+            void setFlushBudget(uint16_t bytesPerRun);
+            bool isFlushing();
             void run();
     };
 
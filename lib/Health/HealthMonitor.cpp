@@ -0,0 +1,115 @@
+/*
+ * HealthMonitor - Decides if the device can currently get alerts out by
+ * running three tiers of checks, each more expensive than the last.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include "HealthMonitor.h"
+
+/**
+ * #### CLASS CONSTRUCTOR ####
+ *
+ * @param linkProbe Cheap check of the WiFi link as HealthProbe.
+ * @param reachProbe Check that the SMTP server can be resolved and reached as HealthProbe.
+ * @param authProbe Full check that the SMTP server can be logged into as HealthProbe.
+ * @param clock The function used to get the current time in milliseconds as ClockFunction.
+*/
+HealthMonitor::HealthMonitor(HealthProbe linkProbe, HealthProbe reachProbe, HealthProbe authProbe, ClockFunction clock) {
+    this->linkProbe = linkProbe;
+    this->reachProbe = reachProbe;
+    this->authProbe = authProbe;
+    this->clock = clock;
+}
+
+/**
+ * Runs whichever checks are due. This is meant to be called often, such
+ * as once a second, as it does nothing when no check is due.
+ *
+ * A failed link check makes the device unhealthy without trying the other
+ * checks since they can't succeed. A failed reachability check forces an
+ * early full check to confirm it, and while unhealthy the full check is
+ * retried regularly so recovery is noticed quickly. Each successful full
+ * check doubles the time until the next one, up to a maximum, and any
+ * failure brings it back to the minimum.
+*/
+void HealthMonitor::run() {
+    uint32_t now = (uint32_t)clock();
+    bool isFirst = isFirstRun;
+    isFirstRun = false;
+
+    if (isFirst || isElapsed(now, lastLink, HEALTH_LINK_INTERVAL_MS)) {
+        isLinkOk = linkProbe();
+        lastLink = now;
+        if (!isLinkOk) { // Full check must confirm once link is back...
+            isAuthOk = false;
+            authInterval = HEALTH_AUTH_MIN_INTERVAL_MS;
+
+            return;
+        }
+    } else if (!isLinkOk) { // Waiting for link to come back...
+
+        return;
+    }
+
+    bool isForced = false;
+    if (isFirst || !isReachOk || isElapsed(now, lastReach, HEALTH_REACH_INTERVAL_MS)) {
+        if (isFirst || isElapsed(now, lastReach, HEALTH_LINK_INTERVAL_MS)) {
+            isReachOk = reachProbe();
+            lastReach = now;
+        }
+        isForced = !isReachOk;
+    }
+    isForced = isForced || !isAuthOk;
+
+    if (
+        isFirst
+        || isElapsed(now, lastAuth, authInterval)
+        || (isForced && isElapsed(now, lastAuth, HEALTH_AUTH_RETRY_MS))
+    ) {
+        isAuthOk = authProbe();
+        lastAuth = (uint32_t)clock();
+        if (isAuthOk) {
+            authInterval = ((authInterval * 2UL) > HEALTH_AUTH_MAX_INTERVAL_MS) ? HEALTH_AUTH_MAX_INTERVAL_MS : (authInterval * 2UL);
+        } else {
+            authInterval = HEALTH_AUTH_MIN_INTERVAL_MS;
+        }
+    }
+}
+
+/**
+ * The device is considered healthy when the WiFi link is up and the last
+ * full check succeeded. A failing reachability check alone doesn't make
+ * the device unhealthy, it only brings the next full check forward.
+ *
+ * @return Returns true if healthy otherwise false as bool.
+*/
+bool HealthMonitor::isHealthy() {
+
+    return (isLinkOk && isAuthOk);
+}
+
+/**
+ * @return Returns the current time between full checks in millis as uint32_t.
+*/
+uint32_t HealthMonitor::getAuthInterval() {
+
+    return authInterval;
+}
+
+/*
+=================================================================
+Private Functions
+=================================================================
+*/
+
+/**
+ * #### PRIVATE ####
+ * Wraparound safe check of whether the interval has passed since the
+ * given time.
+*/
+bool HealthMonitor::isElapsed(uint32_t now, uint32_t since, uint32_t interval) {
+
+    return ((now - since) >= interval);
+}
@@ -0,0 +1,59 @@
+/*
+ * HealthMonitor - Decides if the device can currently get alerts out by
+ * running three tiers of checks, each more expensive than the last. The
+ * WiFi link is checked often, reachability of the SMTP server by DNS and
+ * TCP is checked less often, and a full authenticated check is only done
+ * on a long interval which grows while things stay healthy, or right away
+ * when one of the cheaper checks fails or recovers.
+ *
+ * The checks themselves are given as probe functions so the class has no
+ * dependency on the network stack. They are called from run() and block
+ * it for as long as they take, so a reachability probe which times out
+ * stalls the caller every HEALTH_LINK_INTERVAL_MS while the host is down.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef HealthMonitor_h
+    #define HealthMonitor_h
+
+    #include <stdint.h>
+    #include <Scheduler.h>
+
+    #define HEALTH_LINK_INTERVAL_MS 5000UL
+    #define HEALTH_REACH_INTERVAL_MS 60000UL
+    #define HEALTH_AUTH_MIN_INTERVAL_MS 120000UL
+    #define HEALTH_AUTH_MAX_INTERVAL_MS 480000UL
+    #define HEALTH_AUTH_RETRY_MS 30000UL // Least time between forced auth checks
+
+    typedef bool (*HealthProbe)();
+
+    class HealthMonitor {
+        private:
+            HealthProbe linkProbe;
+            HealthProbe reachProbe;
+            HealthProbe authProbe;
+            ClockFunction clock;
+
+            uint32_t lastLink = 0UL;
+            uint32_t lastReach = 0UL;
+            uint32_t lastAuth = 0UL;
+            uint32_t authInterval = HEALTH_AUTH_MIN_INTERVAL_MS;
+            bool isFirstRun = true;
+
+            bool isLinkOk = true;
+            bool isReachOk = true;
+            bool isAuthOk = true;
+
+            static bool isElapsed(uint32_t now, uint32_t since, uint32_t interval);
+
+        public:
+            HealthMonitor(HealthProbe linkProbe, HealthProbe reachProbe, HealthProbe authProbe, ClockFunction clock);
+
+            void run();
+            bool isHealthy();
+            uint32_t getAuthInterval();
+    };
+
+#endif
@@ -0,0 +1,410 @@
+/*
+ * FlashJournal - An append-only log of records kept in a small region of
+ * flash sectors, only erasing a sector once it fills.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include "FlashJournal.h"
+
+/**
+ * #### CLASS CONSTRUCTOR ####
+ * At least two sectors should be given so that the previous sector stays
+ * intact while compacting into the next one.
+ *
+ * @param firstSector The number of the first flash sector of the region as uint32_t.
+ * @param sectorCount The number of sectors in the region as uint8_t.
+*/
+FlashJournal::FlashJournal(uint32_t firstSector, uint8_t sectorCount) {
+    this->firstSector = firstSector;
+    this->sectorCount = sectorCount;
+}
+
+/**
+ * Finds the newest valid sector of the region and the end of the records
+ * in it. If a damaged record is found the log ends at it and the sector
+ * is considered full, so the next append fails and the caller compacts.
+ *
+ * @return Returns true if a valid sector was found otherwise false as bool.
+*/
+bool FlashJournal::mount() {
+    isMountTried = true;
+    activeSector = JOURNAL_NO_SECTOR;
+    for (uint8_t i = 0; i < sectorCount; i ++) {
+        JournalSectorHeader header;
+        if (
+            readSectorHeader(i, header)
+            && (activeSector == JOURNAL_NO_SECTOR || (int32_t)(header.generation - generation) > 0)
+        ) {
+            activeSector = i;
+            generation = header.generation;
+        }
+    }
+    if (activeSector == JOURNAL_NO_SECTOR) { // Nothing journaled...
+
+        return false;
+    }
+
+    uint16_t offset = sizeof(JournalSectorHeader);
+    writeOffset = JOURNAL_SECTOR_SIZE; // Full unless a clean end is found
+    while (offset + sizeof(JournalRecordHeader) <= JOURNAL_SECTOR_SIZE) {
+        JournalRecordHeader header;
+        read(addressOf(activeSector, offset), &header, sizeof(header));
+        if (header.type == 0xFF && header.reserved == 0xFF && header.length == 0xFFFF && header.crc == 0xFFFFFFFFUL) { // Erased, end of log...
+            writeOffset = offset;
+            break;
+        }
+        if (!isRecordValid(offset, header)) { // Partly written, log ends here...
+            Serial.println(F("Journal has a damaged record, it will be compacted on next write."));
+            break;
+        }
+        offset += recordSize(header.length);
+    }
+    endOffset = offset;
+
+    return true;
+}
+
+/**
+ * @return Returns true if there is an active sector as bool.
+*/
+bool FlashJournal::isMounted() {
+
+    return (activeSector != JOURNAL_NO_SECTOR);
+}
+
+/**
+ * Moves to the next record of the active sector, oldest first.
+ *
+ * @param record The current record, with an offset of 0 to get the first
+ * record, which is updated to the next record as JournalRecord.
+ *
+ * @return Returns true if there was a next record as bool.
+*/
+bool FlashJournal::nextRecord(JournalRecord &record) {
+    if (activeSector == JOURNAL_NO_SECTOR) {
+
+        return false;
+    }
+
+    uint16_t offset = (record.offset == 0U) ? sizeof(JournalSectorHeader) : (record.offset + recordSize(record.length));
+    if (offset >= endOffset) { // No more records...
+
+        return false;
+    }
+
+    JournalRecordHeader header;
+    if (!read(addressOf(activeSector, offset), &header, sizeof(header))) {
+
+        return false;
+    }
+    record.offset = offset;
+    record.type = header.type;
+    record.length = header.length;
+
+    return true;
+}
+
+/**
+ * Reads part of a record's payload.
+ *
+ * @param record The record to read from as JournalRecord.
+ * @param offset Where to start reading within the payload as uint16_t.
+ * @param dest Where to put what was read as void*.
+ * @param length The number of bytes to read as uint16_t.
+ *
+ * @return Returns true if read otherwise false as bool.
+*/
+bool FlashJournal::readRecord(const JournalRecord &record, uint16_t offset, void* dest, uint16_t length) {
+    if (activeSector == JOURNAL_NO_SECTOR || ((uint32_t)offset + length) > record.length) {
+
+        return false;
+    }
+
+    return read(addressOf(activeSector, record.offset + sizeof(JournalRecordHeader) + offset), dest, length);
+}
+
+/**
+ * Appends a record to the active sector.
+ *
+ * @param type The type of the record, anything but 0xFF, as uint8_t.
+ * @param payload The payload of the record as const void*.
+ * @param length The size of the payload as uint16_t.
+ *
+ * @return Returns true if appended, or false if there was no room or
+ * nothing is journaled yet, in which case compact should be used, as bool.
+*/
+bool FlashJournal::append(uint8_t type, const void* payload, uint16_t length) {
+
+    return append(type, payload, length, nullptr, 0U);
+}
+
+/**
+ * Appends a record whose payload is made of two parts, such as a header
+ * and a struct, without first copying them together.
+ *
+ * @return Returns true if appended, or false if there was no room or
+ * nothing is journaled yet, in which case compact should be used, as bool.
+*/
+bool FlashJournal::append(uint8_t type, const void* head, uint16_t headLength, const void* body, uint16_t bodyLength) {
+    if (!isMountTried) {
+        mount();
+    }
+    uint32_t length = (uint32_t)headLength + bodyLength;
+    if (
+        activeSector == JOURNAL_NO_SECTOR
+        || length > 0xFFFEUL
+        || ((uint32_t)writeOffset + recordSize(length)) > JOURNAL_SECTOR_SIZE
+    ) {
+
+        return false;
+    }
+
+    if (!writeRecord(writeOffset, type, head, headLength, body, bodyLength)) { // Rest of sector can't be trusted...
+        writeOffset = JOURNAL_SECTOR_SIZE;
+
+        return false;
+    }
+    writeOffset += recordSize(length);
+    endOffset = writeOffset;
+
+    return true;
+}
+
+/**
+ * Starts a new sector holding only the given record, which should be a
+ * snapshot of everything the journal needs to hold. The new sector only
+ * replaces the current one once it is completely written.
+ *
+ * @return Returns true if compacted otherwise false as bool.
+*/
+bool FlashJournal::compact(uint8_t type, const void* head, uint16_t headLength, const void* body, uint16_t bodyLength) {
+    if (!isMountTried) {
+        mount();
+    }
+    uint32_t length = (uint32_t)headLength + bodyLength;
+    if (length > 0xFFFEUL || (sizeof(JournalSectorHeader) + recordSize(length)) > JOURNAL_SECTOR_SIZE) {
+
+        return false;
+    }
+
+    int8_t previousSector = activeSector;
+    activeSector = (previousSector == JOURNAL_NO_SECTOR) ? 0 : ((previousSector + 1) % sectorCount);
+    bool ok = ESP.flashEraseSector(firstSector + activeSector);
+    eraseCount ++;
+    ok = ok && writeRecord(sizeof(JournalSectorHeader), type, head, headLength, body, bodyLength);
+    if (ok) { // Sector header goes last so the sector only counts once complete...
+        JournalSectorHeader header = {JOURNAL_MAGIC, JOURNAL_VERSION, 0xFFFF, (uint32_t)(generation + 1UL), 0UL};
+        header.crc = sectorHeaderCrc(header);
+        ok = ESP.flashWrite(addressOf(activeSector, 0U), (uint32_t*)&header, sizeof(header));
+    }
+    if (!ok) {
+        Serial.println(F("Journal compaction failed!"));
+        activeSector = previousSector;
+
+        return false;
+    }
+
+    generation ++;
+    writeOffset = sizeof(JournalSectorHeader) + recordSize(length);
+    endOffset = writeOffset;
+
+    return true;
+}
+
+/**
+ * @return Returns the bytes left in the active sector as uint16_t.
+*/
+uint16_t FlashJournal::getFreeSpace() {
+
+    return ((activeSector == JOURNAL_NO_SECTOR) ? 0U : (JOURNAL_SECTOR_SIZE - writeOffset));
+}
+
+/**
+ * @return Returns the number of sectors erased since startup as unsigned long.
+*/
+unsigned long FlashJournal::getEraseCount() {
+
+    return eraseCount;
+}
+
+/*
+=================================================================
+Private Functions
+=================================================================
+*/
+
+/**
+ * #### PRIVATE ####
+ * Writes a record into the active sector at the given offset. The record
+ * header is written first so that a record cut short by a power loss
+ * fails its CRC check instead of looking like erased flash. Flash can only
+ * be written in whole aligned words, so the payload is streamed through a
+ * small aligned buffer and padded out with 0xFF which leaves flash as is.
+ *
+ * @return Returns true if written otherwise false as bool.
+*/
+bool FlashJournal::writeRecord(uint16_t offset, uint8_t type, const void* head, uint16_t headLength, const void* body, uint16_t bodyLength) {
+    JournalRecordHeader header = {type, 0xFF, (uint16_t)(headLength + bodyLength), 0UL};
+    uint32_t crc = 0xFFFFFFFFUL;
+    crc = CrcUtils::crc32Update(crc, &header.type, sizeof(header.type));
+    crc = CrcUtils::crc32Update(crc, &header.length, sizeof(header.length));
+    crc = CrcUtils::crc32Update(crc, head, headLength);
+    crc = CrcUtils::crc32Update(crc, body, bodyLength);
+    header.crc = ~crc;
+
+    uint32_t address = addressOf(activeSector, offset);
+    if (!ESP.flashWrite(address, (uint32_t*)&header, sizeof(header))) {
+
+        return false;
+    }
+    address += sizeof(header);
+
+    uint32_t buffer[8];
+    uint8_t* bytes = (uint8_t*)buffer;
+    uint16_t fill = 0U;
+    const uint8_t* parts[2] = {(const uint8_t*)head, (const uint8_t*)body};
+    uint16_t lengths[2] = {headLength, bodyLength};
+    for (uint8_t p = 0; p < 2; p ++) {
+        uint16_t done = 0U;
+        while (done < lengths[p]) {
+            uint16_t chunk = sizeof(buffer) - fill;
+            if (chunk > (lengths[p] - done)) {
+                chunk = lengths[p] - done;
+            }
+            memcpy(bytes + fill, parts[p] + done, chunk);
+            fill += chunk;
+            done += chunk;
+            if (fill == sizeof(buffer)) {
+                if (!ESP.flashWrite(address, buffer, sizeof(buffer))) {
+
+                    return false;
+                }
+                address += sizeof(buffer);
+                fill = 0U;
+            }
+        }
+    }
+    if (fill > 0U) {
+        uint16_t padded = (fill + 3U) & ~3U;
+        memset(bytes + fill, 0xFF, padded - fill);
+        if (!ESP.flashWrite(address, buffer, padded)) {
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * #### PRIVATE ####
+ * Checks that a record fits in the sector and that its CRC matches.
+ *
+ * @return Returns true if valid as bool.
+*/
+bool FlashJournal::isRecordValid(uint16_t offset, JournalRecordHeader &header) {
+    if (header.length == 0xFFFF || ((uint32_t)offset + recordSize(header.length)) > JOURNAL_SECTOR_SIZE) {
+
+        return false;
+    }
+
+    uint32_t crc = 0xFFFFFFFFUL;
+    crc = CrcUtils::crc32Update(crc, &header.type, sizeof(header.type));
+    crc = CrcUtils::crc32Update(crc, &header.length, sizeof(header.length));
+
+    uint32_t buffer[8];
+    uint32_t address = addressOf(activeSector, offset + sizeof(JournalRecordHeader));
+    uint16_t remaining = header.length;
+    while (remaining > 0U) {
+        uint16_t chunk = (remaining > sizeof(buffer)) ? sizeof(buffer) : remaining;
+        if (!read(address, buffer, chunk)) {
+
+            return false;
+        }
+        crc = CrcUtils::crc32Update(crc, buffer, chunk);
+        address += chunk;
+        remaining -= chunk;
+    }
+
+    return ((~crc) == header.crc);
+}
+
+/**
+ * #### PRIVATE ####
+ * Reads the header of the given sector of the region.
+ *
+ * @return Returns true if the header is valid as bool.
+*/
+bool FlashJournal::readSectorHeader(uint8_t sector, JournalSectorHeader &header) {
+    if (!read(addressOf(sector, 0U), &header, sizeof(header))) {
+
+        return false;
+    }
+
+    return (
+        header.magic == JOURNAL_MAGIC
+        && header.version == JOURNAL_VERSION
+        && header.crc == sectorHeaderCrc(header)
+    );
+}
+
+/**
+ * #### PRIVATE ####
+ * @return Returns the flash address of the offset within the given sector
+ * of the region as uint32_t.
+*/
+uint32_t FlashJournal::addressOf(uint8_t sector, uint16_t offset) {
+
+    return (((firstSector + sector) * JOURNAL_SECTOR_SIZE) + offset);
+}
+
+/**
+ * #### PRIVATE ####
+ * Reads from flash into any destination, as flash can only be read in
+ * whole aligned words.
+ *
+ * @return Returns true if read otherwise false as bool.
+*/
+bool FlashJournal::read(uint32_t address, void* dest, uint16_t length) {
+    uint32_t buffer[8];
+    uint8_t* out = (uint8_t*)dest;
+    while (length > 0U) {
+        uint32_t aligned = address & ~3UL;
+        uint16_t skip = address - aligned;
+        uint16_t chunk = sizeof(buffer) - skip;
+        if (chunk > length) {
+            chunk = length;
+        }
+        if (!ESP.flashRead(aligned, buffer, (skip + chunk + 3U) & ~3U)) {
+
+            return false;
+        }
+        memcpy(out, ((uint8_t*)buffer) + skip, chunk);
+        out += chunk;
+        address += chunk;
+        length -= chunk;
+    }
+
+    return true;
+}
+
+/**
+ * #### PRIVATE ####
+ * @return Returns the space taken by a record with the given payload
+ * length, including its header and padding, as uint32_t.
+*/
+uint32_t FlashJournal::recordSize(uint32_t length) {
+
+    return (sizeof(JournalRecordHeader) + ((length + 3U) & ~3U));
+}
+
+/**
+ * #### PRIVATE ####
+ * @return Returns the CRC of the fields of a sector header as uint32_t.
+*/
+uint32_t FlashJournal::sectorHeaderCrc(const JournalSectorHeader &header) {
+
+    return ~CrcUtils::crc32Update(0xFFFFFFFFUL, &header, offsetof(JournalSectorHeader, crc));
+}
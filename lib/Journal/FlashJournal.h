@@ -0,0 +1,90 @@
+/*
+ * FlashJournal - An append-only log of records kept in a small region of
+ * flash sectors. Changes are stored by appending a record after the last
+ * one instead of erasing and rewriting everything, so a sector is only
+ * erased once it fills. When the active sector is full the caller starts
+ * a new one by compacting, which writes a single snapshot record into the
+ * next sector of the region. The old sector stays intact until the new one
+ * is complete, so losing power at any point leaves one usable sector.
+ *
+ * Each record is checked with a CRC32. A record which was only partly
+ * written when power was lost ends the log, and the next append compacts.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef FlashJournal_h
+    #define FlashJournal_h
+
+    #include <Arduino.h>
+    #include <CrcUtils.h>
+
+    #define JOURNAL_MAGIC 0x4C4E524AUL // "JRNL"
+    #define JOURNAL_VERSION 1
+    #define JOURNAL_SECTOR_SIZE 4096U
+    #define JOURNAL_NO_SECTOR -1
+
+    struct JournalSectorHeader {
+        uint32_t       magic                       ;
+        uint16_t       version                     ;
+        uint16_t       reserved                    ;
+        uint32_t       generation                  ; // Newest sector wins
+        uint32_t       crc                         ; // Of the fields above
+    };
+
+    struct JournalRecordHeader {
+        uint8_t        type                        ; // 0xFF is never a type, it's erased flash
+        uint8_t        reserved                    ;
+        uint16_t       length                      ; // Payload bytes, without padding
+        uint32_t       crc                         ; // Of type, length and payload
+    };
+
+    // *****************************************************************************
+    // Position of a record in the active sector, used to walk through the records.
+    // Start with offset 0 to get the first record.
+    // *****************************************************************************
+    struct JournalRecord {
+        uint16_t       offset                      ;
+        uint8_t        type                        ;
+        uint16_t       length                      ;
+    };
+
+    class FlashJournal {
+        private:
+            uint32_t firstSector;
+            uint8_t sectorCount;
+
+            int8_t activeSector = JOURNAL_NO_SECTOR;
+            uint32_t generation = 0UL;
+            uint16_t endOffset = 0U; // End of the valid records
+            uint16_t writeOffset = 0U; // Where the next record goes
+            bool isMountTried = false;
+            unsigned long eraseCount = 0UL;
+
+            bool writeRecord(uint16_t offset, uint8_t type, const void* head, uint16_t headLength, const void* body, uint16_t bodyLength);
+            bool isRecordValid(uint16_t offset, JournalRecordHeader &header);
+            bool readSectorHeader(uint8_t sector, JournalSectorHeader &header);
+            uint32_t addressOf(uint8_t sector, uint16_t offset);
+            bool read(uint32_t address, void* dest, uint16_t length);
+
+            static uint32_t recordSize(uint32_t length);
+            static uint32_t sectorHeaderCrc(const JournalSectorHeader &header);
+
+        public:
+            FlashJournal(uint32_t firstSector, uint8_t sectorCount);
+
+            bool mount();
+            bool isMounted();
+            bool nextRecord(JournalRecord &record);
+            bool readRecord(const JournalRecord &record, uint16_t offset, void* dest, uint16_t length);
+
+            bool append(uint8_t type, const void* payload, uint16_t length);
+            bool append(uint8_t type, const void* head, uint16_t headLength, const void* body, uint16_t bodyLength);
+            bool compact(uint8_t type, const void* head, uint16_t headLength, const void* body, uint16_t bodyLength);
+
+            uint16_t getFreeSpace();
+            unsigned long getEraseCount();
+    };
+
+#endif
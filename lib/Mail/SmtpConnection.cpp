@@ -0,0 +1,187 @@
+/*
+ * SmtpConnection - Keeps an authenticated SMTP session open so that alerts
+ * can be sent without first doing the DNS lookup, TCP connect, TLS handshake
+ * and login. An idle session is kept from being timed out by the server with
+ * a NOOP on a fixed interval, shorter than the 5 minutes servers commonly
+ * allow, apart from the health check whose interval grows while healthy.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include "SmtpConnection.h"
+
+int SmtpConnection::lastResponseCode = 0;
+
+/**
+ * #### CLASS CONSTRUCTOR ####
+ *
+ * @param config The config used to connect, which must outlive this
+ * object, as Session_Config pointer.
+*/
+SmtpConnection::SmtpConnection(Session_Config* config) {
+    this->config = config;
+}
+
+/**
+ * Makes sure there is an authenticated session ready for sending. An open
+ * session is reused as is, unless it has been idle long enough that the
+ * server may have dropped it, in which case it is first checked with a
+ * NOOP. Only when there is no usable session is a new one connected.
+ *
+ * @return Returns true if a session is ready otherwise false as bool.
+*/
+bool SmtpConnection::ensureConnected() {
+    if (session.connected() && session.isAuthenticated()) { // Have an open session...
+        if (millis() - lastActivity < SMTP_IDLE_VERIFY_MS || keepAlive()) {
+            reuseCount ++;
+
+            return true;
+        }
+    }
+
+    return connect();
+}
+
+/**
+ * Checks the health of the connection to the SMTP server. If a session
+ * is open a NOOP is sent over it which also keeps it from being timed
+ * out by the server, otherwise a new session is connected.
+ *
+ * @return Returns true if the server could be reached and logged into,
+ * otherwise false as bool.
+*/
+bool SmtpConnection::keepAlive() {
+    if (session.connected()) {
+        lastResponseCode = 0;
+        session.sendCustomCommand(F("NOOP"), onResponse);
+        if (lastResponseCode == 250) { // Session is still good...
+            markActive();
+
+            return true;
+        }
+
+        Serial.println(F("SMTP session went stale, reconnecting..."));
+        session.closeSession();
+    }
+
+    return connect();
+}
+
+/**
+ * Keeps an open session from being timed out by the server by sending a
+ * NOOP once it has been idle for SMTP_KEEP_ALIVE_MS. This is meant to be
+ * called often, as it does nothing while the session is in use or closed.
+ * It never connects, a session which went stale is closed so the next
+ * health check or send connects a new one.
+ *
+ * @return Returns true if a session is still open otherwise false as bool.
+*/
+bool SmtpConnection::keepWarm() {
+    if (!session.connected()) {
+
+        return false;
+    }
+    if (millis() - lastActivity < SMTP_KEEP_ALIVE_MS) { // Used recently...
+
+        return true;
+    }
+
+    lastResponseCode = 0;
+    session.sendCustomCommand(F("NOOP"), onResponse);
+    if (lastResponseCode == 250) {
+        markActive();
+
+        return true;
+    }
+
+    Serial.println(F("SMTP session went stale while idle, closing it."));
+    session.closeSession();
+
+    return false;
+}
+
+/**
+ * Closes the session if it is open.
+*/
+void SmtpConnection::close() {
+    if (session.connected()) {
+        session.closeSession();
+    }
+}
+
+/**
+ * Records that the session was just used, such as after sending a message.
+*/
+void SmtpConnection::markActive() {
+    lastActivity = millis();
+}
+
+/**
+ * @return Returns the underlying session for use with MailClient as
+ * SMTPSession pointer.
+*/
+SMTPSession* SmtpConnection::getSession() {
+
+    return &session;
+}
+
+/**
+ * @return Returns how long the last full connect took in millis as
+ * unsigned long.
+*/
+unsigned long SmtpConnection::getLastConnectDuration() {
+
+    return lastConnectDuration;
+}
+
+/**
+ * @return Returns the number of full connects done as unsigned long.
+*/
+unsigned long SmtpConnection::getConnectCount() {
+
+    return connectCount;
+}
+
+/**
+ * @return Returns the number of times an open session was reused as
+ * unsigned long.
+*/
+unsigned long SmtpConnection::getReuseCount() {
+
+    return reuseCount;
+}
+
+/*
+=================================================================
+Private Functions
+=================================================================
+*/
+
+/**
+ * #### PRIVATE ####
+ * Does a full connect and login to the SMTP server.
+ *
+ * @return Returns true if connected and logged in as bool.
+*/
+bool SmtpConnection::connect() {
+    unsigned long start = millis();
+    session.connect(config);
+    lastConnectDuration = millis() - start;
+    connectCount ++;
+
+    bool ok = (session.connected() && session.isAuthenticated());
+    if (ok) {
+        markActive();
+    }
+
+    return ok;
+}
+
+/**
+ * #### PRIVATE ####
+ * Receives the server's response to a custom command.
+*/
+void SmtpConnection::onResponse(SMTP_Response response) {
+    lastResponseCode = response.code;
+}
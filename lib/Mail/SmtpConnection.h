@@ -0,0 +1,51 @@
+/*
+ * SmtpConnection - Keeps an authenticated SMTP session open so that alerts
+ * can be sent without first doing the DNS lookup, TCP connect, TLS handshake
+ * and login. An idle session is kept from being timed out by the server with
+ * a NOOP on a fixed interval, shorter than the 5 minutes servers commonly
+ * allow, apart from the health check whose interval grows while healthy.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef SmtpConnection_h
+    #define SmtpConnection_h
+
+    #include <Arduino.h>
+    #include <ESP_Mail_Client.h>
+
+    #define SMTP_IDLE_VERIFY_MS 150000UL // Verify with NOOP before reuse if idle longer
+    #define SMTP_KEEP_ALIVE_MS 120000UL // NOOP when idle this long, must be below SMTP_IDLE_VERIFY_MS
+
+    class SmtpConnection {
+        private:
+            SMTPSession session;
+            Session_Config* config;
+
+            unsigned long lastActivity = 0UL;
+            unsigned long lastConnectDuration = 0UL;
+            unsigned long connectCount = 0UL;
+            unsigned long reuseCount = 0UL;
+
+            static int lastResponseCode;
+            static void onResponse(SMTP_Response response);
+
+            bool connect();
+
+        public:
+            SmtpConnection(Session_Config* config);
+
+            bool ensureConnected();
+            bool keepAlive();
+            bool keepWarm();
+            void close();
+            void markActive();
+
+            SMTPSession* getSession();
+            unsigned long getLastConnectDuration();
+            unsigned long getConnectCount();
+            unsigned long getReuseCount();
+    };
+
+#endif
@@ -0,0 +1,253 @@
+/*
+ * Scheduler - A small cooperative task scheduler. Tasks are registered as
+ * either periodic or one-shot and are run from the main loop once their
+ * deadline has been reached. No task is ever preempted, so a task must do
+ * a small amount of work and then return rather than delay() or spin.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include "Scheduler.h"
+
+/**
+ * #### CLASS CONSTRUCTOR ####
+ *
+ * @param clock The function used to get the current time in
+ * milliseconds, normally millis(), as ClockFunction.
+*/
+Scheduler::Scheduler(ClockFunction clock) {
+    this->clock = clock;
+    for (int i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        tasks[i] = {nullptr, 0UL, 0UL, false, false, 0U};
+    }
+}
+
+/**
+ * Registers a task which is to be run repeatedly, once every interval.
+ * An interval of zero causes the task to run on every tick of the
+ * scheduler. The first run happens on the next tick.
+ *
+ * @param interval The time between runs in milliseconds as unsigned long.
+ * @param callback The function to run as TaskCallback.
+ *
+ * @return Returns the ID of the task or SCHEDULER_NO_TASK if there was no
+ * room for the task, as int.
+*/
+int Scheduler::every(unsigned long interval, TaskCallback callback) {
+
+    return addTask(callback, 0UL, interval, true);
+}
+
+/**
+ * Registers a task which is to be run a single time once the given delay
+ * has passed. After it has run its slot is released for reuse, but its
+ * task ID is not, so a stale ID never refers to a later task.
+ *
+ * @param delayMs The time to wait before running in milliseconds as unsigned long.
+ * @param callback The function to run as TaskCallback.
+ *
+ * @return Returns the ID of the task or SCHEDULER_NO_TASK if there was no
+ * room for the task, as int.
+*/
+int Scheduler::after(unsigned long delayMs, TaskCallback callback) {
+
+    return addTask(callback, delayMs, 0UL, false);
+}
+
+/**
+ * Moves the deadline of an active task to be the given delay from now.
+ *
+ * @param taskId The ID of the task to reschedule as int.
+ * @param delayMs The new delay in milliseconds as unsigned long.
+*/
+void Scheduler::reschedule(int taskId, unsigned long delayMs) {
+    int slot = slotOf(taskId);
+    if (slot != SCHEDULER_NO_TASK) {
+        tasks[slot].deadline = now() + delayMs;
+    }
+}
+
+/**
+ * Cancels the given task so that it will no longer be run.
+ *
+ * @param taskId The ID of the task to cancel as int.
+*/
+void Scheduler::cancel(int taskId) {
+    int slot = slotOf(taskId);
+    if (slot != SCHEDULER_NO_TASK) {
+        tasks[slot].isActive = false;
+    }
+}
+
+/**
+ * Used to determine if the given task is still waiting to be run.
+ *
+ * @param taskId The ID of the task as int.
+ *
+ * @return Returns true if the task is active otherwise false as bool.
+*/
+bool Scheduler::isScheduled(int taskId) {
+
+    return (slotOf(taskId) != SCHEDULER_NO_TASK);
+}
+
+/**
+ * This is the scheduler's tick and is meant to be called from the main
+ * loop. Every task whose deadline has been reached is run once, in the
+ * order the tasks were registered. Periodic tasks are then set to run
+ * again one interval after their prior deadline, unless they have fallen
+ * more than an interval behind in which case they are resynchronized
+ * to now so they don't run back to back trying to catch up.
+*/
+void Scheduler::run() {
+    uint32_t start = now();
+    for (int i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        Task &task = tasks[i];
+        if (task.isActive && isDue(now(), task.deadline)) { // Task needs run...
+            if (task.isPeriodic) { // Set next deadline before running...
+                task.deadline += task.interval;
+                if (isDue(now(), task.deadline)) { // Fell behind...
+                    task.deadline = now() + task.interval;
+                }
+            } else { // One-shot is done once run...
+                task.isActive = false;
+            }
+
+            task.callback();
+        }
+    }
+
+    lastTickDuration = now() - start;
+    if (lastTickDuration > maxTickDuration) {
+        maxTickDuration = lastTickDuration;
+    }
+}
+
+/**
+ * Used to determine how long it will be until the next task is due, so
+ * the caller can idle until then.
+ *
+ * @return Returns the number of milliseconds until the next task is due,
+ * zero if one is due now, as unsigned long.
+*/
+unsigned long Scheduler::timeUntilNext() {
+    uint32_t current = now();
+    uint32_t soonest = 0xFFFFFFFFUL;
+    for (int i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        if (tasks[i].isActive) {
+            if (isDue(current, tasks[i].deadline)) {
+
+                return 0UL;
+            }
+            uint32_t remaining = tasks[i].deadline - current;
+            if (remaining < soonest) {
+                soonest = remaining;
+            }
+        }
+    }
+
+    return soonest;
+}
+
+/**
+ * @return Returns the longest a single tick has taken in milliseconds
+ * since last reset, as unsigned long.
+*/
+unsigned long Scheduler::getMaxTickDuration() {
+
+    return maxTickDuration;
+}
+
+/**
+ * Resets the tracking of the longest tick.
+*/
+void Scheduler::resetMaxTickDuration() {
+    maxTickDuration = 0UL;
+}
+
+/*
+=================================================================
+Private Functions
+=================================================================
+*/
+
+/**
+ * #### PRIVATE ####
+ * Reads the clock as the 32 bit millisecond counter used on the device, so
+ * that wraparound behaves the same no matter the width of unsigned long.
+ *
+ * @return Returns the current time in milliseconds as uint32_t.
+*/
+uint32_t Scheduler::now() {
+
+    return (uint32_t)clock();
+}
+
+/**
+ * #### PRIVATE ####
+ * Places a task into the first free slot of the task table.
+ *
+ * @return Returns the ID of the task or SCHEDULER_NO_TASK, as int.
+*/
+int Scheduler::addTask(TaskCallback callback, unsigned long delayMs, unsigned long interval, bool isPeriodic) {
+    if (callback == nullptr) {
+
+        return SCHEDULER_NO_TASK;
+    }
+
+    for (int i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        if (!tasks[i].isActive) { // Found a free slot...
+            uint16_t generation = (uint16_t)((tasks[i].generation + 1U) & 0x7FFFU); // Keeps IDs positive
+            tasks[i] = {callback, (uint32_t)interval, (uint32_t)(now() + delayMs), true, isPeriodic, generation};
+
+            return ((int)generation << SCHEDULER_SLOT_BITS) | i;
+        }
+    }
+
+    return SCHEDULER_NO_TASK;
+}
+
+/**
+ * #### PRIVATE ####
+ * Finds the slot of the given task, as long as the task is still active.
+ * An ID kept after its task finished doesn't match the slot's generation
+ * once the slot has been reused, so it is treated as not scheduled.
+ *
+ * @param taskId The ID of the task as int.
+ *
+ * @return Returns the slot of the task or SCHEDULER_NO_TASK, as int.
+*/
+int Scheduler::slotOf(int taskId) {
+    if (taskId < 0) {
+
+        return SCHEDULER_NO_TASK;
+    }
+    int slot = taskId & ((1 << SCHEDULER_SLOT_BITS) - 1);
+    if (
+        slot >= SCHEDULER_MAX_TASKS
+        || !tasks[slot].isActive
+        || tasks[slot].generation != (uint16_t)(taskId >> SCHEDULER_SLOT_BITS)
+    ) {
+
+        return SCHEDULER_NO_TASK;
+    }
+
+    return slot;
+}
+
+/**
+ * #### PRIVATE ####
+ * Determines if the given deadline has been reached. The comparison is
+ * done on the signed difference of the two times so that it remains
+ * correct when the millisecond counter wraps around every ~49 days.
+ *
+ * @param now The current time as uint32_t.
+ * @param deadline The deadline to check as uint32_t.
+ *
+ * @return Returns true if the deadline has been reached as bool.
+*/
+bool Scheduler::isDue(uint32_t now, uint32_t deadline) {
+
+    return ((int32_t)(now - deadline) >= 0);
+}
@@ -0,0 +1,63 @@
+/*
+ * Scheduler - A small cooperative task scheduler. Tasks are registered as
+ * either periodic or one-shot and are run from the main loop once their
+ * deadline has been reached. No task is ever preempted, so a task must do
+ * a small amount of work and then return rather than delay() or spin.
+ *
+ * The scheduler only needs a millisecond clock, which is given to it
+ * during construction, so it has no direct dependency on the Arduino core
+ * and can be driven by a fake clock when built for the host.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef Scheduler_h
+    #define Scheduler_h
+
+    #include <stdint.h>
+
+    #define SCHEDULER_MAX_TASKS 16
+    #define SCHEDULER_NO_TASK -1
+    #define SCHEDULER_SLOT_BITS 8 // Low bits of a task ID are its slot, the rest its generation
+
+    typedef void (*TaskCallback)();
+    typedef unsigned long (*ClockFunction)();
+
+    class Scheduler {
+        private:
+            struct Task {
+                TaskCallback   callback                    ;
+                uint32_t       interval                    ; // 0 for one-shot tasks
+                uint32_t       deadline                    ;
+                bool           isActive                    ;
+                bool           isPeriodic                  ;
+                uint16_t       generation                  ; // Bumped each time the slot is reused
+            } tasks[SCHEDULER_MAX_TASKS];
+
+            ClockFunction clock;
+            uint32_t lastTickDuration = 0UL;
+            uint32_t maxTickDuration = 0UL;
+
+            uint32_t now();
+            int addTask(TaskCallback callback, unsigned long delayMs, unsigned long interval, bool isPeriodic);
+            int slotOf(int taskId);
+            static bool isDue(uint32_t now, uint32_t deadline);
+
+        public:
+            Scheduler(ClockFunction clock);
+
+            int every(unsigned long interval, TaskCallback callback);
+            int after(unsigned long delayMs, TaskCallback callback);
+            void reschedule(int taskId, unsigned long delayMs);
+            void cancel(int taskId);
+            bool isScheduled(int taskId);
+
+            void run();
+
+            unsigned long timeUntilNext();
+            unsigned long getMaxTickDuration();
+            void resetMaxTickDuration();
+    };
+
+#endif
@@ -12,12 +12,65 @@
 
 #include "Settings.h"
 
+#ifndef SETTINGS_EEPROM_OFFSET // Native tests give the layout of their fake flash instead
+    extern "C" uint32_t _EEPROM_start;
+    extern "C" uint32_t _FS_end;
+
+    #define SETTINGS_FLASH_BASE 0x40200000UL // Where flash is mapped, the linker symbols are in this space
+    #define SETTINGS_EEPROM_OFFSET (((uint32_t)&_EEPROM_start) - SETTINGS_FLASH_BASE)
+    #define SETTINGS_FS_END_OFFSET (((uint32_t)&_FS_end) - SETTINGS_FLASH_BASE)
+#endif
+
+// The journal ends with the EEPROM sector and takes the sectors just ahead of it...
+#define SETTINGS_JOURNAL_FIRST_SECTOR ((SETTINGS_EEPROM_OFFSET / JOURNAL_SECTOR_SIZE) - (SETTINGS_JOURNAL_SECTORS - 1))
+
+static const char FACTORY_SET_ME[] PROGMEM = "SET_ME";
+static const char FACTORY_MESSAGE[] PROGMEM = "Please send help ASAP!";
+static const char FACTORY_FROM_EMAIL[] PROGMEM = "no-reply@panic-button.com";
+static const char FACTORY_FROM_NAME[] PROGMEM = "FriendlyNeighbor PanicButton";
+static const char FACTORY_RECIPIENTS[] PROGMEM = "test@email.com";
+static const char FACTORY_SENTINEL[] PROGMEM = "NA";
+
+SETTING_STRINGS(ssid, "ssid", "SSID must not be longer than 32 characters!", "SSID is required for configuration!")
+SETTING_STRINGS(pwd, "pwd", "Pwd must not be longer than 63 characters!", "Pwd is required for configuration!")
+SETTING_STRINGS(owner, "owner", "Owner must be no longer than 100 characters in length!", "Owner is required for configuration!")
+SETTING_STRINGS(message, "message", "Message must be no longer than 100 characters in length!", "Message is required for configuration!")
+SETTING_STRINGS(smtpHost, "smtp_host", "SMTP Host must not be longer than 120 characters!", "SMTP Host is required for configuration!")
+SETTING_STRINGS(smtpPort, "smtp_port", "SMTP Port must be within valid port range!", "SMTP Port is required for configuration!")
+SETTING_STRINGS(smtpUser, "smtp_user", "SMTP User must be no longer than 120 characters in length!", "SMTP User is required for configuration!")
+SETTING_STRINGS(smtpPwd, "smtp_pwd", "SMTP Password must be no longer than 120 characters in length!", "SMTP Password is required for configuration!")
+SETTING_STRINGS(fromEmail, "from_email", "The 'From Email' must be no longer than 120 characters in length!", "The 'From Email' is required for configuration!")
+SETTING_STRINGS(fromName, "from_name", "The 'From Name' must be no longer than 50 characters in length!", "The 'From Name' is required for configuration!")
+SETTING_STRINGS(recipients, "recipients", "Recipients must be up to " SETTINGS_TO_TEXT(SETTINGS_MAX_RECIPIENTS) " valid emails split by ';' (509 chars max)!", "Recipients are required for configuration!")
+SETTING_STRINGS(panicLevel, "panic_level", "Panic Level must be greater than 0 and less than 6!", "Panic Level is required for configuration!")
+
+const SettingField SETTING_FIELDS[] PROGMEM = {
+    SETTING_TEXT(ssid, SETTING_HASHED | SETTING_EXPORTED | SETTING_NOT_FACTORY, FACTORY_SET_ME),
+    SETTING_TEXT(pwd, SETTING_HASHED | SETTING_EXPORTED | SETTING_NOT_FACTORY, FACTORY_SET_ME),
+    SETTING_TEXT(owner, SETTING_HASHED | SETTING_EXPORTED | SETTING_NOT_FACTORY, FACTORY_SET_ME),
+    SETTING_TEXT(message, SETTING_HASHED | SETTING_EXPORTED, FACTORY_MESSAGE),
+    SETTING_TEXT(smtpHost, SETTING_HASHED | SETTING_EXPORTED | SETTING_NOT_FACTORY, FACTORY_SET_ME),
+    SETTING_NUMBER(smtpPort, SETTING_TYPE_UINT, SETTING_HASHED | SETTING_EXPORTED, 1L, 65535L, 465L),
+    SETTING_TEXT(smtpUser, SETTING_HASHED | SETTING_EXPORTED | SETTING_NOT_FACTORY, FACTORY_SET_ME),
+    SETTING_TEXT(smtpPwd, SETTING_HASHED | SETTING_EXPORTED | SETTING_NOT_FACTORY, FACTORY_SET_ME),
+    SETTING_TEXT(fromEmail, SETTING_HASHED | SETTING_EXPORTED, FACTORY_FROM_EMAIL),
+    SETTING_TEXT(fromName, SETTING_HASHED | SETTING_EXPORTED, FACTORY_FROM_NAME),
+    SETTING_TEXT(recipients, SETTING_HASHED | SETTING_EXPORTED | SETTING_NOT_FACTORY, FACTORY_RECIPIENTS),
+    SETTING_INTERNAL(inPanicMode, SETTING_TYPE_BOOL, SETTING_HASHED, 0L, nullptr),
+    SETTING_NUMBER(panicLevel, SETTING_TYPE_INT, SETTING_HASHED | SETTING_EXPORTED, 1L, 5L, 5L),
+    SETTING_INTERNAL(sentinel, SETTING_TYPE_TEXT, 0, 0L, FACTORY_SENTINEL)
+};
+const uint8_t SETTING_FIELD_COUNT = sizeof(SETTING_FIELDS) / sizeof(SETTING_FIELDS[0]);
+
 /**
  * #### CLASS CONSTRUCTOR ####
  * Allows for external instantiation of
  * the class into an object.
 */
-Settings::Settings() {
+Settings::Settings() : journal(SETTINGS_JOURNAL_FIRST_SECTOR, SETTINGS_JOURNAL_SECTORS) {
+    // The journal sectors are only free when the filesystem ends before them, not on every layout...
+    isJournalUsable = ((SETTINGS_JOURNAL_FIRST_SECTOR * JOURNAL_SECTOR_SIZE) >= SETTINGS_FS_END_OFFSET);
+
     // Initially default the settings...
     defaultSettings();
 }
@@ -39,71 +92,144 @@ bool Settings::factoryDefault() {
 
 /**
  * Used to load the settings from flash memory.
- * After the settings are loaded from flash memory the sentinel value is 
- * checked to ensure the integrity of the loaded data. If the sentinel 
- * value is wrong then the contents of the memory are deemed invalid and
- * the memory is wiped and then a factory default is instead performed.
+ * The settings are kept in a journal where the whole settings are stored
+ * as a snapshot record, followed by small records for later changes such 
+ * as the panic state. Loading replays the records in order so the latest
+ * of each wins. If the journal holds no valid snapshot then the contents 
+ * of the memory are deemed invalid and a factory default is instead 
+ * performed. If nothing is journaled yet then settings stored by older 
+ * firmware are looked for and migrated into the journal. On flash layouts
+ * where the filesystem leaves no room for the journal, the settings are
+ * kept through EEPROM alone.
  * 
- * @return Returns true if data was loaded from memory and the sentinel 
- * value was valid.
+ * @return Returns true if data was loaded from memory and was valid.
 */
 bool Settings::loadSettings() {
     bool ok = false;
-    // Setup EEPROM for loading and saving...
-    EEPROM.begin(sizeof(NonVolatileSettings));
 
-    // Persist default settings or load settings...
-    delay(15);
-
-    /* Load from EEPROM if applicable... */
-    if (EEPROM.percentUsed() >= 0) { // Something is stored from prior...
-        Serial.println(F("\nLoading settings from EEPROM..."));
-        EEPROM.get(0, nvSettings);
-        if (strcmp(nvSettings.sentinel, hashNvSettings(nvSettings).c_str()) != 0) { // Memory is corrupt...
-            EEPROM.wipe();
+    /* Load from journal if applicable... */
+    if (!isJournalUsable) { // Flash layout leaves no room for the journal...
+        Serial.println(F("\nNo room for settings journal in flash layout, using EEPROM only."));
+        ok = loadEepromSettings();
+    } else if (journal.mount()) { // Something is stored from prior...
+        Serial.println(F("\nLoading settings from flash..."));
+        ok = replayJournal();
+        if (!ok) { // Memory is corrupt...
             factoryDefault();
             Serial.println("Stored settings footprint invalid, stored settings have been wiped and defaulted!");
         } else { // Memory seems ok...
-            Serial.print(F("Percent of ESP Flash currently used is: "));
-            Serial.print(EEPROM.percentUsed());
-            Serial.println(F("%"));
-            ok = true;
+            Serial.print(F("Bytes of settings journal free: "));
+            Serial.println(journal.getFreeSpace());
         }
+    } else { // Nothing journaled, check for older format...
+        ok = loadEepromSettings();
     }
-    
-    EEPROM.end();
+    indexRecipients();
 
     return ok;
 }
 
 /**
  * Used to save or persist the current value of the non-volatile settings
- * into flash memory.
+ * into flash memory. They are appended to the journal as a snapshot, and
+ * only when the journal is full is it compacted, which is the only time a 
+ * flash sector gets erased.
  *
  * @return Returns a true if save was successful otherwise a false as bool.
 */
 bool Settings::saveSettings() {
-    strcpy(nvSettings.sentinel, hashNvSettings(nvSettings).c_str()); // Ensure accurate Sentinel Value.
-    EEPROM.begin(sizeof(NonVolatileSettings));
+    if (!isJournalUsable) {
 
-    EEPROM.wipe(); // usage seemd to grow without this.
-    EEPROM.put(0, nvSettings);
-    
-    bool ok = EEPROM.commit();
+        return saveEepromSettings();
+    }
+
+    SettingsHeader header = headerOf(nvSettings);
+    bool ok = journal.append(SETTINGS_RECORD_FULL, &header, sizeof(header), &nvSettings, sizeof(nvSettings));
+    if (!ok) {
+        ok = compactSettings();
+    }
+    if (ok) {
+        dirtyMask = 0U;
+    }
 
-    EEPROM.end();
-    
     return ok;
 }
 
+/**
+ * Used to persist just the panic state, being whether or not in panic 
+ * mode and the panic level. This is a small record appended to the 
+ * journal so it is much quicker than saving all the settings.
+ *
+ * @return Returns a true if save was successful otherwise a false as bool.
+*/
+bool Settings::savePanicState() {
+    if (!isJournalUsable) {
+
+        return saveEepromSettings();
+    }
+
+    PanicRecord panic = {(int32_t)nvSettings.panicLevel, (uint8_t)(nvSettings.inPanicMode ? 1U : 0U), {0xFF, 0xFF, 0xFF}};
+    bool ok = journal.append(SETTINGS_RECORD_PANIC, &panic, sizeof(panic));
+    if (!ok) {
+        ok = compactSettings(); // Snapshot holds the panic state too
+    }
+    if (ok) {
+        dirtyMask &= ~SETTINGS_DIRTY_PANIC;
+    }
+
+    return ok;
+}
+
+/**
+ * Used to find out if any settings have been changed through their setters
+ * since they were last persisted.
+ * 
+ * @return Returns true if there are changes not yet persisted as bool.
+*/
+bool Settings::isDirty() {
+
+    return (dirtyMask != 0U);
+}
+
+/**
+ * Persists whatever settings have been changed since they were last
+ * persisted. This allows settings to be written apart from the work which
+ * changed them, such as the panic state being persisted by the dispatcher
+ * task rather than the button handler. If only the panic state changed then just the
+ * small panic record is written, otherwise the whole settings are saved.
+ * 
+ * @return Returns true if nothing needed persisting or if it was persisted
+ * successfully as bool.
+*/
+bool Settings::flush() {
+    if (dirtyMask & SETTINGS_DIRTY_ALL) {
+
+        return saveSettings();
+    }
+    if (dirtyMask & SETTINGS_DIRTY_PANIC) {
+
+        return savePanicState();
+    }
+
+    return true;
+}
+
 /**
  * Used to determine if the current network settings are in default values.
  * 
  * @return Returns a true if default values otherwise a false as bool. 
 */
 bool Settings::isFactoryDefault() {
-    
-    return (strcmp(hashNvSettings(nvSettings).c_str(), hashNvSettings(factorySettings).c_str()) == 0);
+    SettingField field;
+    for (uint8_t i = 0; i < SETTING_FIELD_COUNT; i ++) {
+        readField(i, field);
+        if ((field.flags & SETTING_HASHED) && !isFactory(field.offset)) {
+
+            return false;
+        }
+    }
+
+    return true;
 }
 
 /**
@@ -113,7 +239,7 @@ bool Settings::isFactoryDefault() {
  * @return Returns true if the settings have been changed from default, otherwise returns false as bool.
 */
 bool Settings::isNetworkSet() {
-    if (String(nvSettings.ssid).equals(String(factorySettings.ssid)) || String(nvSettings.pwd).equals(String(factorySettings.pwd))) {
+    if (isSsidFactory() || isPwdFactory()) {
         
         return false;
     }
@@ -121,10 +247,165 @@ bool Settings::isNetworkSet() {
     return true;
 }
 
+/**
+ * Reads the descriptor of a field out of the PROGMEM table.
+ * 
+ * @param index The index of the field in SETTING_FIELDS as uint8_t.
+ * @param field Where the descriptor goes as SettingField.
+*/
+void Settings::readField(uint8_t index, SettingField &field) {
+    memcpy_P(&field, &SETTING_FIELDS[index], sizeof(SettingField));
+}
+
+/**
+ * @return Returns the value of a number field of the given settings as long.
+*/
+long Settings::readNumber(const NonVolatileSettings &nvSet, const SettingField &field) {
+    const uint8_t* value = ((const uint8_t*)&nvSet) + field.offset;
+    if (field.type == SETTING_TYPE_UINT) {
+
+        return (long)*((const unsigned int*)value);
+    }
+    if (field.type == SETTING_TYPE_INT) {
+
+        return (long)*((const int*)value);
+    }
+    if (field.type == SETTING_TYPE_BOOL) {
+
+        return (*((const bool*)value) ? 1L : 0L);
+    }
+
+    return 0L;
+}
+
+/**
+ * Stores a number into a number field of the given settings.
+*/
+void Settings::writeNumber(NonVolatileSettings &nvSet, const SettingField &field, long number) {
+    uint8_t* value = ((uint8_t*)&nvSet) + field.offset;
+    if (field.type == SETTING_TYPE_UINT) {
+        *((unsigned int*)value) = (unsigned int)number;
+    } else if (field.type == SETTING_TYPE_INT) {
+        *((int*)value) = (int)number;
+    } else if (field.type == SETTING_TYPE_BOOL) {
+        *((bool*)value) = (number != 0L);
+    }
+}
+
+/**
+ * @return Returns the characters of a text field of the given settings as char*.
+*/
+char* Settings::textOf(NonVolatileSettings &nvSet, const SettingField &field) {
+
+    return (((char*)&nvSet) + field.offset);
+}
+
+/**
+ * @return Returns the characters of a text field of the given settings as const char*.
+*/
+const char* Settings::textOf(const NonVolatileSettings &nvSet, const SettingField &field) {
+
+    return (((const char*)&nvSet) + field.offset);
+}
 
-NonVolatileSettings Settings::getFactorySettings() {
+/**
+ * @return Returns a view of the current value of a text field as SettingView.
+*/
+SettingView Settings::viewField(const SettingField &field) {
+
+    return viewOf(textOf(nvSettings, field), field.size);
+}
+
+/**
+ * @return Returns the current value of a number field as long.
+*/
+long Settings::getFieldNumber(const SettingField &field) {
+
+    return readNumber(nvSettings, field);
+}
+
+/**
+ * Copies the fields having any of the given flags from the staged settings,
+ * such as the validated fields of an update.
+ * 
+ * @param staged The settings to copy from as NonVolatileSettings.
+ * @param flags The flags of the fields to copy as uint8_t.
+*/
+void Settings::applyFields(const NonVolatileSettings &staged, uint8_t flags) {
+    SettingField field;
+    for (uint8_t i = 0; i < SETTING_FIELD_COUNT; i ++) {
+        readField(i, field);
+        if (field.flags & flags) {
+            memcpy(((uint8_t*)&nvSettings) + field.offset, ((const uint8_t*)&staged) + field.offset, field.size);
+            dirtyMask |= SETTINGS_DIRTY_ALL;
+        }
+    }
+    indexRecipients();
+}
+
+/**
+ * Writes the settings out as pretty printed JSON, straight from the 
+ * settings table, so no JsonDocument or String is built up for it.
+ * 
+ * @param out Where the JSON is written as Print.
+*/
+void Settings::writeJson(Print &out) {
+    SettingField field;
+    bool isFirst = true;
+    out.print('{');
+    for (uint8_t i = 0; i < SETTING_FIELD_COUNT; i ++) {
+        readField(i, field);
+        if (!(field.flags & SETTING_EXPORTED)) {
+            continue;
+        }
+
+        out.print(isFirst ? F("\n  \"") : F(",\n  \""));
+        out.print(FPSTR(field.key));
+        out.print(F("\": "));
+        if (field.type == SETTING_TYPE_TEXT) {
+            SettingView view = viewField(field);
+            writeJsonText(out, view.chars, view.length);
+        } else {
+            out.print(getFieldNumber(field));
+        }
+        isFirst = false;
+    }
+    out.print(F("\n}"));
+}
+
+/**
+ * Validates and tidies up a ';' separated list of recipients in place, as
+ * is done to an update before it is applied. Each address is trimmed and
+ * empty entries are dropped, so what is stored is just the addresses with
+ * a single ';' between them. Every address must look like an email address
+ * and there can be no more than SETTINGS_MAX_RECIPIENTS of them, so a bad
+ * address is caught here rather than when an alert is being sent.
+ * 
+ * @param recipients The null terminated list to tidy up as char*.
+ * 
+ * @return Returns true if the list is valid otherwise false as bool.
+*/
+bool Settings::normalizeRecipients(char* recipients) {
+    char* write = recipients;
+    uint8_t count = 0U;
+    TokenIterator tokens(recipients, strlen(recipients), ';');
+    TextSlice token;
+    while (tokens.next(token)) { // Written part never passes the part being read...
+        if (count == SETTINGS_MAX_RECIPIENTS || !ParseUtils::validEmailAddress(token.chars, token.length)) {
+
+            return false;
+        }
+        if (count > 0U) {
+            *write = ';';
+            write ++;
+        }
+        memmove(write, token.chars, token.length);
+        write += token.length;
+        count ++;
+    }
+    *write = '\0';
 
-    return factorySettings;
+    return (count > 0U);
 }
 
 /*
@@ -142,12 +423,13 @@ String Settings::getSsid() { // <-----------------------------------------------
 void Settings::setSsid(const char *ssid) { // <----------------------------------- setSsid
     if (sizeof(ssid) <= sizeof(nvSettings.ssid)) {
         strcpy(nvSettings.ssid, ssid);
+        dirtyMask |= SETTINGS_DIRTY_ALL;
     }
 }
 
 bool Settings::isSsidFactory() { // <--------------------------------------------- isSsidFactory
 
-    return String(nvSettings.ssid).equals(String(factorySettings.ssid));
+    return isFactory(offsetof(NonVolatileSettings, ssid));
 }
 
 
@@ -159,12 +441,13 @@ String Settings::getPwd() { // <------------------------------------------------
 void Settings::setPwd(const char *pwd) { // <------------------------------------- setPwd
     if (sizeof(pwd) <= sizeof(nvSettings.pwd)) {
         strcpy(nvSettings.pwd, pwd);
+        dirtyMask |= SETTINGS_DIRTY_ALL;
     }
 }
 
 bool Settings::isPwdFactory() { // <---------------------------------------------- isPwdFactory
 
-    return String(nvSettings.pwd).equals(String(factorySettings.pwd));
+    return isFactory(offsetof(NonVolatileSettings, pwd));
 }
 
 
@@ -176,12 +459,13 @@ String Settings::getOwner() { // <----------------------------------------------
 void Settings::setOwner(const char* owner) { // <--------------------------------- setOwner 
     if (sizeof(owner) <= sizeof(nvSettings.owner)) {
         strcpy(nvSettings.owner, owner);
+        dirtyMask |= SETTINGS_DIRTY_ALL;
     }
 }
 
 bool Settings::isOwnerFactory() { // <------------------------------------------- isOwnerFactory
 
-    return String(nvSettings.owner).equals(String(factorySettings.owner));
+    return isFactory(offsetof(NonVolatileSettings, owner));
 }
 
 
@@ -193,12 +477,13 @@ String Settings::getMessage() { // <--------------------------------------------
 void Settings::setMessage(const char* message) { // <----------------------------- setMessage
     if (sizeof(message) <= sizeof(nvSettings.message)) {
         strcpy(nvSettings.message, message);
+        dirtyMask |= SETTINGS_DIRTY_ALL;
     }
 }
 
 bool Settings::isMessageFactory() { // <------------------------------------------ isMessageFactory
 
-    return String(nvSettings.message).equals(String(factorySettings.message));
+    return isFactory(offsetof(NonVolatileSettings, message));
 }
 
 
@@ -210,12 +495,13 @@ String Settings::getSmtpHost() { // <-------------------------------------------
 void Settings::setSmtpHost(const char* host) { // <------------------------------- setSmtpHost
     if (sizeof(host) <= sizeof(nvSettings.smtpHost)) {
         strcpy(nvSettings.smtpHost, host);
+        dirtyMask |= SETTINGS_DIRTY_ALL;
     }
 }
 
 bool Settings::isSmtpHostFactory() { // <---------------------------------------- isSmtpHostFactory
 
-    return String(nvSettings.smtpHost).equals(String(factorySettings.smtpHost));
+    return isFactory(offsetof(NonVolatileSettings, smtpHost));
 }
 
 
@@ -226,11 +512,12 @@ unsigned int Settings::getSmtpPort() { // <-------------------------------------
 
 void Settings::setSmtpPort(unsigned int port) { // <------------------------------ setSmtpPort
     nvSettings.smtpPort = port;
+    dirtyMask |= SETTINGS_DIRTY_ALL;
 }
 
 bool Settings::isSmtpPortFactory() { // <----------------------------------------- isSmtpPortFactory
 
-    return (nvSettings.smtpPort == factorySettings.smtpPort);
+    return isFactory(offsetof(NonVolatileSettings, smtpPort));
 }
 
 
@@ -242,12 +529,13 @@ String Settings::getSmtpUser() { // <-------------------------------------------
 void Settings::setSmtpUser(const char* user) { // <------------------------------- setSmtpUser
     if (sizeof(user) <= sizeof(nvSettings.smtpUser)) {
         strcpy(nvSettings.smtpUser, user);
+        dirtyMask |= SETTINGS_DIRTY_ALL;
     }
 }
 
 bool Settings::isSmtpUserFactory() { // <----------------------------------------- isSmtpUserFactory
 
-    return String(nvSettings.smtpUser).equals(String(factorySettings.smtpUser));
+    return isFactory(offsetof(NonVolatileSettings, smtpUser));
 }
 
 
@@ -259,12 +547,13 @@ String Settings::getSmtpPwd() { // <--------------------------------------------
 void Settings::setSmtpPwd(const char* pwd) { // <--------------------------------- setSmtpPwd
     if (sizeof(pwd) <= sizeof(nvSettings.smtpPwd)) {
         strcpy(nvSettings.smtpPwd, pwd);
+        dirtyMask |= SETTINGS_DIRTY_ALL;
     }
 }
 
 bool Settings::isSmtpPwdFactory() { // <------------------------------------------ isSmtpPwdFactory
 
-    return String(nvSettings.smtpPwd).equals(String(factorySettings.smtpPwd));
+    return isFactory(offsetof(NonVolatileSettings, smtpPwd));
 }
 
 
@@ -276,12 +565,13 @@ String Settings::getFromEmail() { // <------------------------------------------
 void Settings::setFromEmail(const char* email) { // <----------------------------- setFromEmail
     if (sizeof(email) <= sizeof(nvSettings.fromEmail)) {
         strcpy(nvSettings.fromEmail, email);
+        dirtyMask |= SETTINGS_DIRTY_ALL;
     }
 }
 
 bool Settings::isFromEmailFactory() { // <---------------------------------------- isFromEmailFactory
 
-    return String(nvSettings.fromEmail).equals(String(factorySettings.fromEmail));
+    return isFactory(offsetof(NonVolatileSettings, fromEmail));
 }
 
 
@@ -293,12 +583,13 @@ String Settings::getFromName() { // <-------------------------------------------
 void Settings::setFromName(const char* name) { // <------------------------------- setFromName
     if (sizeof(name) <= sizeof(nvSettings.fromName)) {
         strcpy(nvSettings.fromName, name);
+        dirtyMask |= SETTINGS_DIRTY_ALL;
     }
 }
 
 bool Settings::isFromNameFactory() { // <----------------------------------------- isFromNameFactory
 
-    return String(nvSettings.fromName).equals(String(factorySettings.fromName));
+    return isFactory(offsetof(NonVolatileSettings, fromName));
 }
 
 
@@ -310,12 +601,14 @@ String Settings::getRecipients() { // <-----------------------------------------
 void Settings::setRecipients(const char* recips) { // <--------------------------- setRecipients
     if (sizeof(recips) <= sizeof(nvSettings.recipients)) {
         strcpy(nvSettings.recipients, recips);
+        dirtyMask |= SETTINGS_DIRTY_ALL;
+        indexRecipients();
     }
 }
 
 bool Settings::isRecipientsFactory() { // <--------------------------------------- isRecipientsFactory
 
-    return String(nvSettings.recipients).equals(String(factorySettings.recipients));
+    return isFactory(offsetof(NonVolatileSettings, recipients));
 }
 
 
@@ -326,6 +619,7 @@ bool Settings::getInPanicMode() { // <------------------------------------------
 
 void Settings::setInPanicMode(bool inPanic) { // <-------------------------------- setInPanicMode
     nvSettings.inPanicMode = inPanic;
+    dirtyMask |= SETTINGS_DIRTY_PANIC;
 }
 
 
@@ -336,11 +630,12 @@ int Settings::getPanicLevel() { // <--------------------------------------------
 
 void Settings::setPanicLevel(int level) { // <------------------------------------ setPanicLevel
     nvSettings.panicLevel = level;
+    dirtyMask |= SETTINGS_DIRTY_PANIC;
 }
 
 bool Settings::isPanicLevelFactory() { // <--------------------------------------- isPanicLevelFactory
 
-    return (nvSettings.panicLevel == factorySettings.panicLevel);
+    return isFactory(offsetof(NonVolatileSettings, panicLevel));
 }
 
 
@@ -394,12 +689,124 @@ String Settings::getAdminPwd() {
     return String(constSettings.adminPwd);
 }
 
+/*
+=================================================================
+Allocation Free View Functions
+=================================================================
+*/
+
+SettingView Settings::viewSsid() { // <------------------------------------------ viewSsid
+
+    return viewOf(nvSettings.ssid, sizeof(nvSettings.ssid));
+}
+
+SettingView Settings::viewPwd() { // <------------------------------------------- viewPwd
+
+    return viewOf(nvSettings.pwd, sizeof(nvSettings.pwd));
+}
+
+SettingView Settings::viewOwner() { // <----------------------------------------- viewOwner
+
+    return viewOf(nvSettings.owner, sizeof(nvSettings.owner));
+}
+
+SettingView Settings::viewMessage() { // <--------------------------------------- viewMessage
+
+    return viewOf(nvSettings.message, sizeof(nvSettings.message));
+}
+
+SettingView Settings::viewSmtpHost() { // <-------------------------------------- viewSmtpHost
+
+    return viewOf(nvSettings.smtpHost, sizeof(nvSettings.smtpHost));
+}
+
+SettingView Settings::viewSmtpUser() { // <-------------------------------------- viewSmtpUser
+
+    return viewOf(nvSettings.smtpUser, sizeof(nvSettings.smtpUser));
+}
+
+SettingView Settings::viewSmtpPwd() { // <--------------------------------------- viewSmtpPwd
+
+    return viewOf(nvSettings.smtpPwd, sizeof(nvSettings.smtpPwd));
+}
+
+SettingView Settings::viewFromEmail() { // <------------------------------------- viewFromEmail
+
+    return viewOf(nvSettings.fromEmail, sizeof(nvSettings.fromEmail));
+}
+
+SettingView Settings::viewFromName() { // <-------------------------------------- viewFromName
+
+    return viewOf(nvSettings.fromName, sizeof(nvSettings.fromName));
+}
+
+SettingView Settings::viewRecipients() { // <------------------------------------ viewRecipients
+
+    return viewOf(nvSettings.recipients, sizeof(nvSettings.recipients));
+}
+
+uint8_t Settings::getRecipientCount() { // <------------------------------------- getRecipientCount
+
+    return vSettings.recipientCount;
+}
+
+TextSlice Settings::viewRecipient(uint8_t index) { // <-------------------------- viewRecipient
+    if (index >= vSettings.recipientCount) {
+
+        return {nvSettings.recipients, 0U};
+    }
+
+    return {nvSettings.recipients + vSettings.recipients[index].offset, vSettings.recipients[index].length};
+}
+
 /*
 =================================================================
 Private Functions
 =================================================================
 */
 
+/**
+ * #### PRIVATE ####
+ * Builds a view of the given stored text setting. The length is found
+ * without reading past the field's capacity.
+ * 
+ * @param field The stored characters as const char*.
+ * @param capacity The size of the field as unsigned int.
+ * 
+ * @return Returns the view as SettingView.
+*/
+SettingView Settings::viewOf(const char* field, unsigned int capacity) {
+
+    return {field, (unsigned int)strnlen(field, capacity)};
+}
+
+/**
+ * #### PRIVATE ####
+ * Finds where each address is within the stored recipients so they can be
+ * walked through without parsing the list again. Updates have already been
+ * tidied up by normalizeRecipients, but settings stored before that was 
+ * done may not be, so addresses which don't look valid are left out and
+ * reported, as are any past SETTINGS_MAX_RECIPIENTS.
+*/
+void Settings::indexRecipients() {
+    vSettings.recipientCount = 0U;
+    SettingView list = viewRecipients();
+    TokenIterator tokens(list.chars, list.length, ';');
+    TextSlice token;
+    while (tokens.next(token)) {
+        if (!ParseUtils::validEmailAddress(token.chars, token.length)) { // Stored before updates were checked...
+            Serial.printf("Stored recipient '%.*s' is not a valid email address and will not be sent alerts!\n", (int)token.length, token.chars);
+        } else if (vSettings.recipientCount >= SETTINGS_MAX_RECIPIENTS) {
+            Serial.printf("Stored recipient '%.*s' is past the first " SETTINGS_TO_TEXT(SETTINGS_MAX_RECIPIENTS) " and will not be sent alerts!\n", (int)token.length, token.chars);
+        } else {
+            RecipientEntry &entry = vSettings.recipients[vSettings.recipientCount];
+            entry.offset = (uint16_t)(token.chars - list.chars);
+            entry.length = (uint16_t)token.length;
+            vSettings.recipientCount ++;
+        }
+    }
+}
+
 /**
  * #### PRIVATE ####
  * This function is used to set or reset all settings to 
@@ -408,52 +815,335 @@ Private Functions
 */
 void Settings::defaultSettings() {
     // Default the settings..
-    strcpy(nvSettings.ssid, factorySettings.ssid);
-    strcpy(nvSettings.pwd, factorySettings.pwd);
-    strcpy(nvSettings.owner, factorySettings.owner);
-    strcpy(nvSettings.message, factorySettings.message);
-    strcpy(nvSettings.smtpHost, factorySettings.smtpHost);
-    nvSettings.smtpPort = factorySettings.smtpPort;
-    strcpy(nvSettings.smtpUser, factorySettings.smtpUser);
-    strcpy(nvSettings.smtpPwd, factorySettings.smtpPwd);
-    strcpy(nvSettings.fromEmail, factorySettings.fromEmail);
-    strcpy(nvSettings.fromName, factorySettings.fromName);
-    nvSettings.inPanicMode = factorySettings.inPanicMode;
-    nvSettings.panicLevel = factorySettings.panicLevel;
-    strcpy(nvSettings.recipients, factorySettings.recipients);
-    strcpy(nvSettings.sentinel, hashNvSettings(factorySettings).c_str());
-
-    // Note: Volatile settings would be setup here if needed.
-}
-
-/**
- * #### PRIVATE FUNCTION ####
- * Used to provide a hash of the given NonVolatileSettings.
+    SettingField field;
+    for (uint8_t i = 0; i < SETTING_FIELD_COUNT; i ++) {
+        readField(i, field);
+        defaultField(field);
+    }
+
+    // Volatile settings follow from the non-volatile ones...
+    indexRecipients();
+}
+
+/**
+ * #### PRIVATE ####
+ * Sets a single field of the settings to its factory value.
+ * 
+ * @param field The field as SettingField.
+*/
+void Settings::defaultField(const SettingField &field) {
+    if (field.type == SETTING_TYPE_TEXT) {
+        strncpy_P(textOf(nvSettings, field), field.factoryText, field.size);
+    } else {
+        writeNumber(nvSettings, field, field.factoryNumber);
+    }
+}
+
+/**
+ * #### PRIVATE ####
+ * Finds the field at the given offset of the settings.
+ * 
+ * @param offset The offset of the field within NonVolatileSettings as uint16_t.
+ * @param field Where the descriptor goes as SettingField.
+ * 
+ * @return Returns true if found as bool.
+*/
+bool Settings::findField(uint16_t offset, SettingField &field) {
+    for (uint8_t i = 0; i < SETTING_FIELD_COUNT; i ++) {
+        readField(i, field);
+        if (field.offset == offset) {
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * #### PRIVATE ####
+ * Checks if the field at the given offset of the settings is at its
+ * factory value.
+ * 
+ * @param offset The offset of the field within NonVolatileSettings as uint16_t.
+ * 
+ * @return Returns true if at the factory value as bool.
+*/
+bool Settings::isFactory(uint16_t offset) {
+    SettingField field;
+    if (!findField(offset, field)) {
+
+        return false;
+    }
+    if (field.type == SETTING_TYPE_TEXT) {
+
+        return (strcmp_P(textOf(nvSettings, field), field.factoryText) == 0);
+    }
+
+    return (readNumber(nvSettings, field) == field.factoryNumber);
+}
+
+/**
+ * #### PRIVATE ####
+ * Applies the records of the journal to the settings in the order they
+ * were written. Changes are only applied once a valid snapshot of the 
+ * whole settings has been read.
+ * 
+ * @return Returns true if a valid snapshot was read as bool.
+*/
+bool Settings::replayJournal() {
+    bool isLoaded = false;
+    JournalRecord record = {};
+    while (journal.nextRecord(record)) {
+        if (record.type == SETTINGS_RECORD_FULL && record.length == (sizeof(SettingsHeader) + sizeof(NonVolatileSettings))) {
+            SettingsHeader header;
+            isLoaded = (
+                journal.readRecord(record, 0U, &header, sizeof(header))
+                && journal.readRecord(record, sizeof(header), &nvSettings, sizeof(nvSettings))
+                && isHeaderValid(header, nvSettings)
+            );
+        } else if (record.type == SETTINGS_RECORD_PANIC && record.length == sizeof(PanicRecord) && isLoaded) {
+            PanicRecord panic;
+            if (journal.readRecord(record, 0U, &panic, sizeof(panic))) {
+                nvSettings.inPanicMode = (panic.inPanicMode != 0U);
+                nvSettings.panicLevel = panic.panicLevel;
+            }
+        }
+    }
+
+    return isLoaded;
+}
+
+/**
+ * #### PRIVATE ####
+ * Starts a new journal sector holding a snapshot of the current settings.
+ * 
+ * @return Returns true if successful as bool.
+*/
+bool Settings::compactSettings() {
+    SettingsHeader header = headerOf(nvSettings);
+
+    return journal.compact(SETTINGS_RECORD_FULL, &header, sizeof(header), &nvSettings, sizeof(nvSettings));
+}
+
+/**
+ * #### PRIVATE ####
+ * Looks for settings stored through EEPROM by firmware from before the 
+ * journal existed. These are either format v2, the settings header then
+ * the settings, or format v1, the bare settings with the MD5 sentinel. 
+ * If found and valid they are migrated into the journal, otherwise a 
+ * factory default is performed.
+ * 
+ * @return Returns true if older settings were found and loaded as bool.
+*/
+bool Settings::loadEepromSettings() {
+    bool ok = false;
+    bool isFound = false;
+
+    EEPROM.begin(sizeof(SettingsHeader) + sizeof(NonVolatileSettings));
+    delay(15);
+    if (EEPROM.percentUsed() >= 0) { // Format v2 is stored...
+        Serial.println(F("\nLoading settings from EEPROM..."));
+        isFound = true;
+        SettingsHeader header;
+        EEPROM.get(0, header);
+        EEPROM.get(sizeof(SettingsHeader), nvSettings);
+        ok = isHeaderValid(header, nvSettings);
+    }
+    EEPROM.end();
+
+    if (!isFound) {
+        EEPROM.begin(sizeof(NonVolatileSettings));
+        if (EEPROM.percentUsed() >= 0) { // Format v1 is stored...
+            Serial.println(F("\nLoading legacy settings from EEPROM..."));
+            isFound = true;
+            EEPROM.get(0, nvSettings);
+            ok = isLegacyHashValid(nvSettings);
+        }
+        EEPROM.end();
+    }
+
+    if (ok && isJournalUsable) { // Migrate into journal...
+        SettingField field;
+        if (findField(offsetof(NonVolatileSettings, sentinel), field)) {
+            defaultField(field);
+        }
+        if (compactSettings()) {
+            Serial.println(F("Stored settings migrated into journal."));
+        } else {
+            Serial.println(F("Failed to migrate stored settings, will retry at next boot!"));
+        }
+    } else if (isFound && !ok) { // Memory is corrupt...
+        factoryDefault();
+        Serial.println("Stored settings footprint invalid, stored settings have been wiped and defaulted!");
+    }
+
+    return ok;
+}
+
+/**
+ * #### PRIVATE ####
+ * Saves the settings through EEPROM as format v2, the settings header then 
+ * the settings. This is only used when the flash layout leaves no room for
+ * the journal, such as when the filesystem runs right up to the EEPROM 
+ * sector, and rewrites the whole sector on every save. Each save says so,
+ * as even a change of the panic state costs a full erase and rewrite.
+ * 
+ * @return Returns true if successful as bool.
+*/
+bool Settings::saveEepromSettings() {
+    Serial.println(F("Saving all settings to EEPROM, no room for the settings journal in flash layout."));
+    SettingsHeader header = headerOf(nvSettings);
+    EEPROM.begin(sizeof(SettingsHeader) + sizeof(NonVolatileSettings));
+
+    EEPROM.wipe(); // usage seemd to grow without this.
+    EEPROM.put(0, header);
+    EEPROM.put(sizeof(SettingsHeader), nvSettings);
+    
+    bool ok = EEPROM.commit();
+
+    EEPROM.end();
+    if (ok) {
+        dirtyMask = 0U;
+    }
+
+    return ok;
+}
+
+/**
+ * #### PRIVATE ####
+ * Builds the header stored ahead of the given settings.
  * 
- * @param nvSet An instance of NonVolatileSettings to calculate a hash for.
+ * @return Returns the header as SettingsHeader.
+*/
+SettingsHeader Settings::headerOf(const NonVolatileSettings &nvSet) {
+
+    return {SETTINGS_MAGIC, SETTINGS_FORMAT_VERSION, SETTINGS_HASH_CRC32, hashNvSettings(nvSet)};
+}
+
+/**
+ * #### PRIVATE ####
+ * Checks that the given header is of the current format and matches the
+ * given settings.
  * 
- * @return Returns the calculated hash value as String.
-*/
-String Settings::hashNvSettings(struct NonVolatileSettings nvSet) {
-    String content = "";
-    content = content + String(nvSet.ssid);
-    content = content + String(nvSet.pwd);
-    content = content + String(nvSet.owner);
-    content = content + String(nvSet.message);
-    content = content + String(nvSet.smtpHost);
-    content = content + String(nvSet.smtpPort);
-    content = content + String(nvSet.smtpUser);
-    content = content + String(nvSet.smtpPwd);
-    content = content + String(nvSet.fromEmail);
-    content = content + String(nvSet.fromName);
-    content = content + String(nvSet.recipients);
-    content = content + String(nvSet.inPanicMode);
-    content = content + String(nvSet.panicLevel);
+ * @return Returns true if valid as bool.
+*/
+bool Settings::isHeaderValid(const SettingsHeader &header, const NonVolatileSettings &nvSet) {
+
+    return (
+        header.magic == SETTINGS_MAGIC
+        && header.version == SETTINGS_FORMAT_VERSION
+        && header.hashType == SETTINGS_HASH_CRC32
+        && header.hash == hashNvSettings(nvSet)
+    );
+}
 
+/**
+ * #### PRIVATE ####
+ * Used to provide a hash of the given NonVolatileSettings. The hashed 
+ * fields are streamed directly into a CRC32, in the order of SETTING_FIELDS, 
+ * so nothing is copied or allocated. Text fields are hashed up to and 
+ * including their null terminator so that any leftover characters after 
+ * it don't change the hash. The legacy sentinel isn't part of the hash.
+ * 
+ * @param nvSet The NonVolatileSettings to calculate a hash for.
+ * 
+ * @return Returns the calculated hash value as uint32_t.
+*/
+uint32_t Settings::hashNvSettings(const NonVolatileSettings &nvSet) {
+    uint32_t crc = 0xFFFFFFFFUL;
+    SettingField field;
+    for (uint8_t i = 0; i < SETTING_FIELD_COUNT; i ++) {
+        readField(i, field);
+        if (!(field.flags & SETTING_HASHED)) {
+            continue;
+        }
+        if (field.type == SETTING_TYPE_TEXT) {
+            const char* text = textOf(nvSet, field);
+            crc = CrcUtils::crc32Update(crc, text, strnlen(text, field.size - 1));
+            crc = CrcUtils::crc32Update(crc, "", 1); // Terminator
+        } else if (field.type == SETTING_TYPE_BOOL) {
+            uint8_t flag = (readNumber(nvSet, field) ? 1U : 0U);
+            crc = CrcUtils::crc32Update(crc, &flag, sizeof(flag));
+        } else {
+            crc = CrcUtils::crc32Update(crc, ((const uint8_t*)&nvSet) + field.offset, field.size);
+        }
+    }
+
+    return ~crc;
+}
+
+/**
+ * #### PRIVATE ####
+ * Checks the MD5 sentinel of settings stored in the legacy format. The
+ * fields are streamed into the MD5 in the same order and form the legacy
+ * format used, but without building up a String of them first.
+ * 
+ * @param nvSet The legacy NonVolatileSettings to check.
+ * 
+ * @return Returns true if the sentinel matches the settings as bool.
+*/
+bool Settings::isLegacyHashValid(const NonVolatileSettings &nvSet) {
     MD5Builder builder = MD5Builder();
     builder.begin();
-    builder.add(content);
+    auto addText = [&builder](const char* field, size_t capacity) {
+        builder.add((const uint8_t*)field, (uint16_t)strnlen(field, capacity));
+    };
+    char number[12];
+
+    addText(nvSet.ssid, sizeof(nvSet.ssid));
+    addText(nvSet.pwd, sizeof(nvSet.pwd));
+    addText(nvSet.owner, sizeof(nvSet.owner));
+    addText(nvSet.message, sizeof(nvSet.message));
+    addText(nvSet.smtpHost, sizeof(nvSet.smtpHost));
+    utoa(nvSet.smtpPort, number, 10);
+    addText(number, sizeof(number));
+    addText(nvSet.smtpUser, sizeof(nvSet.smtpUser));
+    addText(nvSet.smtpPwd, sizeof(nvSet.smtpPwd));
+    addText(nvSet.fromEmail, sizeof(nvSet.fromEmail));
+    addText(nvSet.fromName, sizeof(nvSet.fromName));
+    addText(nvSet.recipients, sizeof(nvSet.recipients));
+    addText((nvSet.inPanicMode ? "1" : "0"), 2);
+    itoa(nvSet.panicLevel, number, 10);
+    addText(number, sizeof(number));
     builder.calculate();
 
-    return builder.toString();
-}
\ No newline at end of file
+    char hash[33];
+    builder.getChars(hash);
+
+    return (strncmp(hash, nvSet.sentinel, sizeof(hash)) == 0);
+}
+
+/**
+ * #### PRIVATE ####
+ * Writes the given text as a quoted JSON string, escaping it as needed.
+ * 
+ * @param out Where the string is written as Print.
+ * @param text The text as const char*.
+ * @param length The length of the text as size_t.
+*/
+void Settings::writeJsonText(Print &out, const char* text, size_t length) {
+    out.print('"');
+    for (size_t i = 0U; i < length; i ++) {
+        char c = text[i];
+        if (c == '"' || c == '\\') {
+            out.print('\\');
+            out.print(c);
+        } else if (c == '\n') {
+            out.print(F("\\n"));
+        } else if (c == '\r') {
+            out.print(F("\\r"));
+        } else if (c == '\t') {
+            out.print(F("\\t"));
+        } else if (c == '\b') {
+            out.print(F("\\b"));
+        } else if (c == '\f') {
+            out.print(F("\\f"));
+        } else if ((uint8_t)c < 0x20U) {
+            out.printf("\\u%04x", (uint8_t)c);
+        } else {
+            out.print(c);
+        }
+    }
+    out.print('"');
+}
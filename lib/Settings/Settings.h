@@ -13,11 +13,30 @@
 #ifndef Settings_h
     #define Settings_h
 
+    #include <stdint.h>
     #include <string.h> // NEEDED by ESP_EEPROM and MUST appear before WString
+    #include <stddef.h>
     #include <ESP_EEPROM.h>
     #include <WString.h>
     #include <HardwareSerial.h>
+    #include <Print.h>
     #include <MD5Builder.h>
+    #include <pgmspace.h>
+    #include <CrcUtils.h>
+    #include <FlashJournal.h>
+    #include <ParseUtils.h>
+
+    #define SETTINGS_JOURNAL_SECTORS 2
+    #define SETTINGS_RECORD_FULL 1 // SettingsHeader then NonVolatileSettings
+    #define SETTINGS_RECORD_PANIC 2 // PanicRecord
+    #define SETTINGS_DIRTY_PANIC 0x01 // Only panic state changed
+    #define SETTINGS_DIRTY_ALL 0x02
+    #define SETTINGS_MAX_RECIPIENTS 16
+    #define SETTINGS_QUOTE(x) #x
+    #define SETTINGS_TO_TEXT(x) SETTINGS_QUOTE(x) // Expands x first, for numbers in messages
+    #define SETTINGS_AP_NET_IP "192.168.1.1"
+    #define SETTINGS_AP_SUBNET "255.255.255.0"
+    #define SETTINGS_AP_GATEWAY "0.0.0.0"
 
     // *****************************************************************************
     // Structure used for storing of settings related data and persisted into flash
@@ -36,43 +55,119 @@
         char           recipients       [510]      ; // CSV 10 Addresses each max of 50 chars + null
         bool           inPanicMode                 ;
         int            panicLevel                  ;
-        char           sentinel         [33]       ; // Holds a 32 MD5 hash + 1
+        char           sentinel         [33]       ; // Legacy MD5 hash + 1, only used by format v1
+    };
+
+    // *****************************************************************************
+    // Describes one field of NonVolatileSettings. The table of these, SETTING_FIELDS,
+    // is kept in PROGMEM and drives defaulting, hashing, validating updates and the
+    // JSON export, so a field is added with one line in the table. The table is in
+    // the order of the struct, which is also the order the fields are hashed in.
+    // Its texts are separate PROGMEM strings it points to, declared for a field
+    // with SETTING_STRINGS, so a row only takes the space of its own texts. Fields
+    // which aren't exported have no key or messages.
+    // *****************************************************************************
+    #define SETTING_TYPE_TEXT 0
+    #define SETTING_TYPE_UINT 1 // unsigned int
+    #define SETTING_TYPE_INT 2 // int
+    #define SETTING_TYPE_BOOL 3
+
+    #define SETTING_HASHED 0x01 // Part of the settings hash
+    #define SETTING_EXPORTED 0x02 // In the JSON export and updates
+    #define SETTING_NOT_FACTORY 0x04 // Factory value doesn't count as set in updates
+
+    #define SETTING_KEY_SIZE 12 // Longest JSON key with null
+
+    struct SettingField {
+        PGM_P          key                         ; // JSON key, null if not exported
+        uint16_t       offset                      ; // Within NonVolatileSettings
+        uint16_t       size                        ; // Text capacity with null, or size of number
+        uint8_t        type                        ;
+        uint8_t        flags                       ;
+        int32_t        min                         ; // Numbers only
+        int32_t        max                         ; // Numbers only
+        int32_t        factoryNumber               ;
+        PGM_P          factoryText                 ; // Text only
+        PGM_P          invalidMessage              ; // Too long or out of range
+        PGM_P          requiredMessage             ;
+    };
+
+    #define SETTING_STRINGS(member, key, invalid, required) \
+        static_assert(sizeof(key) <= SETTING_KEY_SIZE, "Key of " #member " is too long!"); \
+        static const char member##Key[] PROGMEM = key; \
+        static const char member##Invalid[] PROGMEM = invalid; \
+        static const char member##Required[] PROGMEM = required;
+    #define SETTING_TEXT(member, flags, factory) \
+        {member##Key, offsetof(NonVolatileSettings, member), sizeof(NonVolatileSettings::member), SETTING_TYPE_TEXT, flags, 0L, 0L, 0L, factory, member##Invalid, member##Required}
+    #define SETTING_NUMBER(member, type, flags, min, max, factory) \
+        {member##Key, offsetof(NonVolatileSettings, member), sizeof(NonVolatileSettings::member), type, flags, min, max, factory, nullptr, member##Invalid, member##Required}
+    #define SETTING_INTERNAL(member, type, flags, factoryNumber, factoryText) \
+        {nullptr, offsetof(NonVolatileSettings, member), sizeof(NonVolatileSettings::member), type, flags, 0L, 0L, factoryNumber, factoryText, nullptr, nullptr}
+
+    extern const SettingField SETTING_FIELDS[] PROGMEM;
+    extern const uint8_t SETTING_FIELD_COUNT;
+
+    // *****************************************************************************
+    // Header persisted into flash ahead of the settings. It identifies the format
+    // and hash used to store the settings so either can change without wiping the
+    // settings of devices already in the field. Settings stored before the header
+    // existed are format v1, the bare NonVolatileSettings with its MD5 sentinel.
+    // *****************************************************************************
+    #define SETTINGS_MAGIC 0x42504E46UL // "FNPB"
+    #define SETTINGS_FORMAT_VERSION 2
+    #define SETTINGS_HASH_CRC32 1
+
+    struct SettingsHeader {
+        uint32_t       magic                       ;
+        uint16_t       version                     ;
+        uint16_t       hashType                    ;
+        uint32_t       hash                        ;
+    };
+
+    // *****************************************************************************
+    // Journal record for the panic state, which changes far more often than the 
+    // rest of the settings.
+    // *****************************************************************************
+    struct PanicRecord {
+        int32_t        panicLevel                  ;
+        uint8_t        inPanicMode                 ;
+        uint8_t        reserved         [3]        ;
+    };
+
+    // *****************************************************************************
+    // A read only view of a stored text setting. It points directly at the stored
+    // characters so nothing is copied or allocated, and is only valid for as long
+    // as the setting isn't changed.
+    // *****************************************************************************
+    struct SettingView {
+        const char*    chars                       ; // Always null terminated
+        unsigned int   length                      ;
     };
     
+    // *****************************************************************************
+    // Where one address is within the stored recipients setting, so the list can
+    // be walked through without parsing it again.
+    // *****************************************************************************
+    struct RecipientEntry {
+        uint16_t       offset                      ;
+        uint16_t       length                      ;
+    };
+
     class Settings {
         private:
             struct NonVolatileSettings nvSettings;
-            const struct NonVolatileSettings factorySettings = {
-                "SET_ME", // <-------------------------- ssid
-                "SET_ME", // <-------------------------- pwd
-                "SET_ME", // <-------------------------- owner
-                "Please send help ASAP!", // <---------- message
-                "SET_ME", // <-------------------------- smtpHost
-                465, // <------------------------------- smtpPort
-                "SET_ME", // <-------------------------- smtpUser
-                "SET_ME", // <-------------------------- smtpPwd
-                "no-reply@panic-button.com", // <------- fromEmail
-                "FriendlyNeighbor PanicButton", // <---- fromName
-                "test@email.com", // <------------------ recipients
-                false, // <----------------------------- inPanicMode
-                5, // <--------------------------------- panicLevel
-                "NA" // <------------------------------- sentinel
-            };
+            FlashJournal journal;
+            bool isJournalUsable = false; // Journal sectors are clear of the filesystem
+            uint8_t dirtyMask = 0U;
 
             // ******************************************************************
             // Structure used for storing of settings related data NOT persisted
             // ******************************************************************
 
-            /*
-                PLEASE NOTE: Just below is an example of what I would use if there
-                were also some settings which were not constant but also not persisted
-                to storage. I left this block here as a reminder incase I want to use 
-                it later.
-            */
-
-            // struct VolatileSettings {
-            //     bool           unused            ;
-            // } vSettings;
+            struct VolatileSettings {
+                RecipientEntry recipients        [SETTINGS_MAX_RECIPIENTS];
+                uint8_t        recipientCount    ;
+            } vSettings;
 
             struct ConstantSettings {
                 String         hostnamePrefix    ;
@@ -87,15 +182,28 @@
                 "FNPB-", // <--------------- hostnamePrefix (*later ID is added)
                 "Panic_Button_", // <------- apSsidPrefix (*later ID is added)
                 "P@ssw0rd123", // <--------- apPwd 
-                "192.168.1.1", // <--------- apNetIp
-                "255.255.255.0", // <------- apSubnet
-                "0.0.0.0", // <------------- apGateway
+                SETTINGS_AP_NET_IP, // <---- apNetIp
+                SETTINGS_AP_SUBNET, // <---- apSubnet
+                SETTINGS_AP_GATEWAY, // <--- apGateway
                 "admin", // <--------------- adminUser
                 "P@ssw0rd123" // <---------- adminPwd
             };
             
             void defaultSettings();
-            String hashNvSettings(struct NonVolatileSettings nvSet);
+            void defaultField(const SettingField &field);
+            bool findField(uint16_t offset, SettingField &field);
+            bool isFactory(uint16_t offset);
+            static SettingView viewOf(const char* field, unsigned int capacity);
+            void indexRecipients();
+            bool replayJournal();
+            bool compactSettings();
+            bool loadEepromSettings();
+            bool saveEepromSettings();
+            static SettingsHeader headerOf(const NonVolatileSettings &nvSet);
+            static bool isHeaderValid(const SettingsHeader &header, const NonVolatileSettings &nvSet);
+            static uint32_t hashNvSettings(const NonVolatileSettings &nvSet);
+            static bool isLegacyHashValid(const NonVolatileSettings &nvSet);
+            static void writeJsonText(Print &out, const char* text, size_t length);
 
 
         public:
@@ -104,10 +212,23 @@
             bool factoryDefault();
             bool loadSettings();
             bool saveSettings();
+            bool savePanicState();
+            bool isDirty();
+            bool flush();
             bool isFactoryDefault();
             bool isNetworkSet();
 
-            NonVolatileSettings getFactorySettings();
+            static void readField(uint8_t index, SettingField &field);
+            static long readNumber(const NonVolatileSettings &nvSet, const SettingField &field);
+            static void writeNumber(NonVolatileSettings &nvSet, const SettingField &field, long number);
+            static char* textOf(NonVolatileSettings &nvSet, const SettingField &field);
+            static const char* textOf(const NonVolatileSettings &nvSet, const SettingField &field);
+
+            SettingView viewField(const SettingField &field);
+            long getFieldNumber(const SettingField &field);
+            void applyFields(const NonVolatileSettings &staged, uint8_t flags);
+            void writeJson(Print &out);
+            static bool normalizeRecipients(char* recipients);
 
             /*
             =========================================================
@@ -164,6 +285,24 @@
 
             void           setInPanicMode             (bool inPanic)              ;
             bool           getInPanicMode             ()                          ;
+
+            /*
+            =========================================================
+                        Allocation Free Views of Text Settings
+            =========================================================
+            */
+            SettingView    viewSsid                   ()                          ;
+            SettingView    viewPwd                    ()                          ;
+            SettingView    viewOwner                  ()                          ;
+            SettingView    viewMessage                ()                          ;
+            SettingView    viewSmtpHost               ()                          ;
+            SettingView    viewSmtpUser               ()                          ;
+            SettingView    viewSmtpPwd                ()                          ;
+            SettingView    viewFromEmail              ()                          ;
+            SettingView    viewFromName               ()                          ;
+            SettingView    viewRecipients             ()                          ;
+            uint8_t        getRecipientCount          ()                          ;
+            TextSlice      viewRecipient              (uint8_t index)             ;
             
 
             String         getHostname       (String deviceId)        ;
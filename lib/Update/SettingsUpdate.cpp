@@ -0,0 +1,172 @@
+/*
+ * SettingsUpdate - Validates a settings update from the admin page and
+ * stages it into a NonVolatileSettings.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include "SettingsUpdate.h"
+
+/**
+ * Fills in the filter to parse an update with, so that only the keys of
+ * the settings in the JSON export are kept whatever else the update holds.
+ *
+ * @param filter The filter document to fill in as JsonDocument.
+*/
+void SettingsUpdate::buildFilter(JsonDocument &filter) {
+    SettingField field;
+    char key[SETTING_KEY_SIZE];
+    for (uint8_t i = 0; i < SETTING_FIELD_COUNT; i ++) {
+        Settings::readField(i, field);
+        if (field.flags & SETTING_EXPORTED) {
+            strcpy_P(key, field.key);
+            filter[key] = true;
+        }
+    }
+}
+
+/**
+ * Validates the settings of an update and writes them into the given
+ * staged settings. Each setting in the JSON export is checked, in the
+ * order of SETTING_FIELDS, against its limits in the table. The list of
+ * recipients is also checked address by address and tidied up. Nothing is
+ * changed in the live settings, so an update which fails part way through
+ * leaves them as they were.
+ *
+ * @param json The parsed update as JsonObjectConst.
+ * @param staged Where the validated values go as NonVolatileSettings.
+ *
+ * @return Returns nullptr if everything validated, otherwise the message
+ * for the first problem as const __FlashStringHelper*.
+*/
+const __FlashStringHelper* SettingsUpdate::stage(JsonObjectConst json, NonVolatileSettings &staged) {
+    SettingField field;
+    char key[SETTING_KEY_SIZE];
+    for (uint8_t i = 0; i < SETTING_FIELD_COUNT; i ++) {
+        Settings::readField(i, field);
+        if (!(field.flags & SETTING_EXPORTED)) {
+            continue;
+        }
+
+        strcpy_P(key, field.key);
+        JsonVariantConst value = json[key];
+        StageResult result = (field.type == SETTING_TYPE_TEXT) ? stageText(value, field, staged) : stageNumber(value, field, staged);
+        if (result == SR_OK && field.offset == offsetof(NonVolatileSettings, recipients) && !Settings::normalizeRecipients(staged.recipients)) {
+            result = SR_INVALID;
+        }
+        if (result == SR_MISSING) {
+
+            return FPSTR(field.requiredMessage);
+        }
+        if (result == SR_INVALID) {
+
+            return FPSTR(field.invalidMessage);
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * Narrows the given text to leave off white space at either end, the same
+ * as String's trim, without copying it.
+ *
+ * @param text The start of the text, moved past leading white space, as const char*.
+ * @param length The length of the text, shortened to match, as size_t.
+*/
+void SettingsUpdate::trimRange(const char* &text, size_t &length) {
+    while (length > 0U && isspace((unsigned char)text[0])) {
+        text ++;
+        length --;
+    }
+    while (length > 0U && isspace((unsigned char)text[length - 1U])) {
+        length --;
+    }
+}
+
+/*
+=================================================================
+Private Functions
+=================================================================
+*/
+
+/**
+ * #### PRIVATE ####
+ * Validates a text setting of an update and copies it, trimmed, into its
+ * staged field. Blank text, or text still at its factory value when that
+ * isn't allowed, counts as missing.
+ *
+ * @param value The value from the update as JsonVariantConst.
+ * @param field The field being validated as SettingField.
+ * @param staged The settings to copy into as NonVolatileSettings.
+ *
+ * @return Returns the result as StageResult.
+*/
+StageResult SettingsUpdate::stageText(JsonVariantConst value, const SettingField &field, NonVolatileSettings &staged) {
+    const char* text = value.as<const char*>();
+    size_t length = (text == nullptr) ? 0U : strlen(text);
+    trimRange(text, length);
+    if (
+        length == 0U
+        || ((field.flags & SETTING_NOT_FACTORY) && strlen_P(field.factoryText) == length && strncmp_P(text, field.factoryText, length) == 0)
+    ) {
+
+        return SR_MISSING;
+    }
+    if (length >= field.size) {
+
+        return SR_INVALID;
+    }
+    char* dest = Settings::textOf(staged, field);
+    memcpy(dest, text, length);
+    dest[length] = '\0';
+
+    return SR_OK;
+}
+
+/**
+ * #### PRIVATE ####
+ * Validates a whole number setting of an update, which may be given as a
+ * JSON number or as text, and stores it into its staged field.
+ *
+ * @param value The value from the update as JsonVariantConst.
+ * @param field The field being validated as SettingField.
+ * @param staged The settings to store into as NonVolatileSettings.
+ *
+ * @return Returns the result as StageResult.
+*/
+StageResult SettingsUpdate::stageNumber(JsonVariantConst value, const SettingField &field, NonVolatileSettings &staged) {
+    long number = 0L;
+    if (value.is<long>()) {
+        number = value.as<long>();
+    } else if (value.is<double>()) { // Fraction is dropped, like toInt...
+        double whole = trunc(value.as<double>());
+        if (whole < (double)field.min || whole > (double)field.max) {
+
+            return SR_INVALID;
+        }
+        number = (long)whole;
+    } else {
+        const char* text = value.as<const char*>();
+        size_t length = (text == nullptr) ? 0U : strlen(text);
+        trimRange(text, length);
+        if (length == 0U) {
+
+            return SR_MISSING;
+        }
+        LongParse parsed = ParseUtils::parseLong(text, length);
+        if (parsed.error != PE_OK || parsed.consumed != length) { // Not a whole number...
+
+            return SR_INVALID;
+        }
+        number = parsed.value;
+    }
+    if (number < field.min || number > field.max) {
+
+        return SR_INVALID;
+    }
+    Settings::writeNumber(staged, field, number);
+
+    return SR_OK;
+}
@@ -0,0 +1,37 @@
+/*
+ * SettingsUpdate - Validates a settings update from the admin page and
+ * stages it into a NonVolatileSettings, driven by the SETTING_FIELDS table.
+ * The update is parsed through a filter so only the settings keys are ever
+ * kept, and each value is validated and copied straight into the staged
+ * settings, so the live settings are only changed once all of it is valid.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef SettingsUpdate_h
+    #define SettingsUpdate_h
+
+    #include <Arduino.h>
+    #include <ArduinoJson.h>
+    #include <Settings.h>
+    #include <ParseUtils.h>
+
+    enum StageResult {
+        SR_OK,
+        SR_MISSING,
+        SR_INVALID
+    };
+
+    class SettingsUpdate {
+        private:
+            static StageResult stageText(JsonVariantConst value, const SettingField &field, NonVolatileSettings &staged);
+            static StageResult stageNumber(JsonVariantConst value, const SettingField &field, NonVolatileSettings &staged);
+
+        public:
+            static void buildFilter(JsonDocument &filter);
+            static const __FlashStringHelper* stage(JsonObjectConst json, NonVolatileSettings &staged);
+            static void trimRange(const char* &text, size_t &length);
+    };
+
+#endif
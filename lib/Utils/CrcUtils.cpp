@@ -0,0 +1,35 @@
+/*
+    Written by: Scott Griffis
+    Date: 10-16-2026
+*/
+
+#include "CrcUtils.h"
+
+static const uint32_t CRC32_NIBBLES[16] PROGMEM = {
+    0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL,
+    0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+    0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL,
+    0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL
+};
+
+/**
+ * Adds the given bytes to a running CRC32. The CRC is worked out a nibble
+ * at a time so the lookup table stays small, and is kept in flash. 
+ * 
+ * @param crc The running CRC, start with 0xFFFFFFFF and invert when done, 
+ * as uint32_t.
+ * @param data The bytes to add as const void*.
+ * @param length The number of bytes to add as size_t.
+ * 
+ * @return Returns the updated running CRC as uint32_t.
+*/
+uint32_t CrcUtils::crc32Update(uint32_t crc, const void* data, size_t length) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < length; i ++) {
+        crc ^= bytes[i];
+        crc = (crc >> 4) ^ pgm_read_dword(&CRC32_NIBBLES[crc & 0x0F]);
+        crc = (crc >> 4) ^ pgm_read_dword(&CRC32_NIBBLES[crc & 0x0F]);
+    }
+
+    return crc;
+}
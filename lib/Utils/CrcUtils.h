@@ -0,0 +1,14 @@
+#ifndef CrcUtils_h
+    #define CrcUtils_h
+
+    #include <stdint.h>
+    #include <stddef.h>
+    #include <pgmspace.h>
+
+    class CrcUtils {
+        private:
+
+        public:
+            static uint32_t crc32Update(uint32_t crc, const void* data, size_t length);
+    };
+#endif
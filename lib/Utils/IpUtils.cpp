@@ -5,53 +5,28 @@
 
 #include "IpUtils.h"
 
-IPAddress IpUtils::stringIPv4ToIPAddress(String ip) {
-    String oct[4];
-
-    int curIndex = 0;
-    String temp = "";
-    for (unsigned int i = 0; i < ip.length(); i++) {
-        if (ip.charAt(i) != '.') {
-            temp.concat(ip.charAt(i));
-        } else {
-            oct[curIndex] = String(temp);
-            temp = "";
-            curIndex ++;
-        }
-    }
-    oct[curIndex] = String(temp);
+/**
+ * @param address The address with its first octet in the highest byte as
+ * uint32_t.
+ *
+ * @return Returns the address as IPAddress.
+*/
+IPAddress IpUtils::toIPAddress(uint32_t address) {
 
-    return IPAddress(oct[0].toInt(), oct[1].toInt(), oct[2].toInt(), oct[3].toInt());
+    return IPAddress((address >> 24) & 255, (address >> 16) & 255, (address >> 8) & 255, address & 255);
 }
 
-unsigned long IpUtils::ipv4ToBinary(String ip) {
-    /* Pull Appart IP Into Octets */
-    unsigned int oct[4];
+IPAddress IpUtils::stringIPv4ToIPAddress(const String &ip) {
 
-    int curIndex = 0;
-    String temp = "";
-    for (unsigned int i = 0; i < ip.length(); i++) {
-        if (ip.charAt(i) != '.') {
-            temp.concat(ip.charAt(i));
-        } else {
-            oct[curIndex] = String(temp).toInt();
-            temp = "";
-            curIndex ++;
-        }
-    }
-    oct[curIndex] = String(temp).toInt();
+    return toIPAddress(parseIPv4(ip.c_str(), ip.length()).address);
+}
 
-    /* Derive Binary From Octets */
-    unsigned long ipBin = 0UL;
-    for (int i = 0; i < 4; i ++) {
-        ipBin = (ipBin << 8);
-        ipBin = (ipBin | oct[i]);
-    }
+unsigned long IpUtils::ipv4ToBinary(const String &ip) {
 
-    return ipBin;
+    return parseIPv4(ip.c_str(), ip.length()).address;
 }
 
-IPAddress IpUtils::deriveNetworkBroadcastAddress(String ip, String subnet) {
+IPAddress IpUtils::deriveNetworkBroadcastAddress(const String &ip, const String &subnet) {
     unsigned long ipBin = ipv4ToBinary(ip);
     unsigned long subBin = ipv4ToBinary(subnet);
 
@@ -59,14 +34,5 @@ IPAddress IpUtils::deriveNetworkBroadcastAddress(String ip, String subnet) {
     unsigned long temp = (ipBin & subBin);
     temp = (temp | (~ subBin));
 
-    /* Pull Octets From Binary */
-    unsigned int oct[4];
-    for (int i = 3; i >= 0; i --) {
-        oct[i] = temp & 255;
-        temp = (temp >> 8);
-    }
-
-    IPAddress result = IPAddress(oct[0], oct[1], oct[2], oct[3]);
-
-    return result;
-}
\ No newline at end of file
+    return toIPAddress((uint32_t)temp);
+}
@@ -1,15 +1,91 @@
 #ifndef IpUtils_h
     #define IpUtils_h
 
+    #include <stdint.h>
+    #include <stddef.h>
     #include <WString.h>
     #include <IPAddress.h>
 
+    // *****************************************************************************
+    // Result of parsing an IPv4 address in dot notation. The address holds the 
+    // first octet in its highest byte, the same as ipv4ToBinary gives.
+    // *****************************************************************************
+    struct IPv4Parse {
+        bool           isValid                     ;
+        uint32_t       address                     ; // 0 when not valid
+    };
+
     class IpUtils {
         private:
 
         public:
-            static IPAddress stringIPv4ToIPAddress(String ip);
-            static IPAddress deriveNetworkBroadcastAddress(String ip, String subnet);
-            static unsigned long ipv4ToBinary(String ip);
+            static constexpr IPv4Parse parseIPv4(const char* chars, size_t length);
+            static constexpr IPv4Parse parseIPv4(const char* chars);
+            static IPAddress toIPAddress(uint32_t address);
+
+            static IPAddress stringIPv4ToIPAddress(const String &ip);
+            static IPAddress deriveNetworkBroadcastAddress(const String &ip, const String &subnet);
+            static unsigned long ipv4ToBinary(const String &ip);
     };
-#endif
\ No newline at end of file
+
+    /**
+     * Parses an IPv4 address in dot notation in a single pass without
+     * allocating anything. It must be exactly four octets of one to three
+     * digits each, no larger than 255, separated by '.' characters. Being
+     * constexpr, an address known at compile time is parsed at compile time.
+     *
+     * @param chars The text to parse, which doesn't need to be null terminated,
+     * as const char*.
+     * @param length The length of the text as size_t.
+     *
+     * @return Returns the result as IPv4Parse.
+    */
+    constexpr IPv4Parse IpUtils::parseIPv4(const char* chars, size_t length) {
+        uint32_t address = 0UL;
+        uint16_t octet = 0U;
+        uint8_t digits = 0U;
+        uint8_t dots = 0U;
+        for (size_t i = 0U; i < length; i ++) {
+            char c = chars[i];
+            if (c >= '0' && c <= '9') {
+                octet = (uint16_t)((octet * 10U) + (uint16_t)(c - '0'));
+                digits ++;
+                if (digits > 3U || octet > 255U) { // Not an octet...
+
+                    return {false, 0UL};
+                }
+            } else if (c == '.' && digits > 0U && dots < 3U) { // End of an octet...
+                address = (address << 8) | octet;
+                octet = 0U;
+                digits = 0U;
+                dots ++;
+            } else {
+
+                return {false, 0UL};
+            }
+        }
+        if (digits == 0U || dots != 3U) { // Missing an octet...
+
+            return {false, 0UL};
+        }
+
+        return {true, (address << 8) | octet};
+    }
+
+    /**
+     * Parses a null terminated IPv4 address in dot notation, see the other
+     * parseIPv4.
+     *
+     * @param chars The text to parse as const char*.
+     *
+     * @return Returns the result as IPv4Parse.
+    */
+    constexpr IPv4Parse IpUtils::parseIPv4(const char* chars) {
+        size_t length = 0U;
+        while (chars[length] != '\0') {
+            length ++;
+        }
+
+        return parseIPv4(chars, length);
+    }
+#endif
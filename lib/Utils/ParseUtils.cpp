@@ -8,6 +8,28 @@
 */
 
 #include "ParseUtils.h"
+#include "IpUtils.h"
+#include <errno.h>
+
+// Value of each character as a hex digit, 0xFF when it isn't one...
+static const uint8_t HEX_NIBBLES[256] PROGMEM = {
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, // '0' - '9'
+  0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, // 'A' - 'F'
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, // 'a' - 'f'
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
 
 /**
  * Allows for information to be parsed out of a String between a Keyword and a Terminating
@@ -152,7 +174,8 @@ unsigned int ParseUtils::occurrences(std::string &str, char toCnt) {
 
 /**
  * Counts the number of occurrences of a specific String within a 
- * given String.
+ * given String. Occurrences don't overlap, the count carries on from the
+ * end of each one found.
  *
  * @param str - The String from which the occurances of the given String will be counted as String.
  * @param toCnt - The String of which to count the occurrances of as String.
@@ -160,18 +183,14 @@ unsigned int ParseUtils::occurrences(std::string &str, char toCnt) {
  * @return Returns the number of occurrences counted as unsigned int.
  */ 
 unsigned int ParseUtils::occurrences(String &str, String toCnt) {
-  unsigned int count = 0;
-  int location = toCnt.length() * -1;
-  while ((location = str.indexOf(toCnt, location + toCnt.length())) != -1) {
-    count++;
-  }
 
-  return count;
+  return countMatches(str.c_str(), str.length(), toCnt.c_str(), toCnt.length());
 }
 
 /**
  * Counts the number of occurrences of a specific string within a 
- * given string.
+ * given string. Occurrences don't overlap, the count carries on from the
+ * end of each one found.
  *
  * @param str - The string from which the occurances of the given string will be counted as std::string.
  * @param toCnt - The string of which to count the occurrances of as std::string.
@@ -179,13 +198,8 @@ unsigned int ParseUtils::occurrences(String &str, String toCnt) {
  * @return Returns the number of occurrences counted as unsigned int.
  */
 unsigned int ParseUtils::occurrences(std::string &str, std::string toCnt) {
-  unsigned int count = 0;
-  int location = toCnt.length() * -1;
-  while ((location = str.find(toCnt, location + toCnt.length())) != -1) {
-    count++;
-  }
 
-  return count;
+  return countMatches(str.data(), str.length(), toCnt.data(), toCnt.length());
 }
 
 /**
@@ -246,6 +260,36 @@ void ParseUtils::split(std::string &str, char separator, std::string *storage, u
   }
 }
 
+/**
+ * Gets a TokenIterator for walking through the separated tokens of the given
+ * string without copying them out of it, unlike split. Each token is trimmed
+ * of whitespace and empty tokens are skipped.
+ *
+ * @param str - The string to walk through as String.
+ * @param separator - The character which separates the tokens as char.
+ *
+ * @return Returns the iterator positioned before the first token as TokenIterator.
+ */
+TokenIterator ParseUtils::tokenize(const String &str, char separator) {
+
+  return TokenIterator(str.c_str(), str.length(), separator);
+}
+
+/**
+ * Gets a TokenIterator for walking through the separated tokens of the given
+ * string without copying them out of it, unlike split. Each token is trimmed
+ * of whitespace and empty tokens are skipped.
+ *
+ * @param str - The string to walk through as std::string.
+ * @param separator - The character which separates the tokens as char.
+ *
+ * @return Returns the iterator positioned before the first token as TokenIterator.
+ */
+TokenIterator ParseUtils::tokenize(const std::string &str, char separator) {
+
+  return TokenIterator(str.data(), str.length(), separator);
+}
+
 /**
  * Performs a substring type function on the given string where what is returned
  * is determined by parsing the data out inclusively from the beginIndex and 
@@ -311,31 +355,9 @@ std::string ParseUtils::trim(std::string &str) {
  * 
  * @return Returns the parsed value as float.
  */
-float ParseUtils::toFloat(std::string str) {
-  if (!str.empty()) { // Something to work on...
-    for (unsigned int i = 0; i < str.length(); i++) { // Verify that chars are valid for a number...
-      if (!((str.at(i) >= '0' && str.at(i) <= '9') || str.at(i) == '.' || str.at(i) == '-')) { // not even close to valid number...
-        
-        return 0;
-      }
-    }
-
-    int minus = occurrences(str, '-');
-    if (minus > 1 || (minus == 1 && str.at(0) != '-')) { // too many minus signs or in wrong spot...
-
-      return 0;
-    }
-
-    int period = occurrences(str, '.');
-    if (period > 1) { // Not a valid number...
-
-      return 0;
-    }
-
-    return std::stof(str);
-  }
+float ParseUtils::toFloat(const std::string &str) {
 
-  return 0;
+  return (float)toDouble(str);
 }
 
 /**
@@ -347,76 +369,251 @@ float ParseUtils::toFloat(std::string str) {
  * 
  * @return Returns the parsed value as double.
  */
-double ParseUtils::toDouble(std::string str) {
-  if (!str.empty()) { // Something to work on...
-    for (unsigned int i = 0; i < str.length(); i++) { // Verify that chars are valid for a number...
-      if (!((str.at(i) >= '0' && str.at(i) <= '9') || str.at(i) == '.' || str.at(i) == '-')) { // not even close to valid number...
-        
-        return 0;
-      }
-    }
-
-    int minus = occurrences(str, '-');
-    if (minus > 1 || (minus == 1 && str.at(0) != '-')) { // too many minus signs or in wrong spot...
-
-      return 0;
-    }
-
-    int period = occurrences(str, '.');
-    if (period > 1) { // Not a valid number...
-
-      return 0;
-    }
+double ParseUtils::toDouble(const std::string &str) {
+  DoubleParse result = parseDouble(str.data(), str.length());
+  if (result.error != PE_OK || result.consumed != str.length()) { // Not a valid number...
 
-    return std::stod(str);
+    return 0;
   }
 
-  return 0;
+  return result.value;
 }
 
 /**
  * Used to parse an int out from a string that contains a valid integer 
- * number. If the contents of the given string are not a valid integer 
- * then the integer value of zero will be returned.
+ * number. A fraction is dropped, so "12.7" gives 12. If the contents of 
+ * the given string are not a valid integer, or don't fit in an int, then 
+ * the integer value of zero will be returned.
  *
  * @param str - The string to be parsed as an integer as std::string.
  * 
  * @return Returns the parsed value as int.
  */
-int ParseUtils::toInt(std::string str) {
-  if (!str.empty()) { // Something to work on...
-    for (unsigned int i = 0; i < str.length(); i++) { // Verify that chars are valid for a number...
-      if (!((str.at(i) >= '0' && str.at(i) <= '9') || str.at(i) == '.' || str.at(i) == '-')) { // not even close to valid number...
-        
+int ParseUtils::toInt(const std::string &str) {
+  LongParse result = parseLong(str.data(), str.length());
+  if (result.error != PE_OK || result.value < INT_MIN || result.value > INT_MAX) { // Not a valid int...
+
+    return 0;
+  }
+  if (result.consumed != str.length()) { // Only a fraction may follow...
+    if (str.at(result.consumed) != '.') {
+
+      return 0;
+    }
+    for (size_t i = result.consumed + 1U; i < str.length(); i++) {
+      if (str.at(i) < '0' || str.at(i) > '9') {
+
         return 0;
       }
     }
+  }
 
-    int minus = occurrences(str, '-');
-    if (minus > 1 || (minus == 1 && str.at(0) != '-')) { // too many minus signs or in wrong spot...
+  return (int)result.value;
+}
 
-      return 0;
+/**
+ * Parses a whole number in base 10 from the start of the given text in a
+ * single pass without allocating anything, in the manner of from_chars. It 
+ * is an optional '+' or '-' followed by digits, and parsing stops at the 
+ * first character that isn't a digit. Unlike strtol, leading whitespace 
+ * isn't skipped and there is no way to confuse "0" with nothing being 
+ * parsed.
+ *
+ * @param chars - The text, which doesn't need to be null terminated, as const char pointer.
+ * @param length - The length of the text as size_t.
+ *
+ * @return Returns the value, PE_INVALID with nothing consumed if there are
+ * no digits, or PE_OUT_OF_RANGE with the value clamped the same as strtol
+ * if it doesn't fit, as LongParse.
+ */
+LongParse ParseUtils::parseLong(const char* chars, size_t length) {
+  LongParse result = {0L, PE_INVALID, 0U};
+  size_t i = 0U;
+  bool isNegative = false;
+  if (i < length && (chars[i] == '-' || chars[i] == '+')) {
+    isNegative = (chars[i] == '-');
+    i++;
+  }
+
+  size_t firstDigit = i;
+  unsigned long limit = isNegative ? ((unsigned long)LONG_MAX + 1UL) : (unsigned long)LONG_MAX;
+  unsigned long magnitude = 0UL;
+  bool isOverflow = false;
+  for (; i < length && chars[i] >= '0' && chars[i] <= '9'; i++) { // Every digit is consumed, even past overflow...
+    unsigned long digit = (unsigned long)(chars[i] - '0');
+    if (isOverflow || magnitude > ((limit - digit) / 10UL)) {
+      isOverflow = true;
+    } else {
+      magnitude = (magnitude * 10UL) + digit;
     }
+  }
+  if (i == firstDigit) { // No digits...
+
+    return result;
+  }
 
-    int period = occurrences(str, '.');
-    if (period > 1) { // Not a valid number...
+  result.consumed = i;
+  if (isOverflow) {
+    result.value = isNegative ? LONG_MIN : LONG_MAX;
+    result.error = PE_OUT_OF_RANGE;
 
-      return 0;
+    return result;
+  }
+  result.value = (isNegative && magnitude != 0UL) ? (-(long)(magnitude - 1UL) - 1L) : (long)magnitude;
+  result.error = PE_OK;
+
+  return result;
+}
+
+/**
+ * Parses a decimal floating point number from the start of the given text
+ * in a single pass without allocating anything, in the manner of from_chars.
+ * It is an optional '+' or '-', digits with an optional '.' and fraction, 
+ * then an optional exponent of 'e' or 'E' with its own digits. Hex, inf
+ * and nan aren't accepted, nor is leading whitespace.
+ * 
+ * Up to 19 significant digits are gathered while scanning. When that is the
+ * whole number and the exponent is small, the value is worked out exactly
+ * from them, which covers what settings and sensors give. Otherwise the 
+ * scanned text is handed to strtod from a stack buffer so the result is 
+ * still correctly rounded. Text too long for that buffer is handed over as
+ * its first 40 significant digits and the adjusted exponent instead, with
+ * a trailing 1 standing in for any non-zero digits past them. That is still
+ * correctly rounded unless the value is within 1 part in 10^40 of halfway
+ * between two doubles.
+ *
+ * The exact case can't overflow or underflow, so range errors are taken
+ * from strtod's ERANGE. That makes a value too small for a double, which 
+ * rounds to a subnormal or to zero, PE_OUT_OF_RANGE the same as one too
+ * large, as strtod reports both. The caller's errno is left as it was.
+ *
+ * @param chars - The text, which doesn't need to be null terminated, as const char pointer.
+ * @param length - The length of the text as size_t.
+ *
+ * @return Returns the value, PE_INVALID with nothing consumed if there are
+ * no digits, or PE_OUT_OF_RANGE with HUGE_VAL if it's too large for a 
+ * double or with what strtod rounded it to if it's too small, as DoubleParse.
+ */
+DoubleParse ParseUtils::parseDouble(const char* chars, size_t length) {
+  static const double POWERS_OF_TEN[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+  DoubleParse result = {0.0, PE_INVALID, 0U};
+  size_t i = 0U;
+  bool isNegative = false;
+  if (i < length && (chars[i] == '-' || chars[i] == '+')) {
+    isNegative = (chars[i] == '-');
+    i++;
+  }
+
+  uint64_t mantissa = 0ULL;
+  int kept = 0; // Significant digits in mantissa
+  int exponent = 0;
+  bool hasDigits = false;
+  bool isTruncated = false;
+  bool isFraction = false;
+  for (; i < length; i++) { // Digits either side of the '.'...
+    char c = chars[i];
+    if (c == '.' && !isFraction) {
+      isFraction = true;
+      continue;
+    }
+    if (c < '0' || c > '9') {
+      break;
+    }
+    hasDigits = true;
+    if (kept < 19) {
+      mantissa = (mantissa * 10ULL) + (uint64_t)(c - '0');
+      kept += (mantissa != 0ULL) ? 1 : 0;
+      exponent -= isFraction ? 1 : 0;
+    } else {
+      isTruncated = isTruncated || (c != '0');
+      exponent += isFraction ? 0 : 1;
     }
+  }
+  if (!hasDigits) { // Nothing but a sign or '.'...
 
-    if (period == 1) { // Number is a float type...
-      // lose percision...
-      std::string temp = substring(str, 0, str.find('.'));
-      if (temp.empty()) {
+    return result;
+  }
 
-        return 0;
+  size_t digitsEnd = i;
+  int explicitExponent = 0;
+  if (i < length && (chars[i] == 'e' || chars[i] == 'E')) { // Exponent only counts if it has digits...
+    size_t j = i + 1U;
+    bool isExpNegative = false;
+    if (j < length && (chars[j] == '-' || chars[j] == '+')) {
+      isExpNegative = (chars[j] == '-');
+      j++;
+    }
+    if (j < length && chars[j] >= '0' && chars[j] <= '9') {
+      int expValue = 0;
+      for (; j < length && chars[j] >= '0' && chars[j] <= '9'; j++) {
+        if (expValue < 100000) {
+          expValue = (expValue * 10) + (chars[j] - '0');
+        }
       }
-
-      return std::stoi(temp);
+      explicitExponent = isExpNegative ? -expValue : expValue;
+      exponent += explicitExponent;
+      i = j;
     }
   }
+  result.consumed = i;
+
+  double value = 0.0;
+  int callerErrno = errno;
+  errno = 0;
+  if (!isTruncated && mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22) { // Exact...
+    value = (exponent < 0) ? ((double)mantissa / POWERS_OF_TEN[-exponent]) : ((double)mantissa * POWERS_OF_TEN[exponent]);
+    value = isNegative ? -value : value;
+  } else if (i < 64U) { // Let strtod do the rounding...
+    char buffer[64];
+    memcpy(buffer, chars, i);
+    buffer[i] = '\0';
+    value = strtod(buffer, nullptr);
+  } else { // Too long for the buffer, hand strtod the leading significant digits instead...
+    char buffer[64]; // Sign, 40 digits, sticky digit, 'e' and exponent
+    size_t n = 0U;
+    int shift = 0; // Moves the '.' to just after the digits kept
+    bool isSignificant = false;
+    bool isDropped = false;
+    isFraction = false;
+    if (isNegative) {
+      buffer[n++] = '-';
+    }
+    for (size_t j = ((chars[0] == '-' || chars[0] == '+') ? 1U : 0U); j < digitsEnd; j++) {
+      char c = chars[j];
+      if (c == '.') {
+        isFraction = true;
+        continue;
+      }
+      isSignificant = isSignificant || (c != '0');
+      if (!isSignificant) { // Leading zeros only move the '.'...
+        shift -= isFraction ? 1 : 0;
+      } else if (n < (isNegative ? 41U : 40U)) {
+        buffer[n++] = c;
+        shift -= isFraction ? 1 : 0;
+      } else {
+        isDropped = isDropped || (c != '0');
+        shift += isFraction ? 0 : 1;
+      }
+    }
+    if (!isSignificant) {
+      buffer[n++] = '0';
+    }
+    if (isDropped) { // Stands in for the dropped digits so they still round up...
+      buffer[n++] = '1';
+      shift--;
+    }
+    n += sprintf(buffer + n, "e%d", shift + explicitExponent);
+    value = strtod(buffer, nullptr);
+  }
+
+  result.value = value;
+  result.error = (errno == ERANGE) ? PE_OUT_OF_RANGE : PE_OK; // Overflow or underflow...
+  errno = callerErrno;
 
-  return std::stoi(str);
+  return result;
 }
 
 /**
@@ -431,32 +628,13 @@ int ParseUtils::toInt(std::string str) {
  *
  * @param hex - The hex string to perform conversion on as String.
  *
- * @return Returns the hex value as an unsigned int.
- */
-unsigned int ParseUtils::hexStringToInt(String hex) {
-  unsigned int result = 0;
-  for (unsigned int i = 0; i < hex.length(); i++) {
-    char c = hex.charAt(i);
-    unsigned int temp = c - '0';
-    if (temp >= 0 && temp <= 9) { // is a number digit...
-      result += (temp * pow(16,(hex.length() - i - 1)));
-    } else { // Could be a letter digit...
-      temp = c - 'A' + 10;
-      if (temp >= 0xA && temp <= 0xF) { // was a capital letter digit of proper value...
-        result += (temp * pow(16,(hex.length() - i - 1)));      
-      } else { // could be a lowercase letter digit...
-        temp = c - 'a' + 10;
-        if (temp >= 0xA && temp <= 0xF) { // was a lowercase letter digit of proper value...
-          result += (temp * pow(16,(hex.length() - i - 1)));      
-        } else { // Seems to not be a valid hex string...
-
-          return 0; // because value is jacked up no matter what
-        }
-      }
-    }
-  }
+ * @return Returns the hex value as an unsigned int, or 0 if it isn't a
+ * valid hex string or is too large for one.
+ */
+unsigned int ParseUtils::hexStringToInt(const String &hex) {
+  uint32_t result = 0UL;
 
-  return result;
+  return parseHex(hex.c_str(), hex.length(), result) ? (unsigned int)result : 0U;
 }
 
 /**
@@ -471,32 +649,74 @@ unsigned int ParseUtils::hexStringToInt(String hex) {
  *
  * @param hex - The hex string to perform conversion on, as std::string.
  *
- * @return Returns the hex value as an unsigned int.
- */
-unsigned int ParseUtils::hexStringToInt(std::string hex) {
-  unsigned int result = 0;
-  for (unsigned int i = 0; i < hex.length(); i++) {
-    char c = hex.at(i);
-    unsigned int temp = c - '0';
-    if (temp >= 0 && temp <= 9) { // is a number digit...
-      result += (temp * pow(16,(hex.length() - i - 1)));
-    } else { // Could be a letter digit...
-      temp = c - 'A' + 10;
-      if (temp >= 0xA && temp <= 0xF) { // was a capital letter digit of proper value...
-        result += (temp * pow(16,(hex.length() - i - 1)));      
-      } else { // could be a lowercase letter digit...
-        temp = c - 'a' + 10;
-        if (temp >= 0xA && temp <= 0xF) { // was a lowercase letter digit of proper value...
-          result += (temp * pow(16,(hex.length() - i - 1)));      
-        } else { // Seems to not be a valid hex string...
-
-          return 0; // because value is jacked up no matter what
-        }
-      }
+ * @return Returns the hex value as an unsigned int, or 0 if it isn't a
+ * valid hex string or is too large for one.
+ */
+unsigned int ParseUtils::hexStringToInt(const std::string &hex) {
+  uint32_t result = 0UL;
+
+  return parseHex(hex.data(), hex.length(), result) ? (unsigned int)result : 0U;
+}
+
+/**
+ * Parses hex digits into a value, a nibble at a time through HEX_NIBBLES.
+ * Every character must be a hex digit, in either case, and the value must
+ * fit in 32 bits, though leading zeros are fine.
+ *
+ * @param chars - The hex digits, which don't need to be null terminated, as const char pointer.
+ * @param length - The number of digits as size_t.
+ * @param value - Set to the parsed value when successful as uint32_t.
+ *
+ * @return Returns true if successful, or false if there are no digits, a
+ * character isn't a hex digit or the value overflows, as bool.
+ */
+bool ParseUtils::parseHex(const char* chars, size_t length, uint32_t &value) {
+  if (length == 0U) {
+
+    return false;
+  }
+
+  uint32_t result = 0UL;
+  for (size_t i = 0U; i < length; i++) {
+    uint8_t nibble = pgm_read_byte(&HEX_NIBBLES[(uint8_t)chars[i]]);
+    if (nibble > 15U || (result >> 28) != 0UL) { // Not a digit or no room for another...
+
+      return false;
     }
+    result = (result << 4) | nibble;
   }
+  value = result;
 
-  return result;
+  return true;
+}
+
+/**
+ * @param c - The character of a hex digit as char.
+ *
+ * @return Returns the value of the hex digit, or -1 if the character 
+ * isn't one, as int.
+ */
+int ParseUtils::hexNibble(char c) {
+  uint8_t nibble = pgm_read_byte(&HEX_NIBBLES[(uint8_t)c]);
+
+  return (nibble > 15U) ? -1 : (int)nibble;
+}
+
+/**
+ * Decodes a pair of hex digits, such as the two following the '%' of an
+ * escape in a URL, into the byte they stand for. Both digits are looked up
+ * and checked together, so there is a single branch for the pair.
+ *
+ * @param chars - The two hex digits, high then low, as const char pointer.
+ *
+ * @return Returns the byte, or -1 if either character isn't a hex digit,
+ * as int.
+ */
+int ParseUtils::decodeHexPair(const char* chars) {
+  uint8_t high = pgm_read_byte(&HEX_NIBBLES[(uint8_t)chars[0]]);
+  uint8_t low = pgm_read_byte(&HEX_NIBBLES[(uint8_t)chars[1]]);
+
+  return ((high | low) > 15U) ? -1 : (int)((high << 4) | low);
 }
 
 /**
@@ -684,97 +904,73 @@ unsigned int ParseUtils::countConsecutiveRepeatingChars(std::string &str, unsign
 }
 
 /**
- * Decodes a URL encoded string.
+ * Decodes a URL encoded string, in place, in a single pass. Every %XX 
+ * escape is decoded as well as '+' to a space. Since each escape is decoded
+ * only once, a decoded '%' is never mistaken for the start of another 
+ * escape. A '%' not followed by two hex digits is left as is.
  *
  * @param str The string to decode as String. 
+ * 
+ * @return Returns the decoded string as String.
  */
 String ParseUtils::decodeUrlString(String &str) {
-  str.replace("%20", " ");
-  str.replace("%21", "!");
-  str.replace("%23", "#");
-  str.replace("%24", "$");
-  str.replace("%26", "&");
-  str.replace("%27", "'");
-  str.replace("%28", "(");
-  str.replace("%29", ")");
-  str.replace("%2A", "*");
-  str.replace("+", " ");
-  str.replace("%2B", "+");
-  str.replace("%2C", ",");
-  str.replace("%2F", "/");
-  str.replace("%3A", ":");
-  str.replace("%3B", ";");
-  str.replace("%3D", "=");
-  str.replace("%3F", "?");
-  str.replace("%40", "@");
-  str.replace("%5B", "[");
-  str.replace("%2D", "]");
-  str.replace("%22", "\"");
-  str.replace("%25", "%");
-  str.replace("%2D", "-");
-  str.replace("%2E", ".");
-  str.replace("%3C", "<");
-  str.replace("%3E", ">");
-  str.replace("%5C", "\\");
-  str.replace("%5E", "^");
-  str.replace("%5F", "_");
-  str.replace("%60", "`");
-  str.replace("%7B", "{");
-  str.replace("%7C", "|");
-  str.replace("%7D", "}");
-  str.replace("%7E", "~");
+  size_t length = decodeUrl(str.begin(), str.length());
+  str.remove(length);
 
   return str;
 }
 
 /**
- * Decodes a URL encoded string.
+ * Decodes a URL encoded string, in place, in a single pass. Every %XX 
+ * escape is decoded as well as '+' to a space. Since each escape is decoded
+ * only once, a decoded '%' is never mistaken for the start of another 
+ * escape. A '%' not followed by two hex digits is left as is.
  *
  * @param str - The string to decode as std::string. 
+ * 
+ * @return Returns the decoded string as std::string.
  */
 std::string ParseUtils::decodeUrlString(std::string &str) {
-  replace(str, "%20", " ");
-  replace(str, "%21", "!");
-  replace(str, "%23", "#");
-  replace(str, "%24", "$");
-  replace(str, "%26", "&");
-  replace(str, "%27", "'");
-  replace(str, "%28", "(");
-  replace(str, "%29", ")");
-  replace(str, "%2A", "*");
-  replace(str, "+", " ");
-  replace(str, "%2B", "+");
-  replace(str, "%2C", ",");
-  replace(str, "%2F", "/");
-  replace(str, "%3A", ":");
-  replace(str, "%3B", ";");
-  replace(str, "%3D", "=");
-  replace(str, "%3F", "?");
-  replace(str, "%40", "@");
-  replace(str, "%5B", "[");
-  replace(str, "%2D", "]");
-  replace(str, "%22", "\"");
-  replace(str, "%25", "%");
-  replace(str, "%2D", "-");
-  replace(str, "%2E", ".");
-  replace(str, "%3C", "<");
-  replace(str, "%3E", ">");
-  replace(str, "%5C", "\\");
-  replace(str, "%5E", "^");
-  replace(str, "%5F", "_");
-  replace(str, "%60", "`");
-  replace(str, "%7B", "{");
-  replace(str, "%7C", "|");
-  replace(str, "%7D", "}");
-  replace(str, "%7E", "~");
+  size_t length = decodeUrl(&str[0], str.length());
+  str.resize(length);
 
   return str;
 }
 
+/**
+ * Decodes URL encoded characters in place. The decoded text is never 
+ * longer than the encoded text, so it is written over the encoded text 
+ * as it is read and nothing is allocated.
+ *
+ * @param chars - The characters to decode as char*.
+ * @param length - The number of characters as size_t.
+ *
+ * @return Returns the number of characters after decoding as size_t.
+ */
+size_t ParseUtils::decodeUrl(char* chars, size_t length) {
+  size_t out = 0U;
+  for (size_t in = 0U; in < length; in++) {
+    char c = chars[in];
+    if (c == '+') {
+      c = ' ';
+    } else if (c == '%' && (in + 2U) < length) {
+      int decoded = decodeHexPair(chars + in + 1U);
+      if (decoded >= 0) {
+        c = (char)decoded;
+        in += 2U;
+      }
+    }
+    chars[out++] = c;
+  }
+
+  return out;
+}
+
 /**
  * Used to replace a specified string of characters from within a given string, with another
  * string of characters. This supports the replaceWith string being larger than the string 
- * being replaced as specified with the 'find' string.
+ * being replaced as specified with the 'find' string. The matches are counted first so the
+ * result is allocated once at its final size, then built in a single scan.
  *
  * @param str - The string containing the string to be replaced as std::string.
  * @param find - The string to find for replacement as std::string.
@@ -782,20 +978,131 @@ std::string ParseUtils::decodeUrlString(std::string &str) {
  *
  * @return Returns the resulting string as std::string. 
  */
-std::string ParseUtils::replace(std::string &str, std::string find, std::string replaceWith) {
-  std::string result = "";
-  int fCount = occurrences(str, find);
-  int trailIndex = 0;
-  int leadIndex = 0;
-  for (int i = 0; i < fCount; i++) {
-    leadIndex = str.find(find);
-    result += substring(str, trailIndex, leadIndex) + replaceWith;
-    trailIndex = leadIndex + find.length();
+std::string ParseUtils::replace(std::string &str, const std::string &find, const std::string &replaceWith) {
+  unsigned int count = countMatches(str.data(), str.length(), find.data(), find.length());
+  if (count == 0U) {
+
+    return str;
+  }
+
+  std::string result;
+  result.reserve(str.length() - (count * find.length()) + (count * replaceWith.length()));
+  const char* text = str.data();
+  const char* end = text + str.length();
+  const char* match;
+  while ((match = findMatch(text, end - text, find.data(), find.length())) != nullptr) {
+    result.append(text, match - text);
+    result.append(replaceWith);
+    text = match + find.length();
   }
+  result.append(text, end - text);
 
   return result;
 }
 
+/**
+ * Does the same as replace but changes the given string itself. When the
+ * replaceWith string isn't longer than the 'find' string the result can't 
+ * outgrow the original, so it is written over the original in a single 
+ * scan without allocating anything.
+ *
+ * @param str - The string in which to replace as std::string.
+ * @param find - The string to find for replacement as std::string.
+ * @param replaceWith - The string to replace the found string with as std::string.
+ */
+void ParseUtils::replaceInPlace(std::string &str, const std::string &find, const std::string &replaceWith) {
+  if (find.empty()) {
+
+    return;
+  }
+  if (replaceWith.length() > find.length()) {
+    str = replace(str, find, replaceWith);
+
+    return;
+  }
+
+  char* chars = &str[0];
+  const char* text = chars;
+  const char* end = chars + str.length();
+  size_t out = 0U;
+  const char* match;
+  while ((match = findMatch(text, end - text, find.data(), find.length())) != nullptr) {
+    memmove(chars + out, text, match - text);
+    out += match - text;
+    memcpy(chars + out, replaceWith.data(), replaceWith.length());
+    out += replaceWith.length();
+    text = match + find.length();
+  }
+  memmove(chars + out, text, end - text);
+  out += end - text;
+  str.resize(out);
+}
+
+/**
+ * Counts the occurrences of a pattern within some text, without overlap.
+ *
+ * @param text - The text to search as const char*.
+ * @param textLength - The length of the text as size_t.
+ * @param pattern - The pattern to count as const char*.
+ * @param patternLength - The length of the pattern as size_t.
+ *
+ * @return Returns the number of occurrences, or 0 for an empty pattern, as unsigned int.
+ */
+unsigned int ParseUtils::countMatches(const char* text, size_t textLength, const char* pattern, size_t patternLength) {
+  if (patternLength == 0U || patternLength > textLength) {
+
+    return 0U;
+  }
+
+  const char* end = text + textLength;
+  unsigned int count = 0U;
+  const char* match;
+  while ((match = findMatch(text, end - text, pattern, patternLength)) != nullptr) {
+    count ++;
+    text = match + patternLength;
+  }
+
+  return count;
+}
+
+/**
+ * Finds the first occurrence of a pattern within some text, the way 
+ * std::string::find does. memchr looks for the first character of the 
+ * pattern and memcmp checks the rest wherever it is found. For the short 
+ * patterns searched for here this beats building a skip table, which took
+ * 256 bytes of stack on every search for no gain over the memchr scan.
+ *
+ * @param text - The text to search as const char*.
+ * @param textLength - The length of the text as size_t.
+ * @param pattern - The pattern to find as const char*.
+ * @param patternLength - The length of the pattern, at least 1, as size_t.
+ *
+ * @return Returns where the pattern starts in the text or nullptr if it wasn't
+ * found as const char*.
+ */
+const char* ParseUtils::findMatch(const char* text, size_t textLength, const char* pattern, size_t patternLength) {
+  if (patternLength > textLength) {
+
+    return nullptr;
+  }
+
+  const char* last = text + (textLength - patternLength); // Last place the pattern can start...
+  while (text <= last) {
+    text = (const char*)memchr(text, pattern[0], (last - text) + 1U);
+    if (text == nullptr) {
+
+      return nullptr;
+    }
+    if (memcmp(text + 1, pattern + 1, patternLength - 1U) == 0) {
+
+      return text;
+    }
+    text ++;
+  }
+
+  return nullptr;
+}
+
 /**
  * This is used to tell if the given string is a valid Dot Notation
  * IP Address. If it is valid then true is returned otherwise false
@@ -806,15 +1113,14 @@ std::string ParseUtils::replace(std::string &str, std::string find, std::string
  * @return Returns the result as bool.
  */
 bool ParseUtils::validDotNotationIp(String &str) {
-  if (occurrences(str, '.') != 3) { // Not valid IPv4 dot notation because not 3 separators...
+  IPv4Parse ip = IpUtils::parseIPv4(str.c_str(), str.length());
+  if (!ip.isValid) { // Not valid IPv4 dot notation...
 
     return false;
   }
 
-  String octets[4] = {""};
-  split(str, '.', octets, sizeof(octets));
   for (int i = 0; i < 4; i++) { // Iterate and verify octet values...
-    int oct = octets[i].toInt();
+    int oct = (int)((ip.address >> (24 - (i * 8))) & 255UL);
     switch (i) {
       case 0:
         if (oct < 1 || oct > 223) {
@@ -832,4 +1138,163 @@ bool ParseUtils::validDotNotationIp(String &str) {
   }
 
   return true;
-}
\ No newline at end of file
+}
+
+/**
+ * This is used to tell if the given text looks like a valid email address,
+ * being a name, an '@' and then a domain of at least two parts separated by
+ * '.' characters. This doesn't accept every address the standard allows,
+ * such as quoted names, but does accept the ones used in practice. The text
+ * doesn't need to be null terminated.
+ *
+ * @param chars - The text to validate as const char pointer.
+ * @param length - The length of the text as size_t.
+ *
+ * @return Returns the result as bool.
+ */
+bool ParseUtils::validEmailAddress(const char* chars, size_t length) {
+  const char* at = (const char*)memchr(chars, '@', length);
+  if (at == nullptr || at == chars || (at - chars) > 64 || length > 254U) { // No name or too long...
+
+    return false;
+  }
+  for (const char* c = chars; c < at; c++) { // Check characters of the name...
+    if ((unsigned char)*c <= ' ' || (unsigned char)*c >= 0x7F || strchr("\"(),:;<>[\\]", *c) != nullptr) {
+
+      return false;
+    }
+  }
+
+  const char* domain = at + 1;
+  const char* end = chars + length;
+  bool hasDot = false;
+  for (const char* c = domain; c < end; c++) { // Check the domain one part at a time...
+    if (*c == '.') {
+      if (c == domain || *(c - 1) == '.' || *(c - 1) == '-' || (c + 1) == end || *(c + 1) == '-') { // Empty part or part edged by '-'...
+
+        return false;
+      }
+      hasDot = true;
+    } else if (!isalnum((unsigned char)*c) && *c != '-') {
+
+      return false;
+    }
+  }
+
+  return (hasDot && *domain != '-' && *(end - 1) != '-');
+}
+
+/*
+=================================================================
+TokenIterator
+=================================================================
+*/
+
+/**
+ * #### CLASS CONSTRUCTOR ####
+ *
+ * @param chars - The characters to walk through, which don't need to be
+ * null terminated, as const char pointer.
+ * @param length - The number of characters to walk through as size_t.
+ * @param separator - The character which separates the tokens as char.
+ */
+TokenIterator::TokenIterator(const char* chars, size_t length, char separator) {
+  this->cursor = chars;
+  this->end = chars + length;
+  this->separator = separator;
+}
+
+/**
+ * Moves on to the next token which isn't empty once trimmed of whitespace.
+ *
+ * @param token - Set to the trimmed token when one is found as TextSlice.
+ *
+ * @return Returns true if a token was found or false if there are no more
+ * as bool.
+ */
+bool TokenIterator::next(TextSlice &token) {
+  while (cursor < end) {
+    const char* last = (const char*)memchr(cursor, separator, end - cursor);
+    if (last == nullptr) {
+      last = end;
+    }
+    const char* first = cursor;
+    cursor = (last == end) ? end : (last + 1);
+
+    while (first < last && (unsigned char)*first <= ' ') { // Trim leading...
+      first++;
+    }
+    while (last > first && (unsigned char)*(last - 1) <= ' ') { // Trim trailing...
+      last--;
+    }
+    if (first != last) { // Not an empty token...
+      token.chars = first;
+      token.length = last - first;
+
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Checks whether an Accept-Encoding header accepts the given content coding.
+ * The header is a ',' separated list of codings, each with an optional 
+ * ";q=" weight from 0 to 1, where a weight of 0 means not acceptable. The
+ * coding's own entry decides it, otherwise a "*" entry does, otherwise it
+ * isn't accepted. Names are compared without regard to case.
+ * 
+ * For Example:
+ * "gzip, deflate" and "br;q=1, *;q=0.5" accept gzip, where "gzip;q=0" and
+ * "identity" don't.
+ *
+ * @param chars - The header value, which doesn't need to be null terminated, as const char pointer.
+ * @param length - The length of the header value as size_t.
+ * @param coding - The coding to check for, such as "gzip", as const char pointer.
+ *
+ * @return Returns true if the coding is acceptable as bool.
+ */
+bool ParseUtils::acceptsEncoding(const char* chars, size_t length, const char* coding) {
+  size_t codingLength = strlen(coding);
+  int codingAccepted = -1; // -1 when not listed, otherwise 0 or 1
+  int anyAccepted = -1;
+  TokenIterator entries(chars, length, ',');
+  TextSlice entry;
+  while (entries.next(entry)) {
+    TokenIterator parts(entry.chars, entry.length, ';');
+    TextSlice name;
+    if (!parts.next(name)) {
+      continue;
+    }
+
+    bool isAccepted = true;
+    TextSlice param;
+    while (parts.next(param)) { // Only the weight matters...
+      if (param.length < 2U || tolower(param.chars[0]) != 'q') {
+        continue;
+      }
+      size_t i = 1U;
+      while (i < param.length && isspace(param.chars[i])) {
+        i++;
+      }
+      if (i >= param.length || param.chars[i] != '=') {
+        continue;
+      }
+      i++;
+      while (i < param.length && isspace(param.chars[i])) {
+        i++;
+      }
+      DoubleParse weight = parseDouble(param.chars + i, param.length - i);
+      isAccepted = (weight.error == PE_OK && weight.value > 0.0);
+    }
+
+    if (name.length == codingLength && strncasecmp(name.chars, coding, codingLength) == 0) {
+      codingAccepted = isAccepted ? 1 : 0;
+    } else if (name.length == 1U && name.chars[0] == '*') {
+      anyAccepted = isAccepted ? 1 : 0;
+    }
+  }
+
+  return (codingAccepted != -1) ? (codingAccepted == 1) : (anyAccepted == 1);
+}
@@ -12,13 +12,73 @@
 
 #include <WString.h>
 #include <string>
+#include <string.h>
 #include <math.h>
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <pgmspace.h>
+
+// *****************************************************************************
+// A piece of a string which points into it rather than being copied out of it.
+// The characters are NOT null terminated, so length must always be used.
+// *****************************************************************************
+struct TextSlice {
+    const char*    chars                       ;
+    size_t         length                      ;
+};
+
+// *****************************************************************************
+// Walks through the separated tokens of a string without copying them. Each
+// token is trimmed of whitespace and empty tokens are skipped. The string must
+// stay unchanged while it is being walked through.
+// *****************************************************************************
+class TokenIterator {
+    private:
+        const char* cursor;
+        const char* end;
+        char separator;
+
+    public:
+        TokenIterator(const char* chars, size_t length, char separator);
+
+        bool next(TextSlice &token);
+};
+
+// *****************************************************************************
+// Result of parsing a number from the start of some text. Parsing stops at the
+// first character which can't be part of the number, and consumed says how
+// many characters were used so the caller can decide what may follow.
+// *****************************************************************************
+enum ParseError {
+    PE_OK,
+    PE_INVALID, // No number at the start of the text, nothing consumed
+    PE_OUT_OF_RANGE // Doesn't fit, value is clamped the same as strtol/strtod
+};
+
+struct LongParse {
+    long           value                       ;
+    ParseError     error                       ;
+    size_t         consumed                    ;
+};
+
+struct DoubleParse {
+    double         value                       ;
+    ParseError     error                       ;
+    size_t         consumed                    ;
+};
 
 class ParseUtils {
     private:
         ParseUtils();
 
+        static const char* findMatch(const char* text, size_t textLength, const char* pattern, size_t patternLength);
+
     public:
+        static bool acceptsEncoding(const char* chars, size_t length, const char* coding);
+
         static String arrangeDigitsUsingPattern(String inputString, String inputPattern, String desiredPattern);
         static std::string arrangeDigitsUsingPattern(std::string inputString, std::string inputPattern, std::string desiredPattern);
 
@@ -27,9 +87,13 @@ class ParseUtils {
 
         static String decodeUrlString(String &str);
         static std::string decodeUrlString(std::string &str);
+        static size_t decodeUrl(char* chars, size_t length);
         
-        static unsigned int hexStringToInt(String hex);
-        static unsigned int hexStringToInt(std::string hex);
+        static unsigned int hexStringToInt(const String &hex);
+        static unsigned int hexStringToInt(const std::string &hex);
+        static bool parseHex(const char* chars, size_t length, uint32_t &value);
+        static int hexNibble(char c);
+        static int decodeHexPair(const char* chars);
 
         static unsigned int occurrences(String &str, char toCnt);
         static unsigned int occurrences(std::string &str, char toCnt);
@@ -39,19 +103,26 @@ class ParseUtils {
         static String parseByKeyword(String &str, String keyword, String terminator);
         static std::string parseByKeyword(std::string &str, std::string keyword, std::string terminator);
 
-        static std::string replace(std::string &str, std::string find, std::string replaceWith);
+        static std::string replace(std::string &str, const std::string &find, const std::string &replaceWith);
+        static void replaceInPlace(std::string &str, const std::string &find, const std::string &replaceWith);
+        static unsigned int countMatches(const char* text, size_t textLength, const char* pattern, size_t patternLength);
 
         static void split(String &str, char separator, String *storage, unsigned int sizeOfStorage);
         static void split(std::string &str, char separator, std::string *storage, unsigned int sizeOfStorage);
+        static TokenIterator tokenize(const String &str, char separator);
+        static TokenIterator tokenize(const std::string &str, char separator);
         static std::string substring(std::string &str, unsigned int beginIndex, unsigned int endIndex);
         static std::string substring(std::string &str, unsigned int beginIndex);
 
-        static int toInt(std::string str);
-        static float toFloat(std::string str);
-        static double toDouble(std::string str);
+        static int toInt(const std::string &str);
+        static float toFloat(const std::string &str);
+        static double toDouble(const std::string &str);
+        static LongParse parseLong(const char* chars, size_t length);
+        static DoubleParse parseDouble(const char* chars, size_t length);
         static std::string trim(std::string &str);
         static String trunc(String &str, unsigned int length);
         
         static bool validDotNotationIp(String &str);
+        static bool validEmailAddress(const char* chars, size_t length);
 };
 #endif
\ No newline at end of file
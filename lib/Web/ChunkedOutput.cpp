@@ -0,0 +1,129 @@
+/*
+ * ChunkedOutput - A Print which collects what is written to it in a small
+ * fixed buffer and hands it off in chunks.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include "ChunkedOutput.h"
+
+/**
+ * #### CLASS CONSTRUCTOR ####
+ *
+ * @param sink The function each full chunk is handed to as ChunkSink.
+*/
+ChunkedOutput::ChunkedOutput(ChunkSink sink) {
+    this->sink = sink;
+}
+
+/**
+ * Writes a single byte, handing off the buffer once it is full.
+ *
+ * @return Returns the number of bytes written as size_t.
+*/
+size_t ChunkedOutput::write(uint8_t c) {
+    writeRaw(&c, 1U);
+
+    return 1U;
+}
+
+/**
+ * Writes the given bytes, handing off the buffer each time it fills.
+ *
+ * @return Returns the number of bytes written as size_t.
+*/
+size_t ChunkedOutput::write(const uint8_t* data, size_t length) {
+    writeRaw(data, length);
+
+    return length;
+}
+
+/**
+ * Writes a segment of a template kept in flash. Subclasses may send the
+ * given pre-compressed form of it instead.
+ *
+ * @param text The segment as PGM_P.
+ * @param length The length of the segment as uint16_t.
+ * @param deflated The segment pre-compressed, or null if there isn't one,
+ * as PGM_P.
+ * @param deflatedLength The length of the compressed segment as uint16_t.
+*/
+void ChunkedOutput::writeSegment(PGM_P text, uint16_t length, PGM_P deflated, uint16_t deflatedLength) {
+    (void)deflated;
+    (void)deflatedLength;
+    writeRaw_P(text, length);
+}
+
+/**
+ * Hands off whatever is in the buffer.
+*/
+void ChunkedOutput::flush() {
+    if (used > 0U) {
+        sink(buffer, used);
+        used = 0U;
+    }
+}
+
+/**
+ * Hands off whatever is in the buffer and then ends the output.
+*/
+void ChunkedOutput::end() {
+    flush();
+    sink(buffer, 0U);
+}
+
+/**
+ * @return Returns the number of bytes written so far as size_t.
+*/
+size_t ChunkedOutput::getTotal() {
+
+    return total;
+}
+
+/**
+ * #### PROTECTED ####
+ * Adds the given bytes to the buffer, handing off the buffer each time it
+ * fills. Subclasses use this to write bytes which shouldn't go through 
+ * their own write.
+*/
+void ChunkedOutput::writeRaw(const uint8_t* data, size_t length) {
+    size_t remaining = length;
+    while (remaining > 0U) {
+        size_t chunk = sizeof(buffer) - used;
+        if (chunk > remaining) {
+            chunk = remaining;
+        }
+        memcpy(buffer + used, data, chunk);
+        used += chunk;
+        data += chunk;
+        remaining -= chunk;
+        if (used == sizeof(buffer)) {
+            flush();
+        }
+    }
+    total += length;
+}
+
+/**
+ * #### PROTECTED ####
+ * Adds the given bytes kept in flash to the buffer, handing off the 
+ * buffer each time it fills.
+*/
+void ChunkedOutput::writeRaw_P(PGM_P data, size_t length) {
+    size_t remaining = length;
+    while (remaining > 0U) {
+        size_t chunk = sizeof(buffer) - used;
+        if (chunk > remaining) {
+            chunk = remaining;
+        }
+        memcpy_P(buffer + used, data, chunk);
+        used += chunk;
+        data += chunk;
+        remaining -= chunk;
+        if (used == sizeof(buffer)) {
+            flush();
+        }
+    }
+    total += length;
+}
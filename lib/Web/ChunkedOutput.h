@@ -0,0 +1,44 @@
+/*
+ * ChunkedOutput - A Print which collects what is written to it in a small
+ * fixed buffer and hands it off in chunks, such as to a web server sending
+ * a response with chunked transfer encoding. This lets a response of any
+ * size be produced using only the one small buffer.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef ChunkedOutput_h
+    #define ChunkedOutput_h
+
+    #include <Arduino.h>
+    #include <Print.h>
+
+    #define CHUNKED_OUTPUT_SIZE 256
+
+    typedef void (*ChunkSink)(const char* data, size_t length); // A length of 0 ends the output
+
+    class ChunkedOutput : public Print {
+        private:
+            ChunkSink sink;
+            char buffer[CHUNKED_OUTPUT_SIZE];
+            size_t used = 0U;
+            size_t total = 0U;
+
+        protected:
+            void writeRaw(const uint8_t* data, size_t length);
+            void writeRaw_P(PGM_P data, size_t length);
+
+        public:
+            ChunkedOutput(ChunkSink sink);
+
+            size_t write(uint8_t c) override;
+            size_t write(const uint8_t* data, size_t length) override;
+            void flush() override;
+            virtual void writeSegment(PGM_P text, uint16_t length, PGM_P deflated, uint16_t deflatedLength);
+            virtual void end();
+
+            size_t getTotal();
+    };
+
+#endif
@@ -0,0 +1,160 @@
+/*
+ * GzipOutput - A ChunkedOutput which sends what is written to it as a gzip
+ * stream, without doing any compression on the device.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include "GzipOutput.h"
+
+/**
+ * #### CLASS CONSTRUCTOR ####
+ *
+ * @param sink The function each full chunk is handed to as ChunkSink.
+*/
+GzipOutput::GzipOutput(ChunkSink sink) : ChunkedOutput(sink) {
+}
+
+/**
+ * Writes a single uncompressed byte.
+ *
+ * @return Returns the number of bytes written as size_t.
+*/
+size_t GzipOutput::write(uint8_t c) {
+
+    return write(&c, 1U);
+}
+
+/**
+ * Writes the given uncompressed bytes, which are sent in stored blocks.
+ *
+ * @return Returns the number of bytes written as size_t.
+*/
+size_t GzipOutput::write(const uint8_t* data, size_t length) {
+    start();
+    crc = CrcUtils::crc32Update(crc, data, length);
+    size += length;
+
+    size_t remaining = length;
+    while (remaining > 0U) {
+        size_t chunk = sizeof(pending) - pendingUsed;
+        if (chunk > remaining) {
+            chunk = remaining;
+        }
+        memcpy(pending + pendingUsed, data, chunk);
+        pendingUsed += chunk;
+        data += chunk;
+        remaining -= chunk;
+        if (pendingUsed == sizeof(pending)) {
+            flushStored();
+        }
+    }
+
+    return length;
+}
+
+/**
+ * Writes a segment of a template kept in flash. When there is a
+ * compressed form of it, that is sent as is, otherwise the segment is
+ * sent in stored blocks.
+ *
+ * @param text The segment as PGM_P.
+ * @param length The length of the segment as uint16_t.
+ * @param deflated The segment as deflate blocks ending on a byte boundary,
+ * or null if there isn't one, as PGM_P.
+ * @param deflatedLength The length of the compressed segment as uint16_t.
+*/
+void GzipOutput::writeSegment(PGM_P text, uint16_t length, PGM_P deflated, uint16_t deflatedLength) {
+    uint8_t copy[32];
+    if (deflated == nullptr) { // Nothing compressed, send stored...
+        for (uint16_t done = 0U; done < length; ) {
+            size_t left = (size_t)(length - done);
+            uint16_t chunk = (left > sizeof(copy)) ? sizeof(copy) : left;
+            memcpy_P(copy, text + done, chunk);
+            write(copy, chunk);
+            done += chunk;
+        }
+
+        return;
+    }
+
+    start();
+    flushStored();
+    for (uint16_t done = 0U; done < length; ) { // Trailer still covers the uncompressed text...
+        size_t left = (size_t)(length - done);
+        uint16_t chunk = (left > sizeof(copy)) ? sizeof(copy) : left;
+        memcpy_P(copy, text + done, chunk);
+        crc = CrcUtils::crc32Update(crc, copy, chunk);
+        done += chunk;
+    }
+    size += length;
+    writeRaw_P(deflated, deflatedLength);
+}
+
+/**
+ * Ends the deflate stream with an empty final block, sends the gzip
+ * trailer and then ends the output.
+*/
+void GzipOutput::end() {
+    start();
+    flushStored();
+
+    uint32_t finalCrc = ~crc;
+    const uint8_t trailer[] = {
+        0x01, 0x00, 0x00, 0xFF, 0xFF, // Empty final stored block
+        (uint8_t)finalCrc, (uint8_t)(finalCrc >> 8), (uint8_t)(finalCrc >> 16), (uint8_t)(finalCrc >> 24),
+        (uint8_t)size, (uint8_t)(size >> 8), (uint8_t)(size >> 16), (uint8_t)(size >> 24)
+    };
+    writeRaw(trailer, sizeof(trailer));
+
+    ChunkedOutput::end();
+}
+
+/*
+=================================================================
+Private Functions
+=================================================================
+*/
+
+/**
+ * #### PRIVATE ####
+ * Sends the gzip header if it hasn't been sent yet.
+*/
+void GzipOutput::start() {
+    if (isStarted) {
+
+        return;
+    }
+    isStarted = true;
+
+    const uint8_t header[] = {
+        0x1F, 0x8B, // Magic
+        0x08, // Deflate
+        0x00, // No flags
+        0x00, 0x00, 0x00, 0x00, // No time
+        0x00, // No extra flags
+        0x03 // Unix
+    };
+    writeRaw(header, sizeof(header));
+}
+
+/**
+ * #### PRIVATE ####
+ * Sends the held uncompressed bytes as a stored block.
+*/
+void GzipOutput::flushStored() {
+    if (pendingUsed == 0U) {
+
+        return;
+    }
+
+    const uint8_t header[] = {
+        0x00, // Not final, stored
+        (uint8_t)pendingUsed, (uint8_t)(pendingUsed >> 8),
+        (uint8_t)~pendingUsed, (uint8_t)(~pendingUsed >> 8)
+    };
+    writeRaw(header, sizeof(header));
+    writeRaw(pending, pendingUsed);
+    pendingUsed = 0U;
+}
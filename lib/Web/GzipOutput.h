@@ -0,0 +1,42 @@
+/*
+ * GzipOutput - A ChunkedOutput which sends what is written to it as a gzip
+ * stream. Template segments which were compressed at build time are sent
+ * as their compressed deflate blocks straight out of flash, and everything
+ * else is sent in stored (uncompressed) deflate blocks, so no compression
+ * is done on the device. The CRC and size for the gzip trailer are worked
+ * out from the uncompressed text as it goes by.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef GzipOutput_h
+    #define GzipOutput_h
+
+    #include <Arduino.h>
+    #include <ChunkedOutput.h>
+    #include <CrcUtils.h>
+
+    #define GZIP_STORED_SIZE 200 // Most bytes held for a stored block
+
+    class GzipOutput : public ChunkedOutput {
+        private:
+            uint8_t pending[GZIP_STORED_SIZE];
+            uint16_t pendingUsed = 0U;
+            uint32_t crc = 0xFFFFFFFFUL;
+            uint32_t size = 0UL;
+            bool isStarted = false;
+
+            void start();
+            void flushStored();
+
+        public:
+            GzipOutput(ChunkSink sink);
+
+            size_t write(uint8_t c) override;
+            size_t write(const uint8_t* data, size_t length) override;
+            void writeSegment(PGM_P text, uint16_t length, PGM_P deflated, uint16_t deflatedLength) override;
+            void end() override;
+    };
+
+#endif
@@ -0,0 +1,140 @@
+/*
+ * HandshakeStats - Keeps count of the TLS handshakes done by the web server,
+ * how long they took and how the session cache did.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include "HandshakeStats.h"
+
+/**
+ * Sets the session store to watch for saves, which must be the one given
+ * to the server's ServerSessions.
+ *
+ * @param sessions The session store as ServerSession pointer.
+ * @param count The number of sessions in the store as uint32_t.
+*/
+void HandshakeStats::watch(const BearSSL::ServerSession* sessions, uint32_t count) {
+    this->sessions = sessions;
+    sessionCount = count;
+    savedCrc = crcOfSaved();
+}
+
+/**
+ * Marks the start of a call which accepts a waiting connection, which is
+ * where the time of its handshake is taken from.
+*/
+void HandshakeStats::beginAccept() {
+    acceptStart = millis();
+}
+
+/**
+ * Marks the end of a call started with beginAccept and records the
+ * handshake done during it. A session saved means a full handshake. A
+ * connection left open without one means a resumed handshake. Neither
+ * means the handshake failed, or the request was handled and closed in
+ * the same call, which can't be told apart, and nothing is recorded.
+ *
+ * @param isConnected Whether the server has the accepted connection open
+ * after the call as bool.
+ *
+ * @return Returns true if a handshake was recorded as bool.
+*/
+bool HandshakeStats::endAccept(bool isConnected) {
+    uint32_t crc = crcOfSaved();
+    bool isSaved = (crc != savedCrc);
+    savedCrc = crc;
+    if (!isSaved && !isConnected) { // Nothing to tell...
+
+        return false;
+    }
+
+    lastMs = millis() - acceptStart;
+    if (isSaved) { // Full handshake...
+        cacheMisses ++;
+        fullTotalMs += lastMs;
+    } else {
+        cacheHits ++;
+        resumedTotalMs += lastMs;
+    }
+    if (lastMs > slowestMs) {
+        slowestMs = lastMs;
+    }
+
+    return true;
+}
+
+/**
+ * @return Returns the time of the latest handshake in millis as unsigned long.
+*/
+unsigned long HandshakeStats::getLastMs() {
+
+    return lastMs;
+}
+
+/**
+ * @return Returns the number of handshakes which resumed a cached session
+ * as unsigned long.
+*/
+unsigned long HandshakeStats::getCacheHits() {
+
+    return cacheHits;
+}
+
+/**
+ * @return Returns the number of full handshakes, each of which saved a new
+ * session, as unsigned long.
+*/
+unsigned long HandshakeStats::getCacheMisses() {
+
+    return cacheMisses;
+}
+
+/**
+ * @return Returns the average time of a resumed handshake in millis as
+ * unsigned long.
+*/
+unsigned long HandshakeStats::getAverageResumedMs() {
+
+    return ((cacheHits == 0UL) ? 0UL : (resumedTotalMs / cacheHits));
+}
+
+/**
+ * @return Returns the average time of a full handshake in millis as
+ * unsigned long.
+*/
+unsigned long HandshakeStats::getAverageFullMs() {
+
+    return ((cacheMisses == 0UL) ? 0UL : (fullTotalMs / cacheMisses));
+}
+
+/**
+ * @return Returns the time of the slowest handshake in millis as unsigned long.
+*/
+unsigned long HandshakeStats::getSlowestMs() {
+
+    return slowestMs;
+}
+
+/*
+=================================================================
+Private Functions
+=================================================================
+*/
+
+/**
+ * #### PRIVATE ####
+ * Works out the CRC over the part of each session entry which is only
+ * written when a session is saved.
+ *
+ * @return Returns the CRC as uint32_t.
+*/
+uint32_t HandshakeStats::crcOfSaved() {
+    uint32_t crc = 0xFFFFFFFFUL;
+    for (uint32_t i = 0UL; i < sessionCount; i ++) {
+        crc = CrcUtils::crc32Update(crc, sessions[i], HANDSHAKE_SESSION_SAVED_SIZE);
+    }
+
+    return ~crc;
+}
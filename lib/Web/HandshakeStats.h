@@ -0,0 +1,66 @@
+/*
+ * HandshakeStats - Keeps count of the TLS handshakes done by the web server,
+ * how long they took and how the session cache did. Every handshake which
+ * completes is either a full one, which saves a new session into the cache,
+ * or one resuming a session found there. A full handshake is counted as a
+ * miss, whether the client offered a session that wasn't found or none at
+ * all, and a resumed one as a hit.
+ *
+ * Saves are told apart by watching the session store given to the server's
+ * ServerSessions. BearSSL's LRU cache keeps each session as an entry of
+ * HANDSHAKE_SESSION_ENTRY_SIZE bytes whose ID and master secret come first,
+ * which it only writes when it saves a session, as a hit only moves the
+ * links after them. So a CRC of those leading bytes changes with each save.
+ *
+ * The time is taken over the web server's handleClient call which accepted
+ * the connection. The handshake is done inside its accept, and the server
+ * gives no point between that and handling a request which came along with
+ * the handshake, so such a request is included in the time.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef HandshakeStats_h
+    #define HandshakeStats_h
+
+    #include <Arduino.h>
+    #include <BearSSLHelpers.h>
+    #include <CrcUtils.h>
+
+    #define HANDSHAKE_SESSION_ENTRY_SIZE 100 // Bytes per session of BearSSL's LRU cache
+    #define HANDSHAKE_SESSION_SAVED_SIZE 80 // Session ID and master secret, written only on save
+
+    static_assert(sizeof(BearSSL::ServerSession) == HANDSHAKE_SESSION_ENTRY_SIZE, "Session entries are not laid out as expected!");
+
+    class HandshakeStats {
+        private:
+            const BearSSL::ServerSession* sessions = nullptr;
+            uint32_t sessionCount = 0UL;
+            uint32_t savedCrc = 0UL;
+
+            unsigned long acceptStart = 0UL;
+            unsigned long lastMs = 0UL;
+
+            unsigned long cacheHits = 0UL;
+            unsigned long cacheMisses = 0UL;
+            unsigned long resumedTotalMs = 0UL;
+            unsigned long fullTotalMs = 0UL;
+            unsigned long slowestMs = 0UL;
+
+            uint32_t crcOfSaved();
+
+        public:
+            void watch(const BearSSL::ServerSession* sessions, uint32_t count);
+            void beginAccept();
+            bool endAccept(bool isConnected);
+
+            unsigned long getLastMs();
+            unsigned long getCacheHits();
+            unsigned long getCacheMisses();
+            unsigned long getAverageResumedMs();
+            unsigned long getAverageFullMs();
+            unsigned long getSlowestMs();
+    };
+
+#endif
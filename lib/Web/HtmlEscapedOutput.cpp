@@ -0,0 +1,82 @@
+/*
+ * HtmlEscapedOutput - A Print which escapes what is written to it for use
+ * as HTML text and passes it on to another Print.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include "HtmlEscapedOutput.h"
+
+/**
+ * #### CLASS CONSTRUCTOR ####
+ *
+ * @param out Where the escaped text is written, which must outlive this
+ * object, as Print.
+*/
+HtmlEscapedOutput::HtmlEscapedOutput(Print &out) {
+    this->out = &out;
+}
+
+/**
+ * Writes a single byte, escaped if needed.
+ *
+ * @return Returns the number of bytes written as size_t.
+*/
+size_t HtmlEscapedOutput::write(uint8_t c) {
+
+    return write(&c, 1U);
+}
+
+/**
+ * Writes the given bytes, passing runs that need no escaping on as they
+ * are and writing an entity in place of each byte that does.
+ *
+ * @return Returns the number of bytes written as size_t.
+*/
+size_t HtmlEscapedOutput::write(const uint8_t* data, size_t length) {
+    size_t runStart = 0U;
+    for (size_t i = 0U; i < length; i ++) {
+        const __FlashStringHelper* entity = entityOf(data[i]);
+        if (entity != nullptr) {
+            if (i > runStart) {
+                out->write(data + runStart, i - runStart);
+            }
+            out->print(entity);
+            runStart = i + 1U;
+        }
+    }
+    if (length > runStart) {
+        out->write(data + runStart, length - runStart);
+    }
+
+    return length;
+}
+
+/*
+=================================================================
+Private Functions
+=================================================================
+*/
+
+/**
+ * #### PRIVATE ####
+ * @return Returns the entity to write in place of the given byte, or
+ * nullptr if it needs no escaping, as const __FlashStringHelper*.
+*/
+const __FlashStringHelper* HtmlEscapedOutput::entityOf(uint8_t c) {
+    switch (c) {
+        case '&':
+            return F("&amp;");
+        case '<':
+            return F("&lt;");
+        case '>':
+            return F("&gt;");
+        case '"':
+            return F("&quot;");
+        case '\'':
+            return F("&#39;");
+        default:
+            return nullptr;
+    }
+}
@@ -0,0 +1,30 @@
+/*
+ * HtmlEscapedOutput - A Print which escapes what is written to it for use
+ * as HTML text and passes it on to another Print. This lets text such as
+ * the settings JSON be streamed into a page, as it is produced, without
+ * first building it up to escape it.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef HtmlEscapedOutput_h
+    #define HtmlEscapedOutput_h
+
+    #include <Arduino.h>
+    #include <Print.h>
+
+    class HtmlEscapedOutput : public Print {
+        private:
+            Print* out;
+
+            static const __FlashStringHelper* entityOf(uint8_t c);
+
+        public:
+            HtmlEscapedOutput(Print &out);
+
+            size_t write(uint8_t c) override;
+            size_t write(const uint8_t* data, size_t length) override;
+    };
+
+#endif
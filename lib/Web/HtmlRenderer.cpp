@@ -0,0 +1,40 @@
+/*
+ * HtmlRenderer - Renders an HTML template kept in flash straight to a
+ * Print, a piece at a time.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include "HtmlRenderer.h"
+
+/**
+ * Renders a template to the given output. Each segment's literal text is
+ * written straight out of flash and then the slot writer is called to 
+ * write the value of the slot which follows it. When the compressed form
+ * of the template is given, the output may send that instead.
+ *
+ * @param text The text of the template kept in flash as PGM_P.
+ * @param segments The segments of the template, the last of which has
+ * no slot, as const HtmlSegment*.
+ * @param out Where to render to as ChunkedOutput.
+ * @param slotWriter Writes the value of a slot as SlotWriter.
+ * @param deflated The template's segments compressed, or null, as HtmlDeflated.
+*/
+void HtmlRenderer::render(PGM_P text, const HtmlSegment* segments, ChunkedOutput &out, SlotWriter slotWriter, const HtmlDeflated* deflated) {
+    for (uint8_t i = 0; ; i ++) {
+        const HtmlSegment* segment = &segments[i];
+        if (segment->length > 0U) {
+            if (deflated != nullptr) {
+                out.writeSegment(text + segment->offset, segment->length, (PGM_P)(deflated->bytes + deflated->segments[i].offset), deflated->segments[i].length);
+            } else {
+                out.writeSegment(text + segment->offset, segment->length, nullptr, 0U);
+            }
+        }
+        if (segment->slot == HTML_NO_SLOT) { // End of template...
+
+            return;
+        }
+        slotWriter(segment->slot, out);
+    }
+}
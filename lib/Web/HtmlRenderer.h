@@ -0,0 +1,34 @@
+/*
+ * HtmlRenderer - Renders an HTML template kept in flash straight to a
+ * ChunkedOutput, a piece at a time. The template is split into literal 
+ * segments and slots at compile time by HtmlTemplate, so rendering is 
+ * writing each segment out of flash and having a callback write the value
+ * of each slot to the same output. The page is never built up in RAM.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef HtmlRenderer_h
+    #define HtmlRenderer_h
+
+    #include <Arduino.h>
+    #include <functional>
+    #include <ChunkedOutput.h>
+    #include <HtmlTemplate.h>
+
+    typedef std::function<void(uint8_t slot, ChunkedOutput &out)> SlotWriter;
+
+    class HtmlRenderer {
+        private:
+
+        public:
+            static void render(PGM_P text, const HtmlSegment* segments, ChunkedOutput &out, SlotWriter slotWriter, const HtmlDeflated* deflated);
+
+            template <size_t SEGMENTS>
+            static void render(const HtmlTemplate<SEGMENTS> &htmlTemplate, ChunkedOutput &out, SlotWriter slotWriter, const HtmlDeflated* deflated = nullptr) {
+                render(htmlTemplate.text, htmlTemplate.segments, out, slotWriter, deflated);
+            }
+    };
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * HtmlTemplate - Splits an HTML template into literal segments and slots
+ * at compile time. Each ${name} placeholder in the template becomes the
+ * index of the slot to fill after the literal text ahead of it, so at run
+ * time rendering is just writing each segment straight out of flash and
+ * filling each slot, with no searching of the template at all.
+ *
+ * A placeholder whose name isn't in the list of slot names given, or
+ * which isn't closed, fails the build.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef HtmlTemplate_h
+    #define HtmlTemplate_h
+
+    #include <stdint.h>
+    #include <stddef.h>
+
+    #define HTML_NO_SLOT 0xFF
+
+    // *****************************************************************************
+    // Literal text of a template followed by the slot to fill after it. The last
+    // segment of a template has no slot.
+    // *****************************************************************************
+    struct HtmlSegment {
+        uint16_t       offset                      ;
+        uint16_t       length                      ;
+        uint8_t        slot                        ;
+    };
+
+    // *****************************************************************************
+    // The segments of a template compressed at build time as raw deflate blocks 
+    // which end on a byte boundary, so they can be sent with other blocks between
+    // them. These are generated into HtmlContentGz.h by scripts/gzip_html.py.
+    // *****************************************************************************
+    struct HtmlDeflatedSegment {
+        uint16_t       offset                      ;
+        uint16_t       length                      ;
+    };
+
+    struct HtmlDeflated {
+        const uint8_t* bytes                       ; // Kept in flash
+        const HtmlDeflatedSegment* segments        ; // Same order as the template's segments
+    };
+
+    template <size_t SEGMENTS>
+    struct HtmlTemplate {
+        const char*    text                        ; // Kept in flash
+        HtmlSegment    segments    [SEGMENTS]      ;
+    };
+
+    // Splits the given template, which must be constexpr, using the given array of slot names...
+    #define HTML_SPLIT(text, slotNames) \
+        HtmlSplitter::split<HtmlSplitter::countSlots(text) + 1>(text, slotNames, sizeof(slotNames) / sizeof(slotNames[0]))
+
+    class HtmlSplitter {
+        private:
+            // Not constexpr, so reaching it during a split fails the build...
+            static void placeholderInvalid() {}
+
+            static constexpr bool isName(const char* text, size_t length, const char* name) {
+                size_t i = 0;
+                while (i < length && name[i] != '\0' && name[i] == text[i]) {
+                    i ++;
+                }
+
+                return (i == length && name[i] == '\0');
+            }
+
+            static constexpr uint8_t slotOf(const char* text, size_t length, const char* const* slotNames, size_t slotCount) {
+                for (size_t i = 0; i < slotCount; i ++) {
+                    if (isName(text, length, slotNames[i])) {
+
+                        return (uint8_t)i;
+                    }
+                }
+                placeholderInvalid();
+
+                return HTML_NO_SLOT;
+            }
+
+        public:
+            static constexpr size_t countSlots(const char* text) {
+                size_t count = 0;
+                for (size_t i = 0; text[i] != '\0'; i ++) {
+                    if (text[i] == '$' && text[i + 1] == '{') {
+                        count ++;
+                    }
+                }
+
+                return count;
+            }
+
+            template <size_t SEGMENTS>
+            static constexpr HtmlTemplate<SEGMENTS> split(const char* text, const char* const* slotNames, size_t slotCount) {
+                HtmlTemplate<SEGMENTS> result = {text, {}};
+                size_t segment = 0;
+                size_t start = 0;
+                size_t i = 0;
+                while (text[i] != '\0') {
+                    if (text[i] == '$' && text[i + 1] == '{') { // Placeholder...
+                        size_t nameStart = i + 2;
+                        size_t nameEnd = nameStart;
+                        while (text[nameEnd] != '}') {
+                            if (text[nameEnd] == '\0') { // Never closed...
+                                placeholderInvalid();
+
+                                return result;
+                            }
+                            nameEnd ++;
+                        }
+                        result.segments[segment] = {
+                            (uint16_t)start, 
+                            (uint16_t)(i - start), 
+                            slotOf(text + nameStart, nameEnd - nameStart, slotNames, slotCount)
+                        };
+                        segment ++;
+                        i = nameEnd + 1;
+                        start = i;
+                    } else {
+                        i ++;
+                    }
+                }
+                result.segments[segment] = {(uint16_t)start, (uint16_t)(i - start), HTML_NO_SLOT};
+
+                return result;
+            }
+    };
+
+#endif
@@ -0,0 +1,106 @@
+"""
+gzip_html - Compresses the static parts of the HTML templates at build time.
+
+Each template in include/HtmlContent.h is split at its ${name} placeholders,
+the same way HtmlTemplate.h splits it at compile time, and each literal
+segment is compressed into raw deflate blocks ending with a full flush. A
+full flush leaves the stream on a byte boundary with no history carried
+over, so the firmware can send the segments with its own stored blocks
+between them as one gzip stream. Segments which don't get smaller are kept
+as stored blocks. The result is written to include/HtmlContentGz.h.
+
+Runs as a PlatformIO pre script, or by itself with python.
+
+Written by: Scott Griffis
+Date: 10-16-2026
+"""
+
+import os
+import re
+import struct
+import zlib
+
+try:
+    Import("env")  # noqa: F821 - Provided by PlatformIO
+    PROJECT_DIR = env.subst("$PROJECT_DIR")  # noqa: F821
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SOURCE = os.path.join(PROJECT_DIR, "include", "HtmlContent.h")
+TARGET = os.path.join(PROJECT_DIR, "include", "HtmlContentGz.h")
+
+TEMPLATE_PATTERN = re.compile(r"constexpr char PROGMEM (\w+)\[\] = \{(.*?)\};", re.DOTALL)
+LITERAL_PATTERN = re.compile(r'"((?:[^"\\]|\\.)*)"')
+SLOT_PATTERN = re.compile(r"\$\{[^}]*\}")
+ESCAPES = {"n": "\n", "t": "\t", "r": "\r", '"': '"', "\\": "\\", "'": "'"}
+
+
+def decode_literal(literal):
+    return re.sub(r"\\(.)", lambda match: ESCAPES[match.group(1)], literal)
+
+
+def deflate_segment(segment):
+    if not segment:
+        return b""
+
+    compressor = zlib.compressobj(9, zlib.DEFLATED, -15, 9)
+    deflated = compressor.compress(segment) + compressor.flush(zlib.Z_FULL_FLUSH)
+    stored = b"\x00" + struct.pack("<HH", len(segment), len(segment) ^ 0xFFFF) + segment
+
+    return deflated if len(deflated) < len(stored) else stored
+
+
+def to_bytes_source(data):
+    lines = []
+    for start in range(0, len(data), 16):
+        lines.append("        " + ", ".join("0x%02X" % byte for byte in data[start:start + 16]) + ",")
+
+    return "\n".join(lines)
+
+
+def generate():
+    with open(SOURCE, "r") as source:
+        content = source.read()
+
+    out = [
+        "// GENERATED by scripts/gzip_html.py from HtmlContent.h, DO NOT EDIT.",
+        "",
+        "#ifndef HtmlContentGz_h",
+        "    #define HtmlContentGz_h",
+        "",
+        "    #include <pgmspace.h>",
+        "    #include <HtmlTemplate.h>",
+        "",
+    ]
+    for name, body in TEMPLATE_PATTERN.findall(content):
+        text = "".join(decode_literal(literal) for literal in LITERAL_PATTERN.findall(body)).encode("ascii")
+        blob = b""
+        segments = []
+        for segment in SLOT_PATTERN.split(text.decode("ascii")):
+            deflated = deflate_segment(segment.encode("ascii"))
+            segments.append((len(blob), len(deflated)))
+            blob += deflated
+
+        out.append("    // %s: %d bytes as %d compressed" % (name, len(text), len(blob)))
+        out.append("    const uint8_t PROGMEM %s_GZ[] = {" % name)
+        out.append(to_bytes_source(blob))
+        out.append("    };")
+        out.append("    const HtmlDeflatedSegment %s_GZ_SEGMENTS[] = {" % name)
+        out.append(",\n".join("        {%d, %d}" % segment for segment in segments))
+        out.append("    };")
+        out.append("    const HtmlDeflated %s_DEFLATED = {%s_GZ, %s_GZ_SEGMENTS};" % (name, name, name))
+        out.append("")
+    out.append("#endif")
+    generated = "\n".join(out) + "\n"
+
+    existing = None
+    if os.path.exists(TARGET):
+        with open(TARGET, "r") as target:
+            existing = target.read()
+    if generated != existing:  # Only touch when changed, to not force rebuilds
+        with open(TARGET, "w") as target:
+            target.write(generated)
+        print("gzip_html: Generated %s" % TARGET)
+
+
+generate()
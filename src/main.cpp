@@ -7,33 +7,58 @@
 #include <ESP8266WebServerSecure.h>
 #include <Adafruit_SSD1306.h>
 #include <DisplayWrapper.h>
+#include <Scheduler.h>
+#include <ButtonMonitor.h>
+#include <AlertDispatcher.h>
+#include <SmtpConnection.h>
+#include <HealthMonitor.h>
+#include <ChunkedOutput.h>
+#include <HtmlRenderer.h>
+#include <GzipOutput.h>
+#include <HandshakeStats.h>
+#include <HtmlEscapedOutput.h>
 #include <ArduinoJson.h>
+#include <SettingsUpdate.h>
 
 #include <ESP_Mail_Client.h>
 
 #include "ExampleSecrets.h"
 #include "Secrets.h"
 #include "HtmlContent.h"
+#include "HtmlContentGz.h"
 
 #define FIRMWARE_VERSION "1.4.0"
 #define PANIC_BTN_PIN 12
 #define CANCEL_BTN_PIN 13
 #define LED_PIN 16
-
-enum MessageType {
-  MT_ALERT,
-  MT_PARTIAL,
-  MT_CANCEL
+#ifndef WEB_TLS_SESSIONS
+  #define WEB_TLS_SESSIONS 8 // Enough for the parallel connections of a browser
+#endif
+
+enum ButtonState {
+  BS_IDLE,
+  BS_SHOWING_IP,
+  BS_PANIC_COUNTDOWN,
+  BS_CANCEL_COUNTDOWN,
+  BS_HOLDING,
+  BS_WAIT_RELEASE
 };
 
 void resetOrLoadSettings();
 void initNetwork();
 void initDisplay();
 void initWeb();
-void sendMessage(enum MessageType messageType);
+void initAlerts();
+bool sendMessage(MessageType msgType, uint8_t recipient);
+void onAlertJobComplete(AlertJob &job, uint8_t sentCount, uint8_t failedCount);
+void doDispatchAlerts();
 void dumpDeviceInfo();
+void doReportHeap();
+void doKeepSmtpWarm();
+void doHandleWebClients();
 bool isConnectionGood();
-String getSettingsAsJson();
+bool isWifiLinkGood();
+bool isSmtpHostReachable();
 void fileUploadHandler();
 void notFoundHandler();
 void endpointHandlerAdmin();
@@ -43,36 +68,71 @@ void endpointHandlerRoot();
 void activateApMode();
 void connectToNetwork();
 
+typedef std::function<void(ChunkedOutput &out)> ContentWriter;
+
 void sendHtmlPageUsingTemplate(int code, String title, String heading, String &content);
+void sendHtmlPage(int code, const String &title, const String &heading, ContentWriter contentWriter);
+void renderHtmlPage(ChunkedOutput &out, const String &title, const String &heading, ContentWriter contentWriter);
+void sendResponseChunk(const char* data, size_t length);
 
 void doVerifyDeviceStatus();
 void doHandleButtons();
+void handleButtonEvent(ButtonEvent &event);
+void showIp();
+void startCountdown(ButtonState countdownState);
+void doCountdownTick();
+void completeCountdown();
+void holdDisplay(unsigned long duration);
+void initTasks();
+void initButtons();
 
 Settings settings = Settings();
 
-Adafruit_SSD1306 disp(128/*ScreenWidth*/, 32/*ScreenHeight*/, &Wire/*WireReference*/, -1/*OledReset*/);
+Adafruit_SSD1306 disp(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire/*WireReference*/, -1/*OledReset*/, 400000UL/*ClkDuring*/, 400000UL/*ClkAfter*/);
 DisplayWrapper display(&disp, LED_PIN);
 BearSSL::ESP8266WebServerSecure webServer(/*Port*/443);
-BearSSL::ServerSessions serverCache(/*Sessions*/4);
+BearSSL::ServerSession* serverSessionStore = nullptr; // Only made when the web server runs
+BearSSL::ServerSessions* serverCache = nullptr;
+HandshakeStats handshakes;
+Scheduler scheduler(millis);
+ButtonMonitor buttons(/*DebounceMs*/30UL, /*LongPressMs*/4000UL);
+AlertDispatcher alerts(sendMessage, millis);
+
+Session_Config smtpConfig;
+SmtpConnection mailLink(&smtpConfig);
+HealthMonitor health(isWifiLinkGood, isSmtpHostReachable, isConnectionGood, millis);
 
 String deviceId = "";
 // bool lastAlertSendError = false; 
 // bool deviceInFaultStatus = false;
-unsigned long lastInternetVerify = 0UL;
-unsigned long lastInternetVerifySkip = 0UL;
+unsigned long lastStatusRefresh = 0UL;
 
 struct DeviceState {
   bool inParalizedStatus;
   bool isAlertSend;
   bool isPartialSend;
   bool isSendError; // TODO: Might use to flag periodic retries???
+  bool isDisplayHeld;
 } state = {
   false,
   false,
   false,
+  false,
   false
 };
 
+struct ButtonFlow {
+  ButtonState state;
+  int countDown;
+  int countdownTask;
+  int displayHoldTask;
+} buttonFlow = {
+  BS_IDLE,
+  0,
+  SCHEDULER_NO_TASK,
+  SCHEDULER_NO_TASK
+};
+
 /**
  * ==============================================================================
  * MAIN SETUP
@@ -99,8 +159,11 @@ void setup() {
   /* Perform Device Initializations */
   initDisplay();
   resetOrLoadSettings();
+  initAlerts();
   initNetwork();
   initWeb();
+  initButtons();
+  initTasks();
 
   Serial.println(F("Initialization complete."));
 
@@ -117,102 +180,204 @@ void setup() {
  * =========================================================================
  * This is the main looping part of the software after setup has completed
  * this loop drive the remainder of the software's functionality for as long
- * as the device remains operational.
+ * as the device remains operational. All of the actual work is done by the
+ * tasks registered with the scheduler in 'initTasks', so nothing in here
+ * should ever block.
 */
 void loop() {
-  doVerifyDeviceStatus();
-  webServer.handleClient();
-  display.run();
-  doHandleButtons();
+  scheduler.run();
 
   yield();
 }
 
+/**
+ * Registers the tasks which make up the normal running of the device
+ * with the scheduler. Since none of the tasks block, the time between a
+ * button press and the device acting on it is bounded by the tick of
+ * the scheduler rather than by whatever else the device is doing.
+*/
+void initTasks() {
+  scheduler.every(0UL/*EveryTick*/, doHandleWebClients);
+  scheduler.every(10UL, doHandleButtons);
+  display.setFlushBudget(64U/*BytesPerRun*/);
+  scheduler.every(10UL, []() { display.run(); });
+  scheduler.every(100UL, doVerifyDeviceStatus);
+  scheduler.every(20UL, doDispatchAlerts);
+  scheduler.every(10000UL, doKeepSmtpWarm);
+  scheduler.every(600000UL, doReportHeap);
+}
+
 /**
  * This function does the handling of any and all button presses by the user
  * which take place durning the post setup normal running of the applicaiton.
  * This function DOES NOT handle the factory reset feature, as that is handled 
  * by the 'resetOrLoadSettings' function.
+ * 
+ * The buttons' edges are captured by interrupts, so this only needs to work
+ * through the resulting events. Any press which happened while the device
+ * was busy is acted on here, in the order it happened.
 */
 void doHandleButtons() {
-  if (!state.inParalizedStatus) {
-    bool ipShown = false;
-    /* Check For IP Signal Request */
-    if (
-      digitalRead(CANCEL_BTN_PIN) == HIGH 
-      && !settings.getInPanicMode() 
-      && digitalRead(PANIC_BTN_PIN) == HIGH
-    ) { // Tigger Special Action... 
-      bool isShown = false;
-      String ip = ((WiFi.getMode() == WIFI_AP) ? WiFi.softAPIP().toString() : WiFi.localIP().toString());
-      while (digitalRead(CANCEL_BTN_PIN) == HIGH && digitalRead(PANIC_BTN_PIN) == HIGH) {
-        if (!isShown) {
-          display.show("IP: " + ip);
-          ipShown = true;
-        }
-        yield();
-      }
-    }
+  buttons.update(millis());
+  if (buttons.hadOverflow()) {
+    Serial.println(F("WARNING!!! Button edges were lost!"));
+  }
+
+  ButtonEvent event;
+  while (buttons.pollEvent(event)) {
+    handleButtonEvent(event);
+  }
+
+  if (buttonFlow.state == BS_HOLDING && !state.isDisplayHeld) {
+    buttonFlow.state = BS_WAIT_RELEASE;
+  }
+  if (buttonFlow.state == BS_WAIT_RELEASE && !buttons.isPressed(BTN_PANIC) && !buttons.isPressed(BTN_CANCEL)) {
+    buttonFlow.state = BS_IDLE;
+  }
+}
 
-    /* Check For Panic Button */
-    if (
-      !ipShown
-      && digitalRead(PANIC_BTN_PIN) == HIGH 
-      && !settings.getInPanicMode() 
-      && digitalRead(CANCEL_BTN_PIN) == LOW
-    ) { // Prepare to trigger Panic Mode...
-      int countDown = 3;
-      while (digitalRead(PANIC_BTN_PIN) == HIGH && countDown != -1) {
-        display.show("Panic in... " + String(countDown));
-        countDown --;
-        delay(1000);
+/**
+ * Steps the button handling state machine with the given event.
+ * 
+ * @param event The event to act on as ButtonEvent.
+*/
+void handleButtonEvent(ButtonEvent &event) {
+  switch (buttonFlow.state) {
+    case BS_IDLE:
+      if (state.inParalizedStatus) {
+        break;
       }
-      if (countDown == -1) {
-          display.show(F("Panic In Progress..."));
-          display.ledFlash();
-          settings.setInPanicMode(true);
-          sendMessage(MessageType::MT_ALERT);
-          while (digitalRead(PANIC_BTN_PIN) == HIGH) {
-            yield();
-          }
-      } else {
-        display.show(F("Panic Aborted."));
-        display.ledOff();
-        yield();
-        delay(5000);
+
+      if (event.type == BE_CHORD && !settings.getInPanicMode()) { // Tigger Special Action...
+        showIp();
+      } else if (
+        event.type == BE_PRESSED 
+        && event.button == BTN_PANIC 
+        && !buttons.isPressed(BTN_CANCEL) 
+        && !settings.getInPanicMode()
+      ) { // Prepare to trigger Panic Mode...
+        startCountdown(BS_PANIC_COUNTDOWN);
+      } else if (
+        event.type == BE_PRESSED 
+        && event.button == BTN_CANCEL 
+        && !buttons.isPressed(BTN_PANIC) 
+        && settings.getInPanicMode()
+      ) { // Prepare to cancel Panic Mode...
+        startCountdown(BS_CANCEL_COUNTDOWN);
       }
-    }
+      break;
 
-    /* Check for Panic Cancel */
-    if (
-      !ipShown
-      && digitalRead(CANCEL_BTN_PIN) == HIGH 
-      && settings.getInPanicMode() 
-      && digitalRead(PANIC_BTN_PIN) == LOW
-    ) { // Prepare to cancel Panic Mode...
-      int countDown = 3;
-      while (digitalRead(CANCEL_BTN_PIN) == HIGH && countDown != -1) {
-        display.show("Cancel in... " + String(countDown));
-        countDown --;
-        delay(1000);
+    case BS_SHOWING_IP:
+      if (event.type == BE_RELEASED) {
+        buttonFlow.state = BS_IDLE;
       }
-      if (countDown == -1) {
-          display.show(F("Panic Canceled."));
-          display.ledOff();
-          settings.setInPanicMode(false);
-          sendMessage(MessageType::MT_CANCEL);
-          yield();
-          delay(5000);
-          while (digitalRead(CANCEL_BTN_PIN) == HIGH) {
-            yield();
-          }
-      } else {
-        display.show(F("Cancel Aborted."));
+      break;
+
+    case BS_PANIC_COUNTDOWN:
+    case BS_CANCEL_COUNTDOWN: {
+      uint8_t button = ((buttonFlow.state == BS_PANIC_COUNTDOWN) ? BTN_PANIC : BTN_CANCEL);
+      if (event.type == BE_CHORD && buttonFlow.state == BS_PANIC_COUNTDOWN) { // Wanted the IP instead...
+        scheduler.cancel(buttonFlow.countdownTask);
+        showIp();
+      } else if (event.type == BE_RELEASED && event.button == button) { // Released before countdown completed...
+        scheduler.cancel(buttonFlow.countdownTask);
+        display.show((buttonFlow.state == BS_PANIC_COUNTDOWN) ? F("Panic Aborted.") : F("Cancel Aborted."));
         display.ledOff();
-        yield();
-        delay(5000);
+        holdDisplay(5000UL);
+        buttonFlow.state = BS_HOLDING;
+      } else if (event.type == BE_LONG_PRESS && event.button == button) { // Held through the countdown...
+        scheduler.cancel(buttonFlow.countdownTask);
+        completeCountdown();
       }
+      break;
+    }
+
+    default: // Presses are ignored while holding a message or waiting for release...
+      break;
+  }
+}
+
+/**
+ * Shows the device's IP Address on the display.
+*/
+void showIp() {
+  String ip = ((WiFi.getMode() == WIFI_AP) ? WiFi.softAPIP().toString() : WiFi.localIP().toString());
+  display.show("IP: " + ip);
+  buttonFlow.state = BS_SHOWING_IP;
+}
+
+/**
+ * Starts the countdown shown while the panic or cancel button is held.
+ * 
+ * @param countdownState Either BS_PANIC_COUNTDOWN or BS_CANCEL_COUNTDOWN as ButtonState.
+*/
+void startCountdown(ButtonState countdownState) {
+  buttonFlow.state = countdownState;
+  buttonFlow.countDown = 3;
+  String prefix = ((countdownState == BS_PANIC_COUNTDOWN) ? F("Panic in... ") : F("Cancel in... "));
+  display.show(prefix + String(buttonFlow.countDown));
+  buttonFlow.countdownTask = scheduler.after(1000UL, doCountdownTick);
+}
+
+/**
+ * This is a one-shot task which is scheduled once a second while a panic
+ * or cancel countdown is in progress, to update the countdown shown on the
+ * display. The action itself is taken once the button's long press event
+ * arrives.
+*/
+void doCountdownTick() {
+  buttonFlow.countDown --;
+  String prefix = ((buttonFlow.state == BS_PANIC_COUNTDOWN) ? F("Panic in... ") : F("Cancel in... "));
+  display.show(prefix + String(buttonFlow.countDown));
+  if (buttonFlow.countDown > 0) {
+    buttonFlow.countdownTask = scheduler.after(1000UL, doCountdownTick);
+  } else {
+    buttonFlow.countdownTask = SCHEDULER_NO_TASK;
+  }
+}
+
+/**
+ * Performs the action of the countdown which is in progress, either
+ * triggering or canceling Panic Mode.
+*/
+void completeCountdown() {
+  if (buttonFlow.state == BS_PANIC_COUNTDOWN) {
+    display.show(F("Panic In Progress..."));
+    display.ledFlash();
+    settings.setInPanicMode(true);
+    alerts.enqueue(MT_ALERT);
+    buttonFlow.state = BS_WAIT_RELEASE;
+  } else if (buttonFlow.state == BS_CANCEL_COUNTDOWN) {
+    display.show(F("Panic Canceled."));
+    display.ledOff();
+    settings.setInPanicMode(false);
+    if (!alerts.enqueue(MT_CANCEL)) { // Shouldn't happen, a cancel makes its own room...
+      Serial.println(F("Failed to queue the cancel!"));
+      display.show(F("Send Error!!!"));
+      display.ledOn();
     }
+    holdDisplay(5000UL);
+    buttonFlow.state = BS_HOLDING;
+  }
+}
+
+/**
+ * Keeps whatever is currently on the display from being replaced by the
+ * periodic status updates for the given duration. This is used in place
+ * of delaying so that a message can be read while everything else keeps
+ * running.
+ * 
+ * @param duration How long to hold the display in millis as unsigned long.
+*/
+void holdDisplay(unsigned long duration) {
+  state.isDisplayHeld = true;
+  if (scheduler.isScheduled(buttonFlow.displayHoldTask)) {
+    scheduler.reschedule(buttonFlow.displayHoldTask, duration);
+  } else {
+    buttonFlow.displayHoldTask = scheduler.after(duration, []() {
+      state.isDisplayHeld = false;
+      buttonFlow.displayHoldTask = SCHEDULER_NO_TASK;
+    });
   }
 }
 
@@ -222,6 +387,11 @@ void doHandleButtons() {
  * not in an alert condition.
 */
 void doVerifyDeviceStatus() {
+  if (state.isDisplayHeld || buttonFlow.state != BS_IDLE) { // Display is in use...
+
+    return;
+  }
+
   if (!settings.getInPanicMode()) { // Not in Panic Mode...
     /* Reset Panic Mode State Flags*/
     state.isAlertSend = false;
@@ -234,29 +404,28 @@ void doVerifyDeviceStatus() {
       display.ledOn();
       state.inParalizedStatus = true;
     } 
-    /* Periodic SMTP Host Checks */
-    if (WiFi.getMode() == WIFI_STA) {
-      if (millis() - lastInternetVerify > 120000UL) {
-        if (isConnectionGood()) {
+    /* Tiered SMTP Host Checks */
+    if (WiFi.getMode() == WIFI_STA && alerts.isIdle()) {
+      health.run();
+      if (health.isHealthy()) {
+        if (state.inParalizedStatus || millis() - lastStatusRefresh > 3000UL) {
           display.show(F("System Ready."));
           display.ledOff();
           state.inParalizedStatus = false;
-        } else if (!state.inParalizedStatus) {
-          display.show(F("Internet Down?"));
-          display.ledOn();
-          state.inParalizedStatus = true;
-        }
-
-        lastInternetVerify = millis();
-      } else if (!state.inParalizedStatus && millis() - lastInternetVerifySkip > 3000UL) {
-        display.show(F("System Ready."));
-        display.ledOff();
 
-        lastInternetVerifySkip = millis();
+          lastStatusRefresh = millis();
+        }
+      } else if (!state.inParalizedStatus) {
+        display.show(F("Internet Down?"));
+        display.ledOn();
+        state.inParalizedStatus = true;
       }
     }
   } else { // In Panic Mode!!!
-    if (state.isSendError && !state.isPartialSend) { // Send Error and No Partial Sent...
+    if (!alerts.isIdle() && !state.isSendError) { // Alerts still going out...
+      display.show(F("Sending Alerts..."));
+      display.ledFlash();
+    } else if (state.isSendError && !state.isPartialSend) { // Send Error and No Partial Sent...
       display.show(F("Send Error!!!"));
       display.ledOn();
     } else if (state.isSendError) { // Partial Send Notification Sent...
@@ -275,21 +444,64 @@ void doVerifyDeviceStatus() {
  * made otherwise false indicates an issue between the device and server.
  * Issue could be network related, server related or credential related.
  * 
+ * The SMTP session is kept open between checks, so when it is still good
+ * this only costs a NOOP and also serves to keep the session alive for
+ * the next alert.
+ * 
  * @return Returns true if connection is good, otherwise false as bool.
 */
 bool isConnectionGood() {
-  Session_Config config;
-  config.server.host_name = settings.getSmtpHost();
-  config.server.port = settings.getSmtpPort();
-  config.login.email = settings.getSmtpUser();
-  config.login.password = settings.getSmtpPwd();
 
-  SMTPSession smtp;
-  smtp.connect(&config);
-  bool isConn = smtp.connected();
-  smtp.closeSession();
+  return mailLink.keepAlive();
+}
+
+/**
+ * This is the scheduler task which keeps the SMTP session warm between
+ * alerts. The full health check only comes around on an interval which
+ * grows while healthy, up to longer than servers let a session sit idle,
+ * so the keep-alive NOOP is done here on its own fixed interval instead.
+*/
+void doKeepSmtpWarm() {
+  mailLink.keepWarm();
+}
+
+/**
+ * This is the cheapest of the health checks, it only looks at the state of
+ * the WiFi link and the strength of its signal.
+ * 
+ * @return Returns true if the link is up and usable, otherwise false as bool.
+*/
+bool isWifiLinkGood() {
+
+  return (WiFi.status() == WL_CONNECTED && WiFi.RSSI() > -90);
+}
+
+/**
+ * This health check makes sure the SMTP Server's hostname can be resolved
+ * and that a plain TCP connection can be made to it. No TLS handshake or
+ * login is done so it is far cheaper than 'isConnectionGood'.
+ * 
+ * While the server is down the connect blocks for its whole 2 second
+ * timeout, and the HealthMonitor retries this every link interval until
+ * it is back, so the loop stalls for up to 2 seconds every 5 seconds.
+ * A panic press waits out the stall before it is seen. None of this runs
+ * once in panic mode, nor while a countdown is under way.
+ * 
+ * @return Returns true if the server is reachable, otherwise false as bool.
+*/
+bool isSmtpHostReachable() {
+  IPAddress serverIp;
+  if (!WiFi.hostByName(settings.viewSmtpHost().chars, serverIp)) { // DNS failed...
+
+    return false;
+  }
+
+  WiFiClient client;
+  client.setTimeout(2000UL);
+  bool isReachable = client.connect(serverIp, settings.getSmtpPort());
+  client.stop();
 
-  return isConn;
+  return isReachable;
 }
 
  /**
@@ -339,6 +551,31 @@ void resetOrLoadSettings() {
   settings.loadSettings();
 }
 
+/**
+ * Interrupt handler for edges of the panic button.
+*/
+IRAM_ATTR void onPanicButtonEdge() {
+  buttons.pushEdge(BTN_PANIC, (digitalRead(PANIC_BTN_PIN) == HIGH), millis());
+}
+
+/**
+ * Interrupt handler for edges of the cancel button.
+*/
+IRAM_ATTR void onCancelButtonEdge() {
+  buttons.pushEdge(BTN_CANCEL, (digitalRead(CANCEL_BTN_PIN) == HIGH), millis());
+}
+
+/**
+ * Initializes the handling of the buttons by capturing their current
+ * state and then attaching the pin change interrupts which feed the
+ * button monitor.
+*/
+void initButtons() {
+  buttons.begin((digitalRead(PANIC_BTN_PIN) == HIGH), (digitalRead(CANCEL_BTN_PIN) == HIGH));
+  attachInterrupt(digitalPinToInterrupt(PANIC_BTN_PIN), onPanicButtonEdge, CHANGE);
+  attachInterrupt(digitalPinToInterrupt(CANCEL_BTN_PIN), onCancelButtonEdge, CHANGE);
+}
+
 /**
  * Initializes the device's display.
  * 
@@ -349,12 +586,16 @@ void initDisplay() {
   display.ledOn();
 }
 
-void sendMessage(enum MessageType msgType) {
-  Session_Config config;
-  config.server.host_name = settings.getSmtpHost();
-  config.server.port = settings.getSmtpPort();
-  config.login.email = settings.getSmtpUser();
-  config.login.password = settings.getSmtpPwd();
+/**
+ * Initializes the alert delivery by preparing the SMTP session's config
+ * and handing the list of recipients to the alert dispatcher, so neither
+ * has to be redone for each message sent.
+*/
+void initAlerts() {
+  smtpConfig.server.host_name = settings.viewSmtpHost().chars;
+  smtpConfig.server.port = settings.getSmtpPort();
+  smtpConfig.login.email = settings.viewSmtpUser().chars;
+  smtpConfig.login.password = settings.viewSmtpPwd().chars;
 
   /* 
     Set the NTP config time
@@ -363,14 +604,51 @@ void sendMessage(enum MessageType msgType) {
     Ex. American/Denver GMT would be -6. 6 + 12 = 18
     See https://en.wikipedia.org/wiki/Time_zone for a list of the GMT/UTC timezone offsets
   */
-  config.time.ntp_server = "pool.ntp.org,time.nist.gov";
-  config.time.gmt_offset = 18;
-  config.time.day_light_offset = 0;
+  smtpConfig.time.ntp_server = "pool.ntp.org,time.nist.gov";
+  smtpConfig.time.gmt_offset = 18;
+  smtpConfig.time.day_light_offset = 0;
+
+  mailLink.getSession()->debug(1);
+
+  if (!alerts.setRecipientCount(settings.getRecipientCount())) {
+    Serial.printf("Only the first %d recipients will be sent alerts!\n", SETTINGS_MAX_RECIPIENTS);
+  }
+  alerts.onJobComplete(onAlertJobComplete);
+}
 
+/**
+ * This is the scheduler task which drives the alert dispatcher. It is
+ * also where changed settings get persisted, ahead of the alert work of
+ * the tick. A step can be a whole SMTP transaction taking seconds, so
+ * persisting behind it would leave a panic uncommitted for that long,
+ * and lost if power failed meanwhile. Committing the panic state is only
+ * a small journal append, which delays the first message by far less.
+*/
+void doDispatchAlerts() {
+  // Settings are written ahead of the alert work so a panic is committed before the first message...
+  if (settings.isDirty() && !settings.flush()) {
+    Serial.println(F("Failed to persist settings, will retry!"));
+  }
+
+  alerts.step();
+}
+
+/**
+ * Sends a message of the given type to a single recipient. This is the
+ * function used by the alert dispatcher to deliver each recipient of a
+ * job. The SMTP session is left open afterwards so that later messages
+ * can be sent over it without connecting again.
+ * 
+ * @param msgType The type of message to send as MessageType.
+ * @param recipient The index of the recipient in the settings as uint8_t.
+ * 
+ * @return Returns true if the message was sent otherwise false as bool.
+*/
+bool sendMessage(MessageType msgType, uint8_t recipient) {
   SMTP_Message msg;
-  msg.sender.name = settings.getFromName();
-  msg.sender.email = settings.getFromEmail();
-  String panicLevel = F("TEST");
+  msg.sender.name = settings.viewFromName().chars;
+  msg.sender.email = settings.viewFromEmail().chars;
+  const __FlashStringHelper* panicLevel = F("TEST");
   switch(settings.getPanicLevel()) {
     case 1:
       panicLevel = F("TEST");
@@ -389,94 +667,103 @@ void sendMessage(enum MessageType msgType) {
     break;
   } 
 
-  String recips = settings.getRecipients();
-  unsigned int addrCnt = ParseUtils::occurrences(recips, ";");
-  addrCnt ++; // because ';' only needed if more than 1 address
-  String addresses[addrCnt];
-  ParseUtils::split(recips, ';', addresses, sizeof(addresses));
-  for (String addr : addresses) {
-    addr.trim();
-    if (!addr.isEmpty()) {
-      msg.addRecipient("", addr);
-    }
+  TextSlice recipientView = settings.viewRecipient(recipient);
+  String address;
+  address.concat(recipientView.chars, recipientView.length);
+  msg.addRecipient("", address);
+
+  /* Build subject in place to avoid temporary Strings */
+  SettingView owner = settings.viewOwner();
+  String subject;
+  subject.reserve(owner.length + 40U);
+  if (msgType == MT_CANCEL) {
+    subject.concat(F("Canceled: "));
   }
+  subject.concat(panicLevel);
+  subject.concat(F(" Alert from: "));
+  subject.concat(owner.chars, owner.length);
+  msg.subject = subject;
   
   switch (msgType) {
     case MT_ALERT:
-      msg.subject = String(panicLevel + " Alert from: " + settings.getOwner());
-      msg.text.content = settings.getMessage();
+      msg.text.content = settings.viewMessage().chars;
       break;
     case MT_PARTIAL:
-      msg.subject = String(panicLevel + " Alert from: " + settings.getOwner());
       msg.text.content = F("Not all recipients were able to receive the alert!\nYou may want to take that into account with your response!!!");
       break;
     case MT_CANCEL:
-      msg.subject = String("Canceled: " + panicLevel + " Alert from: " + settings.getOwner());
       msg.text.content = F("The prior alert has been Canceled by the sender!");
       break;
   }
 
-  SMTPSession smtp;
-  smtp.debug(1);
-  if (msgType == MT_ALERT) {
-    smtp.callback([](SMTP_Status status) { // <---- Start of CallBack Function
-      Serial.printf("\nSend results...\n\tCompleated Count: %d\n\tFailed Count: %d\n\tInformation:\n\t\t%s\n\n", status.completedCount(), status.failedCount(), status.info());
-      if (status.failedCount() != 0) { // Some or all sends failed...
+  if (!mailLink.ensureConnected()) { // Couldn't get a session...
+    Serial.printf("Error Sending to '%s', Reason: %s\n", address.c_str(), mailLink.getSession()->errorReason().c_str());
+
+    return false;
+  }
+
+  if (!MailClient.sendMail(mailLink.getSession(), &msg, false/*CloseSession*/)) { // Error sending mail...
+    Serial.printf("Error Sending to '%s', Reason: %s\n", address.c_str(), mailLink.getSession()->errorReason().c_str());
+    mailLink.close(); // Start fresh on the next attempt
+
+    return false;
+  }
+  mailLink.markActive();
+
+  return true;
+}
+
+/**
+ * This is called by the alert dispatcher each time a job has finished. The
+ * device's state is updated from the delivery status of each recipient and
+ * if only some recipients received an alert then those that did are sent a
+ * follow up letting them know that not everyone was notified. There is no
+ * follow up once the panic has been canceled.
+ * 
+ * @param job The finished job as AlertJob reference.
+ * @param sentCount The number of recipients sent to as uint8_t.
+ * @param failedCount The number of recipients which failed as uint8_t.
+*/
+void onAlertJobComplete(AlertJob &job, uint8_t sentCount, uint8_t failedCount) {
+  Serial.printf("\nSend results...\n\tCompleated Count: %d\n\tFailed Count: %d\n\n", sentCount, failedCount);
+
+  switch (job.type) {
+    case MT_ALERT:
+      if (failedCount != 0) { // Some or all sends failed...
         state.isSendError = true;
-        if (status.completedCount() != 0 && !state.isPartialSend) { // Partial send occurred...
-          sendMessage(MessageType::MT_PARTIAL);
+        if (
+          sentCount != 0 && !state.isPartialSend 
+          && settings.getInPanicMode() && !alerts.isQueued(MT_CANCEL)
+        ) { // Partial send occurred and hasn't been canceled...
+          alerts.enqueue(MT_PARTIAL, AlertDispatcher::maskOf(job, RS_SENT));
         }
+      } else if (sentCount != 0) {
+        Serial.println(F("Alerts have been successfuly sent!"));
+        state.isSendError = false;
       }
-    }); // <---- End of CallBack Function
-  } else if (msgType == MT_PARTIAL) {
-    smtp.callback([](SMTP_Status status) {
-      Serial.printf("\nSend results...\n\tCompleated Count: %d\n\tFailed Count: %d\n\tInformation:\n\t\t%s\n\n", status.completedCount(), status.failedCount(), status.info());
-      if (status.failedCount() != 0) { // Some or all sends failed...
-        state.isSendError = true;
-        if (status.completedCount() != 0 && !state.isPartialSend) {
-          state.isPartialSend = true;
-        }
-      } else { // Nothing failed...
+      break;
+
+    case MT_PARTIAL:
+      if (sentCount != 0) {
         state.isPartialSend = true;
       }
-    });
-  } else if (msgType == MT_CANCEL) {
-    smtp.callback([](SMTP_Status status) {
-      Serial.printf("\nSend results...\n\tCompleated Count: %d\n\tFailed Count: %d\n\tInformation:\n\t\t%s\n\n", status.completedCount(), status.failedCount(), status.info());
-      if (status.failedCount() != 0) {
-        if (status.completedCount() == 0) {
-          display.show("Send Error!!!");
-          display.ledOn();
-          yield();
-          delay(3000);
-        } else {
-          display.show("Partial Send!");
-          display.ledFlash();
-          yield();
-          delay(3000);
-        }
-      }
-    });
-  }
+      break;
 
-  smtp.connect(&config);
-  if (!MailClient.sendMail(&smtp, &msg)) { // Error sending mail...
-    Serial.println("Error Sending, Reason: " + smtp.errorReason());
-    if (msgType == MT_ALERT || msgType == MT_PARTIAL) {
-      state.isSendError = true;
-    } 
-  } else { // Email send successful...
-    if (msgType == MT_ALERT || msgType == MT_PARTIAL) {
-      Serial.println(F("Alerts have been successfuly sent!"));
-      state.isSendError = false;
-    } else if (msgType == MT_CANCEL) {
-      display.show("Cancel Sent!");
-      display.ledFlash();
-      Serial.println(F("Cancel has been successfuly sent!"));
-      yield();
-      delay(3000);
+    case MT_CANCEL:
+      if (failedCount == 0) {
+        display.show("Cancel Sent!");
+        display.ledFlash();
+        Serial.println(F("Cancel has been successfuly sent!"));
+      } else if (sentCount == 0) {
+        display.show("Send Error!!!");
+        display.ledOn();
+      } else {
+        display.show("Partial Send!");
+        display.ledFlash();
+      }
+      holdDisplay(3000UL);
       state.isSendError = false;  // No matter what because cancel is best effort.
-    }
+      break;
   }
 }
 
@@ -502,14 +789,20 @@ void initNetwork() {
  */
 void activateApMode() {
   Serial.print(F("Configuring AP mode... "));
+
+  /* AP addresses are constant so are parsed at compile time */
+  constexpr IPv4Parse apNetIp = IpUtils::parseIPv4(SETTINGS_AP_NET_IP);
+  constexpr IPv4Parse apGateway = IpUtils::parseIPv4(SETTINGS_AP_GATEWAY);
+  constexpr IPv4Parse apSubnet = IpUtils::parseIPv4(SETTINGS_AP_SUBNET);
+  static_assert(apNetIp.isValid && apGateway.isValid && apSubnet.isValid, "AP addresses must be valid IPv4 dot notation!");
   
   WiFi.setOutputPower(20.5F);
   WiFi.setHostname(settings.getHostname(deviceId).c_str());
   WiFi.mode(WiFiMode::WIFI_AP);
   WiFi.softAPConfig(
-    IpUtils::stringIPv4ToIPAddress(settings.getApNetIp()), 
-    IpUtils::stringIPv4ToIPAddress(settings.getApGateway()), 
-    IpUtils::stringIPv4ToIPAddress(settings.getApSubnet())
+    IpUtils::toIPAddress(apNetIp.address), 
+    IpUtils::toIPAddress(apGateway.address), 
+    IpUtils::toIPAddress(apSubnet.address)
   );
 
   bool ret = WiFi.softAP(settings.getApSsid(deviceId), settings.getApPwd());
@@ -535,12 +828,12 @@ void activateApMode() {
  * SSID and Password.
  */
 void connectToNetwork() {
-  Serial.printf("\n\nConnecting to: %s...\n", settings.getSsid().c_str());
+  Serial.printf("\n\nConnecting to: %s...\n", settings.viewSsid().chars);
   
   WiFi.setOutputPower(20.5F);
   WiFi.setHostname(settings.getHostname(deviceId).c_str());
   WiFi.mode(WiFiMode::WIFI_STA);
-  WiFi.begin(settings.getSsid(), settings.getPwd());
+  WiFi.begin(settings.viewSsid().chars, settings.viewPwd().chars);
 
   while (WiFi.status() != WL_CONNECTED) { // Waiting for WiFi to connect...
     delay(500);
@@ -561,12 +854,22 @@ void initWeb() {
     Serial.println(F("Device is configured so WebService will not be started!"));
   } else {
     Serial.println(F("Initializing Web-Server..."));
-    #ifndef Secrets_h
+    #if defined(WEB_TLS_EC_CERT) && !defined(Secrets_h)
+      webServer.getServer().setECCert(new BearSSL::X509List(SAMPLE_SERVER_EC_CERT), BR_KEYTYPE_EC, new BearSSL::PrivateKey(SAMPLE_SERVER_EC_KEY));
+    #elif defined(WEB_TLS_EC_CERT)
+      webServer.getServer().setECCert(new BearSSL::X509List(server_ec_cert), BR_KEYTYPE_EC, new BearSSL::PrivateKey(server_ec_key));
+    #elif !defined(Secrets_h)
       webServer.getServer().setRSACert(new BearSSL::X509List(SAMPLE_SERVER_CERT), new BearSSL::PrivateKey(SAMPLE_SERVER_KEY));
     #else
       webServer.getServer().setRSACert(new BearSSL::X509List(server_cert), new BearSSL::PrivateKey(server_key));
     #endif
-    webServer.getServer().setCache(&serverCache);
+    serverSessionStore = new BearSSL::ServerSession[WEB_TLS_SESSIONS];
+    serverCache = new BearSSL::ServerSessions(serverSessionStore, WEB_TLS_SESSIONS);
+    webServer.getServer().setCache(serverCache);
+    handshakes.watch(serverSessionStore, WEB_TLS_SESSIONS);
+
+    const char* headerKeys[] = {"Accept-Encoding"};
+    webServer.collectHeaders(headerKeys, 1);
 
     /* Setup Endpoint Handlers */
     webServer.on(F("/"), endpointHandlerRoot);
@@ -590,6 +893,57 @@ void dumpDeviceInfo() {
     Serial.println(F("==================================\n"));
 }
 
+/**
+ * Lets the web server handle its clients. The server only accepts a new
+ * connection, doing its TLS handshake, when it has no client and one is
+ * waiting, so only those calls are timed. The handshake is reported to
+ * the Serial console along with how the session cache has been doing,
+ * which shows whether it does its job.
+*/
+void doHandleWebClients() {
+  bool isAccepting = (!webServer.client().connected() && webServer.getServer().hasClient());
+  if (!isAccepting) {
+    webServer.handleClient();
+
+    return;
+  }
+
+  handshakes.beginAccept();
+  webServer.handleClient();
+  if (handshakes.endAccept(webServer.client().connected())) {
+    Serial.printf(
+      "TLS handshake took %lu ms (cache hits: %lu, misses: %lu, resumed avg %lu ms, full avg %lu ms, slowest: %lu ms).\n",
+      handshakes.getLastMs(),
+      handshakes.getCacheHits(),
+      handshakes.getCacheMisses(),
+      handshakes.getAverageResumedMs(),
+      handshakes.getAverageFullMs(),
+      handshakes.getSlowestMs()
+    );
+  }
+}
+
+/**
+ * Reports the state of the heap to the Serial console. This is run
+ * periodically so that fragmentation building up over a long uptime
+ * can be spotted. How often the SMTP session was reused rather than
+ * connected again is reported along with it.
+*/
+void doReportHeap() {
+  Serial.printf(
+    "Heap: free=%u, largest block=%u, fragmentation=%u%%\n", 
+    ESP.getFreeHeap(), 
+    ESP.getMaxFreeBlockSize(), 
+    ESP.getHeapFragmentation()
+  );
+  Serial.printf(
+    "SMTP: connects=%lu, reuses=%lu, last connect=%lu ms\n",
+    mailLink.getConnectCount(),
+    mailLink.getReuseCount(),
+    mailLink.getLastConnectDuration()
+  );
+}
+
 /**
  * This function is used to Generate the HTML for a web page where the 
  * title, heading and content is provided to the function as a String 
@@ -601,19 +955,79 @@ void dumpDeviceInfo() {
  * @param content A reference to the main content of the page as String.
  */
 void sendHtmlPageUsingTemplate(int code, String title, String heading, String &content) {
-  String result = HTML_PAGE_TEMPLATE;
-  if (!result.reserve(3000U)) {
-    Serial.println(F("WARNING!!! Failed to reserve desired memory for webpage!"));
-  }
+  sendHtmlPage(code, title, heading, [&content](ChunkedOutput &out) { out.print(content); });
+}
 
-  result.replace("${title}", title);
-  result.replace("${heading}", heading);
-  result.replace("${content}", content);
+/**
+ * This function is used to send a web page where the template HTML is
+ * streamed to the client as it is rendered, with chunked transfer encoding,
+ * so the page is never built up in RAM. The template is split ahead of time
+ * in HtmlContent.h so nothing is searched for. The title and heading are filled
+ * in from the given Strings and the content is written by the given
+ * ContentWriter as the template reaches it. If the client accepts gzip, with
+ * a weight above 0, the page is sent gzipped, using the template segments
+ * compressed at build time in HtmlContentGz.h.
+ * 
+ * @param code The HTTP Code as int.
+ * @param title The page title as String.
+ * @param heading The page heading as String.
+ * @param contentWriter Writes the main content of the page as ContentWriter.
+ */
+void sendHtmlPage(int code, const String &title, const String &heading, ContentWriter contentWriter) {
+  const String &acceptEncoding = webServer.header(F("Accept-Encoding"));
+  bool isGzip = ParseUtils::acceptsEncoding(acceptEncoding.c_str(), acceptEncoding.length(), "gzip");
+  webServer.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  webServer.sendHeader(F("Vary"), F("Accept-Encoding"));
+  if (isGzip) {
+    webServer.sendHeader(F("Content-Encoding"), F("gzip"));
+  }
+  webServer.send(code, "text/html", emptyString);
 
-  webServer.send_P(code, "text/html", result.c_str());
+  if (isGzip) {
+    GzipOutput out(sendResponseChunk);
+    renderHtmlPage(out, title, heading, contentWriter);
+    out.end();
+  } else {
+    ChunkedOutput out(sendResponseChunk);
+    renderHtmlPage(out, title, heading, contentWriter);
+    out.end();
+  }
   yield();
 }
 
+/**
+ * Renders the page template to the given output, which may be plain or
+ * gzipped. The compressed segments are handed along either way and a
+ * plain output just ignores them.
+ * 
+ * @param out The output to render to as ChunkedOutput.
+ * @param title The page title as String.
+ * @param heading The page heading as String.
+ * @param contentWriter Writes the main content of the page as ContentWriter.
+ */
+void renderHtmlPage(ChunkedOutput &out, const String &title, const String &heading, ContentWriter contentWriter) {
+  HtmlRenderer::render(HTML_PAGE_PARTS, out, [&](uint8_t slot, ChunkedOutput &slotOut) {
+    if (slot == HS_TITLE) {
+      slotOut.print(title);
+    } else if (slot == HS_HEADING) {
+      slotOut.print(heading);
+    } else if (slot == HS_CONTENT) {
+      contentWriter(slotOut);
+    }
+  }, &HTML_PAGE_TEMPLATE_DEFLATED);
+}
+
+/**
+ * Sends a chunk of the response currently being streamed to the client. 
+ * A chunk with a length of 0 ends the response.
+ * 
+ * @param data The chunk as const char*.
+ * @param length The length of the chunk as size_t.
+ */
+void sendResponseChunk(const char* data, size_t length) {
+  webServer.sendContent(data, length);
+}
+
 /**
  * #### HANDLER - NOT FOUND ####
  * This is a function which is used to handle web requests when the requested resource is not valid.
@@ -640,10 +1054,13 @@ void fileUploadHandler() {
  * 
 */
 void endpointHandlerRoot() {
-  String content = ROOT_PAGE;
-  content.replace("${firmware_version}", String(FIRMWARE_VERSION));
-
-  sendHtmlPageUsingTemplate(200, F("Device Information"), F("Information"), content);
+  sendHtmlPage(200, F("Device Information"), F("Information"), [](ChunkedOutput &out) {
+    HtmlRenderer::render(ROOT_PAGE_PARTS, out, [](uint8_t slot, ChunkedOutput &slotOut) {
+      if (slot == HS_FIRMWARE_VERSION) {
+        slotOut.print(F(FIRMWARE_VERSION));
+      }
+    }, &ROOT_PAGE_DEFLATED);
+  });
 }
 
 /**
@@ -660,10 +1077,14 @@ void endpointHandlerAdmin() {
   }
   Serial.println(F("Client has been Authenticated."));
 
-  String content = ADMIN_PAGE;
-  content.replace("${settings}", getSettingsAsJson());
-    
-  sendHtmlPageUsingTemplate(200, F("Device Configuration Page"), F("Device Settings"), content);
+  sendHtmlPage(200, F("Device Configuration Page"), F("Device Settings"), [](ChunkedOutput &out) {
+    HtmlRenderer::render(ADMIN_PAGE_PARTS, out, [](uint8_t slot, ChunkedOutput &slotOut) {
+      if (slot == HS_SETTINGS) { // Goes in a textarea so must be escaped...
+        HtmlEscapedOutput escaped(slotOut);
+        settings.writeJson(escaped);
+      }
+    }, &ADMIN_PAGE_DEFLATED);
+  });
 }
 
 
@@ -677,271 +1098,33 @@ void endpointHandlerUpdate() {
   }
   Serial.println(F("Client has been Authenticated."));
 
-  String setts = webServer.arg("data");
-  setts.trim();
-  JsonDocument jDoc;
+  const String &data = webServer.arg("data");
+  const char* json = data.c_str();
+  size_t jsonLength = data.length();
+  SettingsUpdate::trimRange(json, jsonLength);
+
+  if (jsonLength > 0U) {
+    /* Only the settings are kept while parsing, anything else is skipped */
+    JsonDocument filter;
+    SettingsUpdate::buildFilter(filter);
 
-  if (!setts.isEmpty()) {
-    DeserializationError err = deserializeJson(jDoc, setts);
+    JsonDocument jDoc;
+    DeserializationError err = deserializeJson(jDoc, json, jsonLength, DeserializationOption::Filter(filter));
     if (err.code() != DeserializationError::Ok) { // Problem with incoming JSON...
       String errMsg = String("Deserialization of JSON settings failed: ") + err.c_str();
       Serial.println(errMsg);
       
       return sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), errMsg);
     } else { // JSON Seemed good...
-      /* ************ *
-       * UPDATE: ssid *
-       * ************ */
-      String ssid = jDoc["ssid"];
-      ssid.trim();
-      if (!ssid.isEmpty() && !ssid.equals(String(settings.getFactorySettings().ssid))) {
-        if (ssid.length() < 33U) {
-          settings.setSsid(ssid.c_str());
-        } else {
-          String msg = F("SSID must not be longer than 32 characters!");
-          Serial.println(msg);
-          
-          return sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), msg);
-        }
-      } else {
-        String msg = F("SSID is required for configuration!");
-        sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), msg);
+      NonVolatileSettings staged = {};
+      const __FlashStringHelper* problem = SettingsUpdate::stage(jDoc.as<JsonObjectConst>(), staged);
+      if (problem != nullptr) { // Something didn't validate, nothing has been changed...
+        String msg = problem;
         Serial.println(msg);
-        
-        return; 
-      }
 
-      /* *********** *
-       * UPDATE: pwd *
-       * *********** */
-      String pwd = jDoc["pwd"];
-      pwd.trim();
-      if (!pwd.isEmpty() && !pwd.equals(String(settings.getFactorySettings().pwd))) {
-        if (pwd.length() < 64U) {
-          settings.setPwd(pwd.c_str());
-        } else {
-          String msg = F("Pwd must not be longer than 63 characters!");
-          Serial.println(msg);
-          
-          return sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), msg);
-        }
-      } else {
-        String msg = F("Pwd is required for configuration!");
-        Serial.println(msg);
-        
-        return sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), msg);
-      }
-
-      /* ***************** *
-       * UPDATE: smtp_host * 
-       * ***************** */
-      String sHost = jDoc["smtp_host"];
-      sHost.trim();
-      if (!sHost.isEmpty() && !sHost.equals(String(settings.getFactorySettings().smtpHost))) {
-        if (sHost.length() < 121U) {
-          settings.setSmtpHost(sHost.c_str());
-        } else {
-          String msg = F("SMTP Host must not be longer than 120 characters!");
-          Serial.println(msg);
-          
-          return sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), msg);
-        }
-      } else {
-        String msg = F("SMTP Host is required for configuration!");
-        Serial.println(msg);
-        
-        return sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), msg);
-      }
-
-      /* ***************** *
-       * UPDATE: smtp_port *
-       * ***************** */
-      String sPort = jDoc["smtp_port"];
-      sPort.trim();
-      if (!sPort.isEmpty()) {
-        unsigned int p = sPort.toInt();
-        if (p > 0 && p <= 65535U) {
-          settings.setSmtpPort(p);
-        } else {
-          String msg = F("SMTP Port must be within valid port range!");
-          Serial.println(msg);
-          
-          return sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), msg);
-        }
-      } else {
-        String msg = F("SMTP Port is required for configuration!");
-        Serial.println(msg);
-        
-        return sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), msg);
-      }
-
-      /* ***************** *
-       * UPDATE: smtp_user *
-       * ***************** */
-      String sUser = jDoc["smtp_user"];
-      sUser.trim();
-      if (!sUser.isEmpty() && !sUser.equals(String(settings.getFactorySettings().smtpUser))) {
-        if (sUser.length() < 121U) {
-          settings.setSmtpUser(sUser.c_str());
-        } else {
-          String msg = F("SMTP User must be no longer than 120 characters in length!");
-          Serial.println(msg);
-          
-          return sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), msg);
-        }
-      } else {
-        String msg = F("SMTP User is required for configuration!");
-        Serial.println(msg);
-        return sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), msg);
-      }
-
-      /* **************** *
-       * UPDATE: smtp_pwd *
-       * **************** */
-      String smtpPwd = jDoc["smtp_pwd"];
-      smtpPwd.trim();
-      if (!smtpPwd.isEmpty() && !smtpPwd.equals(String(settings.getFactorySettings().smtpPwd))) {
-        if (smtpPwd.length() < 121U) {
-          settings.setSmtpPwd(smtpPwd.c_str());
-        } else {
-          String msg = F("SMTP Password must be no longer than 120 characters in length!");
-          Serial.println(msg);
-          
-          return sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), msg);
-        }
-      } else {
-        String msg = F("SMTP Password is required for configuration!");
-        Serial.println(msg);
-        
-        return sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), msg);
-      }
-
-      /* ***************** *
-       * UPDATE: from_name *
-       * ***************** */
-      String fName = jDoc["from_name"];
-      fName.trim();
-      if (!fName.isEmpty()) {
-        if (fName.length() < 51U) {
-          settings.setFromName(fName.c_str());
-        } else {
-          String msg = F("The 'From Name' must be no longer than 50 characters in length!");
-          Serial.println(msg);
-          
-          return sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), msg);
-        }
-      } else {
-        String msg = F("The 'From Name' is required for configuration!");
-        Serial.println(msg);
-        
-        return sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), msg);
-      }
-
-      /* ****************** *
-       * UPDATE: from_email *
-       * ****************** */
-      String fEmail = jDoc["from_email"];
-      fEmail.trim();
-      if (!fEmail.isEmpty()) {
-        if (fEmail.length() < 121U) {
-          settings.setFromEmail(fEmail.c_str());
-        } else {
-          String msg = F("The 'From Email' must be no longer than 120 characters in length!");
-          Serial.println(msg);
-          
-          return sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), msg);
-        }
-      } else {
-        String msg = F("The 'From Email' is required for configuration!");
-        Serial.println(msg);
-        
-        return sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), msg);
-      }
-
-      /* ************* *
-       * UPDATE: owner *
-       * ************* */
-      String owner = jDoc["owner"];
-      owner.trim();
-      if (!owner.isEmpty() && !owner.equals(String(settings.getFactorySettings().owner))) {
-        if (owner.length() < 101U) {
-          settings.setOwner(owner.c_str());
-        } else {
-          String msg = F("Owner must be no longer than 100 characters in length!");
-          Serial.println(msg);
-          
-          return sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), msg);
-        }
-      } else {
-        String msg = F("Owner is required for configuration!");
-        Serial.println(msg);
-        
-        return sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), msg);
-      }
-
-      /* *************** *
-       * UPDATE: message *
-       * *************** */
-      String msg = jDoc["message"];
-      msg.trim();
-      if (!msg.isEmpty()) {
-        if (msg.length() < 101U) {
-          settings.setMessage(msg.c_str());
-        } else {
-          String msg = F("Message must be no longer than 100 characters in length!");
-          Serial.println(msg);
-
-          return sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), msg);
-        }
-      } else {
-        String msg = F("Message is required for configuration!");
-        Serial.println(msg);
-        
-        return sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), msg);
-      }
-
-      /* ******************* *
-       * UPDATE: panic_level *
-       * ******************* */
-      String pLevel = jDoc["panic_level"];
-      pLevel.trim();
-      if (!pLevel.isEmpty()) {
-        int tmp = pLevel.toInt();
-        if (tmp > 0 && tmp <= 5) {
-          settings.setPanicLevel(tmp);
-        } else {
-          String msg = F("Panic Level must be greater than 0 and less than 6!");
-          Serial.println(msg);
-          
-          return sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), msg);
-        }
-      } else {
-        String msg = F("Panic Level is required for configuration!");
-        Serial.println(msg);
-        
-        return sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), msg);
-      }
-
-      /* ****************** *
-       * UPDATE: recipients *
-       * ****************** */
-      String recips = jDoc["recipients"];
-      recips.trim(); // To make check isBlank.
-      if (!recips.isEmpty() && !recips.equals(String(settings.getFactorySettings().recipients))) { // Something to there...
-        if (recips.length() < 510U) { // Will fit in memory...
-          settings.setRecipients(recips.c_str());
-        } else {
-          String msg = F("Recipients must be no longer than 509 characters in length!");
-          Serial.println(msg);
-          
-          return sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), msg);
-        }
-      } else {
-        String msg = F("Recipients are required for configuration!");
-        Serial.println(msg);
-        
         return sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), msg);
       }
+      settings.applyFields(staged, SETTING_EXPORTED);
       
       /* Save Settings to Flash */
       if (settings.saveSettings()) {
@@ -964,24 +1147,3 @@ void endpointHandlerUpdate() {
   endpointHandlerAdmin();
   // sendHtmlPageUsingTemplate(500, F("500 - Internal Server Error"), F("500 - Internal Server Error"), content);
 }
-
-String getSettingsAsJson() {
-  JsonDocument jDoc;
-  jDoc["ssid"] = settings.getSsid();
-  jDoc["pwd"] = settings.getPwd();
-  jDoc["smtp_host"] = settings.getSmtpHost();
-  jDoc["smtp_port"] = settings.getSmtpPort();
-  jDoc["smtp_user"] = settings.getSmtpUser();
-  jDoc["smtp_pwd"] = settings.getSmtpPwd();
-  jDoc["from_name"] = settings.getFromName();
-  jDoc["from_email"] = settings.getFromEmail();
-  jDoc["owner"] = settings.getOwner();
-  jDoc["message"] = settings.getMessage();
-  jDoc["panic_level"] = settings.getPanicLevel();
-  jDoc["recipients"] = settings.getRecipients();
-
-  String output;
-  serializeJsonPretty(jDoc, output);
-
-  return output;
-}
\ No newline at end of file
@@ -0,0 +1,172 @@
+/*
+ * Adafruit_SSD1306 - Stand-in for the SSD1306 driver together with a model
+ * of the panel on the other end of the I2C bus. The driver draws text into
+ * its frame buffer with made up 6x8 glyphs and display() sends the whole
+ * buffer the way the library does. The panel takes the page and column
+ * window commands and the data that follows into its own memory, so a test
+ * can check what actually reached the screen.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef Adafruit_SSD1306_h
+    #define Adafruit_SSD1306_h
+
+    #include <Arduino.h> // Comes in through Adafruit_GFX with the library
+    #include <Wire.h>
+
+    #define SSD1306_SWITCHCAPVCC 0x02
+    #define SSD1306_WHITE 1
+    #define SSD1306_COLUMNADDR 0x21
+    #define SSD1306_PAGEADDR 0x22
+
+    #define FAKE_PANEL_WIDTH 128
+    #define FAKE_PANEL_PAGES 4
+
+    // *****************************************************************************
+    // The display memory of a 128x32 panel and the window data is written into.
+    // *****************************************************************************
+    struct FakeSsd1306Panel {
+        uint8_t        memory           [FAKE_PANEL_PAGES * FAKE_PANEL_WIDTH];
+        uint8_t        pageStart                   ;
+        uint8_t        pageEnd                     ;
+        uint8_t        columnStart                 ;
+        uint8_t        columnEnd                   ;
+        uint8_t        page                        ;
+        uint8_t        column                      ;
+        unsigned long  dataBytes                   ;
+
+        void reset() {
+            memset(this, 0, sizeof(*this));
+            pageEnd = 7;
+            columnEnd = FAKE_PANEL_WIDTH - 1;
+        }
+
+        void command(const uint8_t* data, size_t length) {
+            for (size_t i = 0; i < length; i ++) {
+                if (data[i] == SSD1306_PAGEADDR && i + 2U < length) {
+                    pageStart = page = (data[i + 1] & 7U);
+                    pageEnd = (data[i + 2] & 7U);
+                    i += 2U;
+                } else if (data[i] == SSD1306_COLUMNADDR && i + 2U < length) {
+                    columnStart = column = (data[i + 1] & 0x7FU);
+                    columnEnd = (data[i + 2] & 0x7FU);
+                    i += 2U;
+                }
+            }
+        }
+
+        void write(const uint8_t* data, size_t length) {
+            for (size_t i = 0; i < length; i ++) {
+                if (page < FAKE_PANEL_PAGES) {
+                    memory[(page * FAKE_PANEL_WIDTH) + column] = data[i];
+                }
+                dataBytes ++;
+                if (column < columnEnd) {
+                    column ++;
+                } else {
+                    column = columnStart;
+                    page = (page < pageEnd) ? (page + 1) : pageStart;
+                }
+            }
+        }
+
+        static void receive(uint8_t address, const uint8_t* data, size_t length);
+    };
+
+    inline FakeSsd1306Panel fakePanel;
+
+    inline void FakeSsd1306Panel::receive(uint8_t address, const uint8_t* data, size_t length) {
+        if (address != 0x3C || length == 0U) {
+
+            return;
+        }
+        if (data[0] == 0x40) {
+            fakePanel.write(data + 1, length - 1U);
+        } else {
+            fakePanel.command(data + 1, length - 1U);
+        }
+    }
+
+    class Adafruit_SSD1306 : public Print {
+        private:
+            uint8_t buffer[FAKE_PANEL_PAGES * FAKE_PANEL_WIDTH];
+            TwoWire* wire;
+            uint32_t clock;
+            int16_t cursorX = 0;
+            int16_t cursorY = 0;
+
+            void drawGlyph(uint8_t c) {
+                uint8_t page = (uint8_t)(cursorY / 8);
+                for (int16_t x = 0; x < 6 && page < FAKE_PANEL_PAGES; x ++) {
+                    if ((cursorX + x) < FAKE_PANEL_WIDTH) {
+                        buffer[(page * FAKE_PANEL_WIDTH) + cursorX + x] = (x == 5 || c == ' ') ? 0U : (uint8_t)((c * 37U) + (x * 11U) + 1U);
+                    }
+                }
+            }
+
+        public:
+            Adafruit_SSD1306(uint8_t width, uint8_t height, TwoWire* wire, int8_t resetPin, uint32_t clockDuring, uint32_t clockAfter) {
+                (void)width;
+                (void)height;
+                (void)resetPin;
+                (void)clockAfter;
+                this->wire = wire;
+                clock = clockDuring;
+                memset(buffer, 0, sizeof(buffer));
+            }
+
+            bool begin(uint8_t vcc, uint8_t address) {
+                (void)vcc;
+                (void)address;
+                wire->setClock(clock);
+                wire->setReceiver(FakeSsd1306Panel::receive);
+                fakePanel.reset();
+
+                return true;
+            }
+
+            void setTextColor(uint16_t color) { (void)color; }
+            void cp437(bool isOn) { (void)isOn; }
+            void setTextSize(uint8_t size) { (void)size; }
+            void setCursor(int16_t x, int16_t y) { cursorX = x; cursorY = y; }
+            uint8_t* getBuffer() { return buffer; }
+
+            void clearDisplay() {
+                memset(buffer, 0, sizeof(buffer));
+            }
+
+            void display() {
+                const uint8_t window[] = {0x00, SSD1306_PAGEADDR, 0, 0xFF, SSD1306_COLUMNADDR, 0, FAKE_PANEL_WIDTH - 1};
+                wire->beginTransmission(0x3C);
+                wire->write(window, sizeof(window));
+                wire->endTransmission();
+                for (size_t sent = 0U; sent < sizeof(buffer); sent += (BUFFER_LENGTH - 1)) {
+                    size_t chunk = ((sizeof(buffer) - sent) < (BUFFER_LENGTH - 1)) ? (sizeof(buffer) - sent) : (BUFFER_LENGTH - 1);
+                    wire->beginTransmission(0x3C);
+                    wire->write((uint8_t)0x40);
+                    wire->write(buffer + sent, chunk);
+                    wire->endTransmission();
+                }
+            }
+
+            size_t write(uint8_t c) override {
+                if (c == '\n') {
+                    cursorX = 0;
+                    cursorY += 8;
+                } else if (c != '\r') {
+                    if ((cursorX + 6) > FAKE_PANEL_WIDTH) { // Wraps like the library does...
+                        cursorX = 0;
+                        cursorY += 8;
+                    }
+                    drawGlyph(c);
+                    cursorX += 6;
+                }
+
+                return 1U;
+            }
+            using Print::write;
+    };
+
+#endif
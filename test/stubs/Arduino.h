@@ -0,0 +1,74 @@
+/*
+ * Arduino - Stand-in for the parts of the Arduino core used by the
+ * libraries, so they can be built for the host by the native environment.
+ * Time comes from a fake clock which only moves when a test moves it, or
+ * when a stand-in simulates something taking time.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef Arduino_h
+    #define Arduino_h
+
+    #include <stdint.h>
+    #include <stddef.h>
+    #include <stdio.h>
+    #include <stdlib.h>
+    #include <string.h>
+    #include <math.h>
+    #include <ctype.h>
+    #include <pgmspace.h>
+    #include <WString.h>
+    #include <Print.h>
+    #include <HardwareSerial.h>
+    #include <Esp.h>
+    #include <MD5Builder.h>
+
+    #define IRAM_ATTR
+    #define LOW 0x0
+    #define HIGH 0x1
+    #define INPUT 0x00
+    #define OUTPUT 0x01
+
+    inline uint8_t fakePinLevels[17] = {};
+
+    inline unsigned long fakeMillis = 0UL;
+
+    inline unsigned long millis() {
+
+        return fakeMillis;
+    }
+
+    inline void delay(unsigned long ms) {
+        fakeMillis += ms;
+    }
+
+    inline void yield() {}
+
+    inline void pinMode(uint8_t pin, uint8_t mode) {
+        (void)pin;
+        (void)mode;
+    }
+
+    inline void digitalWrite(uint8_t pin, uint8_t level) {
+        if (pin < sizeof(fakePinLevels)) {
+            fakePinLevels[pin] = level;
+        }
+    }
+
+    inline char* utoa(unsigned int value, char* buffer, int base) {
+        (void)base; // Only base 10 is used
+        sprintf(buffer, "%u", value);
+
+        return buffer;
+    }
+
+    inline char* itoa(int value, char* buffer, int base) {
+        (void)base; // Only base 10 is used
+        sprintf(buffer, "%d", value);
+
+        return buffer;
+    }
+
+#endif
@@ -0,0 +1,85 @@
+/*
+ * BearSSLHelpers - Stand-in for the BearSSL session cache of the ESP8266
+ * core. Sessions are kept in the given store laid out the way BearSSL's
+ * LRU cache keeps them, 100 bytes each with the session ID and master
+ * secret first and the list links last. Saving writes a whole entry,
+ * dropping the oldest once full, while a lookup which finds its session
+ * only rewrites the links, as the LRU cache does when it moves the entry
+ * to the front.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef BearSSLHelpers_h
+    #define BearSSLHelpers_h
+
+    #include <stdint.h>
+    #include <stddef.h>
+    #include <string.h>
+
+    struct br_ssl_session_parameters {
+        unsigned char  session_id       [32]       ;
+        unsigned char  session_id_len              ;
+        uint16_t       version                     ;
+        uint16_t       cipher_suite                ;
+        unsigned char  master_secret    [48]       ;
+    };
+
+    namespace BearSSL {
+        typedef uint8_t ServerSession[100];
+
+        class ServerSessions {
+            private:
+                ServerSession* store;
+                uint32_t capacity;
+                bool isOwned;
+                uint32_t count = 0UL;
+                uint32_t next = 0UL;
+                uint32_t moves = 0UL;
+
+            public:
+                ServerSessions(uint32_t size) : ServerSessions(new ServerSession[size], size) { isOwned = true; }
+                ServerSessions(ServerSession* sessions, uint32_t size) : store(sessions), capacity(size), isOwned(false) {
+                    memset(store, 0, capacity * sizeof(ServerSession));
+                }
+                ~ServerSessions() {
+                    if (isOwned) {
+                        delete[] store;
+                    }
+                }
+
+                uint32_t size() { return capacity; }
+
+                // What the TLS server does with the cache during a handshake, for tests...
+                void serverSaves(const br_ssl_session_parameters &params) {
+                    uint8_t* entry = store[next];
+                    memcpy(entry, params.session_id, 32U);
+                    memcpy(entry + 32, params.master_secret, 48U);
+                    memcpy(entry + 80, &params.version, 2U);
+                    memcpy(entry + 82, &params.cipher_suite, 2U);
+                    memcpy(entry + 84, &moves, sizeof(moves)); // Links...
+                    next = (next + 1UL) % capacity;
+                    if (count < capacity) {
+                        count ++;
+                    }
+                }
+
+                bool serverLoads(br_ssl_session_parameters &params) {
+                    for (uint32_t i = 0UL; i < count; i ++) {
+                        uint8_t* entry = store[i];
+                        if (params.session_id_len == 32U && memcmp(entry, params.session_id, 32U) == 0) {
+                            memcpy(params.master_secret, entry + 32, 48U);
+                            moves ++;
+                            memcpy(entry + 84, &moves, sizeof(moves)); // Moved to the front...
+
+                            return true;
+                        }
+                    }
+
+                    return false;
+                }
+        };
+    }
+
+#endif
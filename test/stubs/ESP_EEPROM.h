@@ -0,0 +1,71 @@
+/*
+ * ESP_EEPROM - Stand-in for the ESP_EEPROM library, kept in RAM so that it
+ * outlives the objects of a test the way flash outlives a reboot. Like the
+ * library, nothing is found unless it was committed with the same size it 
+ * is begun with.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef ESP_EEPROM_h
+    #define ESP_EEPROM_h
+
+    #include <stdint.h>
+    #include <stddef.h>
+    #include <string.h>
+    #include <vector>
+
+    class EEPROMClass {
+        private:
+            std::vector<uint8_t> stored;
+            std::vector<uint8_t> buffer;
+            bool isStored = false;
+
+        public:
+            void begin(size_t size) {
+                buffer.assign(size, 0xFF);
+                if (isStored && stored.size() == size) {
+                    buffer = stored;
+                }
+            }
+
+            int percentUsed() { return (isStored && stored.size() == buffer.size()) ? 25 : -1; }
+
+            template <typename T> T &get(int address, T &value) {
+                memcpy(&value, buffer.data() + address, sizeof(T));
+
+                return value;
+            }
+
+            template <typename T> const T &put(int address, const T &value) {
+                memcpy(buffer.data() + address, &value, sizeof(T));
+
+                return value;
+            }
+
+            bool commit() {
+                stored = buffer;
+                isStored = true;
+
+                return true;
+            }
+
+            bool wipe() {
+                isStored = false;
+                stored.clear();
+
+                return true;
+            }
+
+            void end() { buffer.clear(); }
+
+            void clear() {
+                wipe();
+                buffer.clear();
+            }
+    };
+
+    inline EEPROMClass EEPROM;
+
+#endif
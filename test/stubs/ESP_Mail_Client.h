@@ -0,0 +1,80 @@
+/*
+ * ESP_Mail_Client - Stand-in for the SMTP session of the ESP Mail Client
+ * library. There is no network, instead it acts as a server which takes a
+ * set time on the fake clock to connect to and to answer a command, and 
+ * which drops a session once it has been idle too long. Like a real TCP 
+ * connection the client side only finds out about a drop when it next 
+ * sends something.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef ESP_Mail_Client_h
+    #define ESP_Mail_Client_h
+
+    #include <Arduino.h>
+
+    struct Session_Config {};
+
+    struct SMTP_Response {
+        int code;
+    };
+
+    typedef void (*smtpResponseCallback)(SMTP_Response);
+
+    class SMTPSession {
+        private:
+            bool isOpen = false;
+            unsigned long lastUse = 0UL;
+
+        public:
+            static inline unsigned long connectMs = 1500UL; // DNS, TCP, TLS and AUTH
+            static inline unsigned long commandMs = 60UL; // One round trip
+            static inline unsigned long idleTimeoutMs = 300000UL; // Server drops idle sessions
+            static inline bool isServerUp = true;
+            static inline unsigned long connects = 0UL;
+            static inline unsigned long commands = 0UL;
+
+            bool connect(Session_Config* config) {
+                (void)config;
+                connects ++;
+                fakeMillis += connectMs;
+                isOpen = isServerUp;
+                lastUse = fakeMillis;
+
+                return isOpen;
+            }
+
+            bool connected() { return isOpen; }
+            bool isAuthenticated() { return isOpen; }
+
+            bool closeSession() {
+                isOpen = false;
+
+                return true;
+            }
+
+            /**
+             * Sends a command over the session. The callback only hears back
+             * if the server still had the session open.
+            */
+            bool sendCustomCommand(const __FlashStringHelper* command, smtpResponseCallback callback) {
+                (void)command;
+                commands ++;
+                fakeMillis += commandMs;
+                if (!isOpen || !isServerUp || (fakeMillis - lastUse) > idleTimeoutMs) { // Dropped...
+                    isOpen = false;
+
+                    return false;
+                }
+                lastUse = fakeMillis;
+                if (callback != nullptr) {
+                    callback({250});
+                }
+
+                return true;
+            }
+    };
+
+#endif
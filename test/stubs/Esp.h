@@ -0,0 +1,119 @@
+/*
+ * Esp - Stand-in for the flash access of the ESP8266 core. The flash is
+ * kept in RAM and behaves like NOR flash: erasing sets a sector to 0xFF
+ * and writing can only clear bits. Power can be made to fail after a given
+ * number of writes and erases, for testing how stored data survives it.
+ * The write or erase the power fails during is only half done and nothing 
+ * after it happens, until the power is restored.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef Esp_h
+    #define Esp_h
+
+    #include <stdint.h>
+    #include <stddef.h>
+    #include <string.h>
+
+    #define FAKE_FLASH_SIZE 0x400000UL // 4MB, the same as the nodemcuv2
+    #define FAKE_FLASH_SECTOR_SIZE 4096UL
+
+    // Where the linker puts the EEPROM sector and the end of the filesystem, as
+    // offsets into flash, standing in for _EEPROM_start and _FS_end. These are
+    // for the 4MB layout with a 2MB filesystem and can be moved by a test.
+    inline uint32_t fakeEepromOffset = 0x3FB000UL;
+    inline uint32_t fakeFsEndOffset = 0x3FA000UL;
+
+    class EspClass {
+        private:
+            uint8_t flash[FAKE_FLASH_SIZE];
+            long operationsLeft = -1L; // Until power fails, -1 for never
+            unsigned long operationCount = 0UL;
+            unsigned long restartCount = 0UL;
+
+            /**
+             * @return Returns true if the next write or erase may happen,
+             * false once power has failed, and sets isTorn when power fails
+             * part way through this one.
+            */
+            bool startOperation(bool &isTorn) {
+                isTorn = false;
+                if (operationsLeft == 0L) {
+
+                    return false;
+                }
+                operationCount ++;
+                if (operationsLeft > 0L) {
+                    operationsLeft --;
+                    isTorn = (operationsLeft == 0L);
+                }
+
+                return true;
+            }
+
+        public:
+            EspClass() {
+                eraseAll();
+            }
+
+            void eraseAll() {
+                memset(flash, 0xFF, sizeof(flash));
+                operationsLeft = -1L;
+                operationCount = 0UL;
+            }
+
+            void losePowerAfter(long operations) { operationsLeft = operations; }
+            void restorePower() { operationsLeft = -1L; }
+            bool isPowerLost() { return operationsLeft == 0L; }
+            unsigned long getOperationCount() { return operationCount; }
+            uint8_t* getFlash() { return flash; }
+
+            bool flashEraseSector(uint32_t sector) {
+                bool isTorn;
+                if ((sector + 1UL) * FAKE_FLASH_SECTOR_SIZE > FAKE_FLASH_SIZE || !startOperation(isTorn)) {
+
+                    return false;
+                }
+                memset(flash + (sector * FAKE_FLASH_SECTOR_SIZE), 0xFF, isTorn ? (FAKE_FLASH_SECTOR_SIZE / 2UL) : FAKE_FLASH_SECTOR_SIZE);
+
+                return !isTorn;
+            }
+
+            bool flashWrite(uint32_t address, const uint32_t* data, size_t size) {
+                bool isTorn;
+                if ((address & 3UL) != 0UL || (size & 3U) != 0U || address + size > FAKE_FLASH_SIZE || !startOperation(isTorn)) {
+
+                    return false;
+                }
+                const uint8_t* bytes = (const uint8_t*)data;
+                size_t length = isTorn ? (size / 2U) : size;
+                for (size_t i = 0; i < length; i++) {
+                    flash[address + i] &= bytes[i];
+                }
+
+                return !isTorn;
+            }
+
+            bool flashRead(uint32_t address, uint32_t* data, size_t size) {
+                if ((address & 3UL) != 0UL || (size & 3U) != 0U || address + size > FAKE_FLASH_SIZE) {
+
+                    return false;
+                }
+                memcpy(data, flash + address, size);
+
+                return true;
+            }
+
+            void restart() { restartCount ++; }
+            unsigned long getRestartCount() { return restartCount; }
+
+            uint32_t getFreeHeap() { return 40000UL; }
+            uint32_t getMaxFreeBlockSize() { return 30000UL; }
+            uint8_t getHeapFragmentation() { return 0U; }
+    };
+
+    inline EspClass ESP;
+
+#endif
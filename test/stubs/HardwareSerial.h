@@ -0,0 +1,36 @@
+/*
+ * HardwareSerial - Stand-in for the Serial console, which throws away what
+ * is printed to it so test output stays readable. A test can have it kept
+ * in captured instead, to check what was reported.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef HardwareSerial_h
+    #define HardwareSerial_h
+
+    #include <string>
+    #include <Print.h>
+
+    class HardwareSerial : public Print {
+        public:
+            bool isCapturing = false;
+            std::string captured;
+
+            void begin(unsigned long baud) { (void)baud; }
+
+            size_t write(uint8_t c) override { return write(&c, 1U); }
+            size_t write(const uint8_t* data, size_t length) override {
+                if (isCapturing) {
+                    captured.append((const char*)data, length);
+                }
+
+                return length;
+            }
+            using Print::write;
+    };
+
+    inline HardwareSerial Serial;
+
+#endif
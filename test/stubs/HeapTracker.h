@@ -0,0 +1,73 @@
+/*
+ * HeapTracker - Replaces the global operator new and delete with ones which
+ * count what is allocated, so a test can check that something doesn't touch
+ * the heap or measure how much of it something takes. Each block carries
+ * its size in front of it so that what is freed can be taken off again.
+ * The largest block stands in for ESP.getMaxFreeBlockSize(), the block
+ * which must be free for the allocation to succeed on the device.
+ *
+ * The operators can only be defined once in a program, so only the test's
+ * own test_main.cpp may include this. They are kept out of line, as once
+ * inlined the compiler sees free() given a pointer from new and warns.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef HeapTracker_h
+    #define HeapTracker_h
+
+    #include <new>
+    #include <stddef.h>
+    #include <stdlib.h>
+
+    inline size_t heapInUse = 0U;
+    inline size_t heapPeak = 0U;
+    inline size_t largestBlock = 0U;
+    inline unsigned long allocationCount = 0UL;
+    inline unsigned long allocatedBytes = 0UL;
+
+    /**
+     * Starts a new measurement. The peak starts from what is in use now, so
+     * what a measurement took is the peak less heapInUse at the reset.
+    */
+    inline void resetHeapStats() {
+        heapPeak = heapInUse;
+        largestBlock = 0U;
+        allocationCount = 0UL;
+        allocatedBytes = 0UL;
+    }
+
+    __attribute__((noinline)) void* operator new(size_t size) {
+        size_t* block = (size_t*)malloc(sizeof(size_t) + size);
+        if (block == nullptr) {
+            throw std::bad_alloc();
+        }
+        *block = size;
+        allocationCount ++;
+        allocatedBytes += size;
+        heapInUse += size;
+        if (heapInUse > heapPeak) {
+            heapPeak = heapInUse;
+        }
+        if (size > largestBlock) {
+            largestBlock = size;
+        }
+
+        return (block + 1);
+    }
+
+    __attribute__((noinline)) void operator delete(void* block) noexcept {
+        if (block != nullptr) {
+            size_t* start = ((size_t*)block) - 1;
+            heapInUse -= *start;
+            free(start);
+        }
+    }
+
+    void operator delete(void* block, size_t size) noexcept {
+        (void)size;
+        operator delete(block);
+    }
+
+#endif
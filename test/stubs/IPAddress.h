@@ -0,0 +1,27 @@
+/*
+ * IPAddress - Stand-in for the Arduino IPAddress, just the four octets.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef IPAddress_h
+    #define IPAddress_h
+
+    #include <stdint.h>
+
+    class IPAddress {
+        private:
+            uint8_t octets[4];
+
+        public:
+            IPAddress() : octets{0U, 0U, 0U, 0U} {}
+            IPAddress(uint8_t first, uint8_t second, uint8_t third, uint8_t fourth) : octets{first, second, third, fourth} {}
+
+            uint8_t operator[](int index) const { return octets[index]; }
+            bool operator==(const IPAddress &other) const {
+                return octets[0] == other.octets[0] && octets[1] == other.octets[1] && octets[2] == other.octets[2] && octets[3] == other.octets[3];
+            }
+    };
+
+#endif
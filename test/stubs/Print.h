@@ -0,0 +1,63 @@
+/*
+ * Print - Stand-in for the Arduino Print, where everything printed ends up
+ * as calls to write.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef Print_h
+    #define Print_h
+
+    #include <stdarg.h>
+    #include <stdio.h>
+    #include <string.h>
+    #include <WString.h>
+
+    class Print {
+        public:
+            virtual ~Print() {}
+
+            virtual size_t write(uint8_t c) = 0;
+            virtual size_t write(const uint8_t* data, size_t length) {
+                size_t written = 0U;
+                while (written < length && write(data[written]) == 1U) {
+                    written ++;
+                }
+
+                return written;
+            }
+            virtual void flush() {}
+
+            size_t write(const char* text) { return (text == nullptr) ? 0U : write((const uint8_t*)text, strlen(text)); }
+            size_t write(const char* data, size_t length) { return write((const uint8_t*)data, length); }
+
+            size_t print(const char* text) { return write(text); }
+            size_t print(const __FlashStringHelper* text) { return write(reinterpret_cast<const char*>(text)); }
+            size_t print(const String &text) { return write((const uint8_t*)text.c_str(), text.length()); }
+            size_t print(char c) { return write((uint8_t)c); }
+            size_t print(int value) { return printf("%d", value); }
+            size_t print(unsigned int value) { return printf("%u", value); }
+            size_t print(long value) { return printf("%ld", value); }
+            size_t print(unsigned long value) { return printf("%lu", value); }
+            size_t print(double value) { return printf("%.2f", value); }
+
+            size_t println() { return write("\r\n"); }
+            template <typename T> size_t println(const T &value) { size_t n = print(value); return n + println(); }
+
+            size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+                char buffer[256];
+                va_list args;
+                va_start(args, format);
+                int length = vsnprintf(buffer, sizeof(buffer), format, args);
+                va_end(args);
+                if (length < 0) {
+
+                    return 0U;
+                }
+
+                return write((const uint8_t*)buffer, ((size_t)length < sizeof(buffer)) ? (size_t)length : (sizeof(buffer) - 1U));
+            }
+    };
+
+#endif
@@ -0,0 +1,95 @@
+/*
+ * WString - Stand-in for the Arduino String, built on std::string, with
+ * the members the libraries use. F() strings are plain strings here.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef WString_h
+    #define WString_h
+
+    #include <stdlib.h>
+    #include <string.h>
+    #include <ctype.h>
+    #include <string>
+
+    class __FlashStringHelper;
+    #define FPSTR(p) (reinterpret_cast<const __FlashStringHelper*>(p))
+    #define F(s) FPSTR(s)
+
+    class String {
+        private:
+            std::string text;
+
+        public:
+            String() {}
+            String(const char* chars) : text(chars == nullptr ? "" : chars) {}
+            String(const __FlashStringHelper* chars) : String(reinterpret_cast<const char*>(chars)) {}
+            String(const std::string &chars) : text(chars) {}
+            String(char c) : text(1, c) {}
+            explicit String(int value) : text(std::to_string(value)) {}
+            explicit String(unsigned int value) : text(std::to_string(value)) {}
+            explicit String(long value) : text(std::to_string(value)) {}
+            explicit String(unsigned long value) : text(std::to_string(value)) {}
+
+            const char* c_str() const { return text.c_str(); }
+            unsigned int length() const { return (unsigned int)text.length(); }
+            bool isEmpty() const { return text.empty(); }
+            bool reserve(unsigned int size) { text.reserve(size); return true; }
+            char charAt(unsigned int index) const { return (index < text.length()) ? text[index] : '\0'; }
+            char operator[](unsigned int index) const { return charAt(index); }
+            char* begin() { return &text[0]; }
+            char* end() { return &text[0] + text.length(); }
+            const char* begin() const { return text.c_str(); }
+            const char* end() const { return text.c_str() + text.length(); }
+
+            int indexOf(char c, unsigned int from = 0U) const { return found(text.find(c, from)); }
+            int indexOf(const String &s, unsigned int from = 0U) const { return found(text.find(s.text, from)); }
+            int lastIndexOf(char c) const { return found(text.rfind(c)); }
+            bool startsWith(const String &s) const { return text.compare(0, s.text.length(), s.text) == 0; }
+            bool endsWith(const String &s) const { return text.length() >= s.text.length() && text.compare(text.length() - s.text.length(), s.text.length(), s.text) == 0; }
+            bool equals(const String &s) const { return text == s.text; }
+
+            String substring(unsigned int from) const { return (from < text.length()) ? String(text.substr(from)) : String(); }
+            String substring(unsigned int from, unsigned int to) const { return (from < to && from < text.length()) ? String(text.substr(from, to - from)) : String(); }
+
+            bool concat(const String &s) { text += s.text; return true; }
+            bool concat(const char* s) { text += s; return true; }
+            bool concat(char c) { text += c; return true; }
+            bool concat(int value) { text += std::to_string(value); return true; }
+            bool concat(unsigned int value) { text += std::to_string(value); return true; }
+            bool concat(long value) { text += std::to_string(value); return true; }
+            bool concat(unsigned long value) { text += std::to_string(value); return true; }
+            template <typename T> String& operator+=(const T &value) { concat(value); return *this; }
+
+            void remove(unsigned int index) { if (index < text.length()) { text.erase(index); } }
+            void remove(unsigned int index, unsigned int count) { if (index < text.length()) { text.erase(index, count); } }
+            void replace(const String &find, const String &with) {
+                for (size_t at = text.find(find.text); !find.text.empty() && at != std::string::npos; at = text.find(find.text, at + with.text.length())) {
+                    text.replace(at, find.text.length(), with.text);
+                }
+            }
+            void trim() {
+                size_t first = text.find_first_not_of(" \t\r\n");
+                size_t last = text.find_last_not_of(" \t\r\n");
+                text = (first == std::string::npos) ? std::string() : text.substr(first, last - first + 1U);
+            }
+            void toUpperCase() { for (char &c : text) { c = (char)toupper((unsigned char)c); } }
+            void toLowerCase() { for (char &c : text) { c = (char)tolower((unsigned char)c); } }
+            long toInt() const { return atol(text.c_str()); }
+
+            bool operator==(const String &s) const { return text == s.text; }
+            bool operator==(const char* s) const { return text == s; }
+            bool operator!=(const String &s) const { return text != s.text; }
+            friend String operator+(const String &a, const String &b) { return String(a.text + b.text); }
+            friend String operator+(const String &a, const char* b) { return String(a.text + b); }
+            friend String operator+(const char* a, const String &b) { return String(a + b.text); }
+
+        private:
+            static int found(size_t at) { return (at == std::string::npos) ? -1 : (int)at; }
+    };
+
+    inline const String emptyString;
+
+#endif
@@ -0,0 +1,77 @@
+/*
+ * Wire - Stand-in for the I2C bus. Each transmission is timed as it would
+ * take on the wire, 9 clocks a byte with the address byte included, and
+ * that time is added up so a test can see how long a call held the loop.
+ * What is transmitted is passed on to the device listening on the bus.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef Wire_h
+    #define Wire_h
+
+    #include <stdint.h>
+    #include <stddef.h>
+
+    #define BUFFER_LENGTH 128
+
+    typedef void (*WireReceiver)(uint8_t address, const uint8_t* data, size_t length);
+
+    class TwoWire {
+        private:
+            uint8_t buffer[BUFFER_LENGTH];
+            size_t length = 0U;
+            uint8_t address = 0U;
+            uint32_t clock = 100000UL;
+            unsigned long long busyNanos = 0ULL;
+            unsigned long transmissions = 0UL;
+            WireReceiver receiver = nullptr;
+
+        public:
+            void begin() {}
+            void setClock(uint32_t frequency) { clock = frequency; }
+            void setReceiver(WireReceiver receiver) { this->receiver = receiver; }
+
+            void beginTransmission(uint8_t address) {
+                this->address = address;
+                length = 0U;
+            }
+
+            size_t write(uint8_t data) {
+                if (length >= BUFFER_LENGTH) {
+
+                    return 0U;
+                }
+                buffer[length ++] = data;
+
+                return 1U;
+            }
+
+            size_t write(const uint8_t* data, size_t count) {
+                size_t written = 0U;
+                while (written < count && write(data[written]) == 1U) {
+                    written ++;
+                }
+
+                return written;
+            }
+
+            uint8_t endTransmission() {
+                busyNanos += ((unsigned long long)(length + 1U) * 9ULL * 1000000000ULL) / clock;
+                transmissions ++;
+                if (receiver != nullptr) {
+                    receiver(address, buffer, length);
+                }
+                length = 0U;
+
+                return 0U;
+            }
+
+            unsigned long long getBusyNanos() { return busyNanos; }
+            unsigned long getTransmissions() { return transmissions; }
+    };
+
+    inline TwoWire Wire;
+
+#endif
@@ -0,0 +1,30 @@
+/*
+ * pgmspace - Stand-in for the PROGMEM helpers of the ESP8266 core. On the
+ * host flash and RAM are the same, so these just read memory.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#ifndef pgmspace_h
+    #define pgmspace_h
+
+    #include <stdint.h>
+    #include <string.h>
+
+    #define PROGMEM
+    #define PGM_P const char*
+    #define PSTR(s) (s)
+
+    #define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+    #define pgm_read_word(addr) (*(const uint16_t*)(addr))
+    #define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+
+    #define memcpy_P memcpy
+    #define strlen_P strlen
+    #define strcpy_P strcpy
+    #define strncpy_P strncpy
+    #define strcmp_P strcmp
+    #define strncmp_P strncmp
+
+#endif
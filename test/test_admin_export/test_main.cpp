@@ -0,0 +1,277 @@
+/*
+ * Tests of the settings JSON streamed, HTML escaped, into the admin page.
+ * Settings holding markup, quotes and control characters must come back
+ * unchanged when the textarea is read and the JSON parsed, as the browser
+ * and then the update endpoint do. The heap the page takes is measured
+ * for the rendering used before, a JsonDocument serialized into a String
+ * and replaced into copies of the templates, and for the streaming used
+ * now. The largest block stands in for ESP.getMaxFreeBlockSize(), as the
+ * page can only be built when a block that size is free.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include <unity.h>
+#include <HeapTracker.h>
+#include <string>
+#include <stdio.h>
+#include <Settings.h>
+#include <SettingsUpdate.h>
+#include <HtmlRenderer.h>
+#include <HtmlContent.h>
+#include <HtmlEscapedOutput.h>
+
+static Settings* settings = nullptr;
+static std::string rendered;
+static size_t renderedLength = 0U;
+static bool isKeepingPage = true;
+
+static void collect(const char* data, size_t length) {
+    renderedLength += length;
+    if (isKeepingPage) {
+        rendered.append(data, length);
+    }
+}
+
+/**
+ * A Print which keeps what is written to it in a String, the way the JSON
+ * was serialized into a String before.
+*/
+class StringOutput : public Print {
+    public:
+        String text;
+
+        size_t write(uint8_t c) override {
+            text += (char)c;
+
+            return 1U;
+        }
+};
+
+/**
+ * Gives every exported setting a valid value, with the owner and message
+ * holding what has to be escaped for both JSON and HTML.
+*/
+static void setTrickyValues(Settings &target) {
+    target.setSsid("The-Neighbourhood-Network");
+    target.setPwd("p&ss\"word'<>");
+    target.setOwner("Pat </textarea><script>alert(\"x\")</script> & 'Sons'");
+    target.setMessage("Help!\n\tBack door \\ side gate\x01\b\f\r now");
+    target.setSmtpHost("smtp.mail-provider.example.com");
+    target.setSmtpPort(465U);
+    target.setSmtpUser("panic-button@mail-provider.example.com");
+    target.setSmtpPwd("an-smtp-app-password-of-some-length");
+    target.setFromEmail("panic-button@mail-provider.example.com");
+    target.setFromName("FriendlyNeighbor PanicButton");
+    target.setRecipients("first.person@example.com;second.person@example.com");
+    target.setPanicLevel(4);
+}
+
+/**
+ * Renders the admin page the way the admin endpoint does, with the JSON
+ * streamed through HtmlEscapedOutput into the textarea.
+*/
+static void renderAdminPage() {
+    ChunkedOutput out(collect);
+    HtmlRenderer::render(HTML_PAGE_PARTS, out, [](uint8_t slot, ChunkedOutput &slotOut) {
+        if (slot == HS_TITLE) {
+            slotOut.print(F("Device Configuration Page"));
+        } else if (slot == HS_HEADING) {
+            slotOut.print(F("Device Settings"));
+        } else if (slot == HS_CONTENT) {
+            HtmlRenderer::render(ADMIN_PAGE_PARTS, slotOut, [](uint8_t contentSlot, ChunkedOutput &contentOut) {
+                if (contentSlot == HS_SETTINGS) {
+                    HtmlEscapedOutput escaped(contentOut);
+                    settings->writeJson(escaped);
+                }
+            });
+        }
+    });
+    out.end();
+}
+
+/**
+ * The admin page as it was rendered before. The String copies from the
+ * getters stand in for the JsonDocument holding them, whose own pool is
+ * not counted here, so this is the least the page took.
+ *
+ * @return Returns the length of the page as size_t.
+*/
+static size_t renderLegacyAdminPage() {
+    String values[] = {
+        settings->getSsid(), settings->getPwd(), settings->getSmtpHost(), settings->getSmtpUser(), settings->getSmtpPwd(),
+        settings->getFromName(), settings->getFromEmail(), settings->getOwner(), settings->getMessage(), settings->getRecipients()
+    };
+    StringOutput json; // What serializeJsonPretty gave...
+    settings->writeJson(json);
+
+    String content = ADMIN_PAGE;
+    content.replace("${settings}", json.text);
+    String result = HTML_PAGE_TEMPLATE;
+    result.reserve(3000U);
+    result.replace("${title}", String("Device Configuration Page"));
+    result.replace("${heading}", String("Device Settings"));
+    result.replace("${content}", content);
+
+    return result.length();
+}
+
+/**
+ * @return Returns the text between the textarea tags of the page, with
+ * the HTML entities decoded the way the browser does, as std::string.
+*/
+static std::string readTextarea(const std::string &page) {
+    size_t start = page.find("<textarea");
+    TEST_ASSERT_TRUE(start != std::string::npos);
+    start = page.find('>', start) + 1U;
+    size_t end = page.find("</textarea>", start);
+    TEST_ASSERT_TRUE(end != std::string::npos);
+    TEST_ASSERT_EQUAL_UINT32(page.rfind("</textarea>"), end); // Only the real one...
+
+    const char* ENTITIES[][2] = {{"&amp;", "&"}, {"&lt;", "<"}, {"&gt;", ">"}, {"&quot;", "\""}, {"&#39;", "'"}};
+    std::string text;
+    for (size_t i = start; i < end; ) {
+        bool isEntity = false;
+        for (const auto &entity : ENTITIES) {
+            size_t length = strlen(entity[0]);
+            if (page.compare(i, length, entity[0]) == 0) {
+                text += entity[1];
+                i += length;
+                isEntity = true;
+                break;
+            }
+        }
+        if (!isEntity) {
+            TEST_ASSERT_TRUE_MESSAGE(page[i] != '<' && page[i] != '>' && page[i] != '"', "Unescaped markup in the textarea");
+            text += page[i ++];
+        }
+    }
+
+    return text;
+}
+
+void setUp() {
+    ESP.restorePower();
+    ESP.eraseAll();
+    EEPROM.clear();
+    settings = new Settings();
+    setTrickyValues(*settings);
+    rendered.clear();
+    renderedLength = 0U;
+    isKeepingPage = true;
+}
+
+void tearDown() {
+    delete settings;
+}
+
+void test_json_export_lists_the_exported_settings_in_order() {
+    StringOutput json;
+    settings->writeJson(json);
+    std::string text = json.text.c_str();
+
+    TEST_ASSERT_EQUAL_UINT8('{', text.front());
+    TEST_ASSERT_EQUAL_STRING("\n}", text.substr(text.length() - 2U).c_str());
+    SettingField field;
+    size_t last = 0U;
+    for (uint8_t i = 0; i < SETTING_FIELD_COUNT; i ++) {
+        Settings::readField(i, field);
+        std::string key = std::string("\n  \"") + ((field.key == nullptr) ? "" : field.key) + "\": "; // None for internal fields...
+        size_t at = text.find(key);
+        if (field.flags & SETTING_EXPORTED) {
+            TEST_ASSERT_TRUE_MESSAGE(at != std::string::npos && at > last, key.c_str());
+            last = at;
+        } else {
+            TEST_ASSERT_TRUE_MESSAGE(at == std::string::npos, key.c_str());
+        }
+    }
+    TEST_ASSERT_TRUE(text.find("\"smtp_port\": 465") != std::string::npos);
+    TEST_ASSERT_TRUE(text.find("\"message\": \"Help!\\n\\tBack door \\\\ side gate\\u0001\\b\\f\\r now\"") != std::string::npos);
+}
+
+void test_textarea_holds_no_markup_from_the_settings() {
+    renderAdminPage();
+
+    TEST_ASSERT_TRUE(rendered.find("<script>") == std::string::npos);
+    TEST_ASSERT_TRUE(rendered.find("Pat &lt;/textarea&gt;&lt;script&gt;alert(\\&quot;x\\&quot;)&lt;/script&gt; &amp; &#39;Sons&#39;") != std::string::npos);
+    readTextarea(rendered);
+}
+
+void test_textarea_round_trips_through_the_update() {
+    renderAdminPage();
+    std::string json = readTextarea(rendered);
+
+    JsonDocument filter;
+    SettingsUpdate::buildFilter(filter);
+    JsonDocument doc;
+    DeserializationError err = deserializeJson(doc, json.c_str(), json.length(), DeserializationOption::Filter(filter));
+    TEST_ASSERT_TRUE_MESSAGE(err.code() == DeserializationError::Ok, json.c_str());
+    NonVolatileSettings staged = {};
+    const __FlashStringHelper* problem = SettingsUpdate::stage(doc.as<JsonObjectConst>(), staged);
+    TEST_ASSERT_NULL(problem);
+
+    SettingField field;
+    for (uint8_t i = 0; i < SETTING_FIELD_COUNT; i ++) {
+        Settings::readField(i, field);
+        if (!(field.flags & SETTING_EXPORTED)) {
+            continue;
+        }
+        if (field.type == SETTING_TYPE_TEXT) {
+            SettingView view = settings->viewField(field);
+            std::string expected(view.chars, view.length);
+            std::string actual = Settings::textOf(staged, field);
+            TEST_ASSERT_EQUAL_STRING_MESSAGE(expected.c_str(), actual.c_str(), field.key);
+        } else {
+            TEST_ASSERT_EQUAL_INT32_MESSAGE(settings->getFieldNumber(field), Settings::readNumber(staged, field), field.key);
+        }
+    }
+}
+
+void test_streamed_admin_page_takes_no_heap() {
+    isKeepingPage = false;
+    resetHeapStats();
+    renderAdminPage();
+
+    TEST_ASSERT_GREATER_THAN(CHUNKED_OUTPUT_SIZE, renderedLength);
+    TEST_ASSERT_EQUAL_UINT32(0UL, allocationCount);
+    TEST_ASSERT_EQUAL_UINT32(heapInUse, heapPeak);
+    TEST_ASSERT_EQUAL_UINT32(0U, largestBlock);
+}
+
+void test_heap_before_and_after() {
+    resetHeapStats();
+    size_t legacyBase = heapInUse;
+    size_t legacyLength = renderLegacyAdminPage();
+    size_t legacyPeak = heapPeak - legacyBase;
+    size_t legacyLargest = largestBlock;
+    unsigned long legacyAllocations = allocationCount;
+
+    isKeepingPage = false;
+    resetHeapStats();
+    size_t streamedBase = heapInUse;
+    renderAdminPage();
+    size_t streamedPeak = heapPeak - streamedBase;
+
+    char report[192];
+    snprintf(report, sizeof(report), "Before: %u byte page, %u B peak heap, %u B largest block, %lu allocations", (unsigned)legacyLength, (unsigned)legacyPeak, (unsigned)legacyLargest, legacyAllocations);
+    TEST_MESSAGE(report);
+    snprintf(report, sizeof(report), "After: %u byte page, %u B peak heap, %u B largest block, %lu allocations", (unsigned)renderedLength, (unsigned)streamedPeak, (unsigned)largestBlock, allocationCount);
+    TEST_MESSAGE(report);
+
+    TEST_ASSERT_GREATER_OR_EQUAL(legacyLength, legacyLargest); // Needed the whole page in one block...
+    TEST_ASSERT_GREATER_OR_EQUAL(2U * legacyLength, legacyPeak);
+    TEST_ASSERT_EQUAL_UINT32(0U, streamedPeak);
+    TEST_ASSERT_EQUAL_UINT32(0U, largestBlock);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_json_export_lists_the_exported_settings_in_order);
+    RUN_TEST(test_textarea_holds_no_markup_from_the_settings);
+    RUN_TEST(test_textarea_round_trips_through_the_update);
+    RUN_TEST(test_streamed_admin_page_takes_no_heap);
+    RUN_TEST(test_heap_before_and_after);
+
+    return UNITY_END();
+}
@@ -0,0 +1,279 @@
+/*
+ * Tests of the AlertDispatcher, driven by a fake clock and a fake sender
+ * which records every send and fails the recipients it is told to. Covers
+ * the retry backoff timing, a cancel skipping recipients still pending,
+ * a full queue making room for a cancel and the partial send being seen
+ * from the completed job, the way onAlertJobComplete does it.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include <unity.h>
+#include <AlertDispatcher.h>
+
+struct SentMessage {
+    MessageType type;
+    uint8_t recipient;
+    unsigned long at;
+};
+
+struct CompletedJob {
+    AlertJob job;
+    uint8_t sentCount;
+    uint8_t failedCount;
+};
+
+static unsigned long fakeNow = 0UL;
+static uint32_t failingMask = 0UL;
+static SentMessage sends[64];
+static uint8_t sendCount = 0U;
+static CompletedJob completed[8];
+static uint8_t completedCount = 0U;
+
+static unsigned long fakeClock() {
+
+    return fakeNow;
+}
+
+static bool fakeSender(MessageType type, uint8_t recipient) {
+    sends[sendCount ++ & 63U] = {type, recipient, fakeNow};
+
+    return ((failingMask & (1UL << recipient)) == 0UL);
+}
+
+static void recordCompletion(AlertJob &job, uint8_t sentCount, uint8_t failedCount) {
+    completed[completedCount ++ & 7U] = {job, sentCount, failedCount};
+}
+
+/**
+ * Steps the dispatcher until it has no more to do at the current time.
+*/
+static void stepUntilWaiting(AlertDispatcher &alerts) {
+    for (int i = 0; i < 64 && !alerts.isIdle(); i ++) {
+        uint8_t sendsBefore = sendCount;
+        uint8_t completedBefore = completedCount;
+        alerts.step();
+        if (sendCount == sendsBefore && completedCount == completedBefore) { // Waiting to retry...
+            break;
+        }
+    }
+}
+
+void setUp() {
+    fakeNow = 0UL;
+    failingMask = 0UL;
+    sendCount = 0U;
+    completedCount = 0U;
+}
+
+void tearDown() {}
+
+void test_one_recipient_per_step_in_order() {
+    AlertDispatcher alerts(fakeSender, fakeClock);
+    alerts.onJobComplete(recordCompletion);
+    alerts.setRecipientCount(3U);
+    TEST_ASSERT_TRUE(alerts.enqueue(MT_ALERT));
+
+    for (uint8_t i = 0U; i < 3U; i ++) {
+        alerts.step();
+        TEST_ASSERT_EQUAL_UINT8(i + 1U, sendCount);
+        TEST_ASSERT_EQUAL_UINT8(i, sends[i].recipient);
+    }
+    TEST_ASSERT_EQUAL_UINT8(0U, completedCount);
+    alerts.step(); // Nothing left pending...
+
+    TEST_ASSERT_EQUAL_UINT8(1U, completedCount);
+    TEST_ASSERT_EQUAL_UINT8(3U, completed[0].sentCount);
+    TEST_ASSERT_EQUAL_UINT8(0U, completed[0].failedCount);
+    TEST_ASSERT_TRUE(alerts.isIdle());
+}
+
+void test_retries_back_off_then_fail() {
+    AlertDispatcher alerts(fakeSender, fakeClock);
+    alerts.onJobComplete(recordCompletion);
+    alerts.setRecipientCount(1U);
+    failingMask = 0x01UL;
+    fakeNow = 1000UL;
+    alerts.enqueue(MT_ALERT);
+
+    alerts.step();
+    TEST_ASSERT_EQUAL_UINT8(1U, sendCount);
+    fakeNow = 1000UL + ALERT_RETRY_BASE_MS - 1UL;
+    alerts.step();
+    TEST_ASSERT_EQUAL_UINT8(1U, sendCount); // Not yet...
+    fakeNow = 1000UL + ALERT_RETRY_BASE_MS;
+    alerts.step();
+    TEST_ASSERT_EQUAL_UINT8(2U, sendCount);
+
+    unsigned long second = fakeNow;
+    fakeNow = second + (2UL * ALERT_RETRY_BASE_MS) - 1UL; // Twice as long...
+    alerts.step();
+    TEST_ASSERT_EQUAL_UINT8(2U, sendCount);
+    fakeNow = second + (2UL * ALERT_RETRY_BASE_MS);
+    alerts.step();
+    TEST_ASSERT_EQUAL_UINT8(ALERT_MAX_ATTEMPTS, sendCount);
+    TEST_ASSERT_EQUAL_UINT8(0U, completedCount);
+
+    fakeNow += 60000UL;
+    alerts.step(); // Given up, no more attempts...
+
+    TEST_ASSERT_EQUAL_UINT8(ALERT_MAX_ATTEMPTS, sendCount);
+    TEST_ASSERT_EQUAL_UINT8(1U, completedCount);
+    TEST_ASSERT_EQUAL_UINT8(0U, completed[0].sentCount);
+    TEST_ASSERT_EQUAL_UINT8(1U, completed[0].failedCount);
+    TEST_ASSERT_EQUAL_HEX32(0x01UL, AlertDispatcher::maskOf(completed[0].job, RS_FAILED));
+}
+
+void test_waiting_retry_does_not_hold_up_other_recipients() {
+    AlertDispatcher alerts(fakeSender, fakeClock);
+    alerts.onJobComplete(recordCompletion);
+    alerts.setRecipientCount(2U);
+    failingMask = 0x01UL;
+    alerts.enqueue(MT_ALERT);
+
+    alerts.step();
+    alerts.step();
+    TEST_ASSERT_EQUAL_UINT8(2U, sendCount);
+    TEST_ASSERT_EQUAL_UINT8(1U, sends[1].recipient); // Sent while the first waits...
+    failingMask = 0UL;
+    fakeNow = ALERT_RETRY_BASE_MS;
+    stepUntilWaiting(alerts);
+
+    TEST_ASSERT_EQUAL_UINT8(3U, sendCount);
+    TEST_ASSERT_EQUAL_UINT8(1U, completedCount);
+    TEST_ASSERT_EQUAL_UINT8(2U, completed[0].sentCount);
+}
+
+void test_cancel_skips_pending_recipients() {
+    AlertDispatcher alerts(fakeSender, fakeClock);
+    alerts.onJobComplete(recordCompletion);
+    alerts.setRecipientCount(3U);
+    alerts.enqueue(MT_ALERT);
+    alerts.step(); // First recipient alerted...
+    alerts.enqueue(MT_ALERT); // Queued behind it...
+    TEST_ASSERT_TRUE(alerts.enqueue(MT_CANCEL));
+    stepUntilWaiting(alerts);
+
+    TEST_ASSERT_TRUE(alerts.isIdle());
+    TEST_ASSERT_EQUAL_UINT8(3U, completedCount);
+    TEST_ASSERT_EQUAL_UINT8(1U, completed[0].sentCount);
+    TEST_ASSERT_EQUAL_HEX32(0x06UL, AlertDispatcher::maskOf(completed[0].job, RS_SKIPPED));
+    TEST_ASSERT_EQUAL_UINT8(0U, completed[1].sentCount);
+    TEST_ASSERT_EQUAL_HEX32(0x07UL, AlertDispatcher::maskOf(completed[1].job, RS_SKIPPED));
+    TEST_ASSERT_EQUAL_INT(MT_CANCEL, completed[2].job.type);
+    TEST_ASSERT_EQUAL_UINT8(3U, completed[2].sentCount);
+    TEST_ASSERT_EQUAL_UINT8(4U, sendCount); // One alert, then three cancels...
+    for (uint8_t i = 1U; i < 4U; i ++) {
+        TEST_ASSERT_EQUAL_INT(MT_CANCEL, sends[i].type);
+    }
+}
+
+void test_cancel_skips_recipients_waiting_to_retry() {
+    AlertDispatcher alerts(fakeSender, fakeClock);
+    alerts.onJobComplete(recordCompletion);
+    alerts.setRecipientCount(1U);
+    failingMask = 0x01UL;
+    alerts.enqueue(MT_ALERT);
+    alerts.step();
+    alerts.enqueue(MT_CANCEL);
+    failingMask = 0UL;
+    stepUntilWaiting(alerts);
+
+    TEST_ASSERT_EQUAL_UINT8(2U, completedCount);
+    TEST_ASSERT_EQUAL_UINT8(0U, completed[0].failedCount); // Skipped, not failed...
+    TEST_ASSERT_EQUAL_HEX32(0x01UL, AlertDispatcher::maskOf(completed[0].job, RS_SKIPPED));
+    TEST_ASSERT_EQUAL_UINT8(2U, sendCount);
+    TEST_ASSERT_EQUAL_UINT32(0UL, sends[1].at); // Cancel didn't wait out the backoff...
+}
+
+void test_full_queue_makes_room_for_a_cancel() {
+    AlertDispatcher alerts(fakeSender, fakeClock);
+    alerts.onJobComplete(recordCompletion);
+    alerts.setRecipientCount(2U);
+    TEST_ASSERT_TRUE(alerts.enqueue(MT_ALERT));
+    alerts.step(); // Oldest is part way through...
+    TEST_ASSERT_TRUE(alerts.enqueue(MT_PARTIAL));
+    TEST_ASSERT_TRUE(alerts.enqueue(MT_CANCEL));
+    TEST_ASSERT_TRUE(alerts.enqueue(MT_ALERT));
+    TEST_ASSERT_FALSE(alerts.enqueue(MT_ALERT)); // Full...
+
+    TEST_ASSERT_TRUE(alerts.enqueue(MT_CANCEL));
+    TEST_ASSERT_FALSE(alerts.isQueued(MT_PARTIAL));
+    stepUntilWaiting(alerts);
+
+    TEST_ASSERT_EQUAL_UINT8(3U, completedCount); // Dropped jobs aren't reported...
+    TEST_ASSERT_EQUAL_INT(MT_ALERT, completed[0].job.type);
+    TEST_ASSERT_EQUAL_UINT8(1U, completed[0].sentCount);
+    TEST_ASSERT_EQUAL_INT(MT_CANCEL, completed[1].job.type);
+    TEST_ASSERT_EQUAL_INT(MT_CANCEL, completed[2].job.type);
+}
+
+void test_full_queue_of_cancels_keeps_the_oldest_and_the_new() {
+    AlertDispatcher alerts(fakeSender, fakeClock);
+    alerts.onJobComplete(recordCompletion);
+    alerts.setRecipientCount(1U);
+    alerts.enqueue(MT_ALERT);
+    for (int i = 0; i < ALERT_QUEUE_SIZE - 1; i ++) {
+        TEST_ASSERT_TRUE(alerts.enqueue(MT_CANCEL));
+    }
+
+    TEST_ASSERT_TRUE(alerts.enqueue(MT_CANCEL));
+    stepUntilWaiting(alerts);
+
+    TEST_ASSERT_EQUAL_UINT8(2U, completedCount);
+    TEST_ASSERT_EQUAL_INT(MT_ALERT, completed[0].job.type);
+    TEST_ASSERT_EQUAL_INT(MT_CANCEL, completed[1].job.type);
+}
+
+void test_partial_send_is_seen_from_the_completed_job() {
+    AlertDispatcher alerts(fakeSender, fakeClock);
+    alerts.onJobComplete(recordCompletion);
+    alerts.setRecipientCount(3U);
+    failingMask = 0x02UL;
+    alerts.enqueue(MT_ALERT);
+    for (int i = 0; i < ALERT_MAX_ATTEMPTS; i ++) {
+        stepUntilWaiting(alerts);
+        fakeNow += ALERT_RETRY_BASE_MS << i;
+    }
+    stepUntilWaiting(alerts);
+
+    TEST_ASSERT_EQUAL_UINT8(1U, completedCount);
+    TEST_ASSERT_EQUAL_UINT8(2U, completed[0].sentCount);
+    TEST_ASSERT_EQUAL_UINT8(1U, completed[0].failedCount);
+    uint32_t sentMask = AlertDispatcher::maskOf(completed[0].job, RS_SENT);
+    TEST_ASSERT_EQUAL_HEX32(0x05UL, sentMask);
+
+    TEST_ASSERT_TRUE(alerts.enqueue(MT_PARTIAL, sentMask)); // Only to those alerted...
+    failingMask = 0UL;
+    sendCount = 0U;
+    stepUntilWaiting(alerts);
+
+    TEST_ASSERT_EQUAL_UINT8(2U, sendCount);
+    TEST_ASSERT_EQUAL_UINT8(0U, sends[0].recipient);
+    TEST_ASSERT_EQUAL_UINT8(2U, sends[1].recipient);
+    TEST_ASSERT_EQUAL_INT(MT_PARTIAL, sends[1].type);
+}
+
+void test_recipient_count_is_capped() {
+    AlertDispatcher alerts(fakeSender, fakeClock);
+
+    TEST_ASSERT_TRUE(alerts.setRecipientCount(SETTINGS_MAX_RECIPIENTS));
+    TEST_ASSERT_FALSE(alerts.setRecipientCount(SETTINGS_MAX_RECIPIENTS + 1U));
+    TEST_ASSERT_EQUAL_UINT8(SETTINGS_MAX_RECIPIENTS, alerts.getRecipientCount());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_one_recipient_per_step_in_order);
+    RUN_TEST(test_retries_back_off_then_fail);
+    RUN_TEST(test_waiting_retry_does_not_hold_up_other_recipients);
+    RUN_TEST(test_cancel_skips_pending_recipients);
+    RUN_TEST(test_cancel_skips_recipients_waiting_to_retry);
+    RUN_TEST(test_full_queue_makes_room_for_a_cancel);
+    RUN_TEST(test_full_queue_of_cancels_keeps_the_oldest_and_the_new);
+    RUN_TEST(test_partial_send_is_seen_from_the_completed_job);
+    RUN_TEST(test_recipient_count_is_capped);
+
+    return UNITY_END();
+}
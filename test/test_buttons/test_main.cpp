@@ -0,0 +1,134 @@
+/*
+ * Tests of the ButtonMonitor, fed synthetic edges the way the pin change
+ * interrupts would give them, including bounces and edges which wait in
+ * the queue while the main loop is busy.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include <unity.h>
+#include <ButtonMonitor.h>
+
+#define DEBOUNCE_MS 20UL
+#define LONG_PRESS_MS 1000UL
+
+static ButtonMonitor monitor(DEBOUNCE_MS, LONG_PRESS_MS);
+
+/**
+ * Takes the next event and checks it is the expected one.
+*/
+static void expectEvent(ButtonEventType type, uint8_t button, uint32_t timestamp) {
+    ButtonEvent event;
+    TEST_ASSERT_TRUE_MESSAGE(monitor.pollEvent(event), "missing event");
+    TEST_ASSERT_EQUAL_INT(type, event.type);
+    if (type != BE_CHORD) {
+        TEST_ASSERT_EQUAL_UINT8(button, event.button);
+    }
+    TEST_ASSERT_EQUAL_UINT32(timestamp, event.timestamp);
+}
+
+static void expectNoEvent() {
+    ButtonEvent event;
+    TEST_ASSERT_FALSE_MESSAGE(monitor.pollEvent(event), "unexpected event");
+}
+
+void setUp() {
+    monitor.begin(false, false);
+}
+
+void tearDown() {}
+
+void test_clean_press_and_release() {
+    monitor.pushEdge(BTN_PANIC, true, 100UL);
+    monitor.update(110UL);
+    expectNoEvent(); // Not held long enough yet...
+    monitor.update(120UL);
+    expectEvent(BE_PRESSED, BTN_PANIC, 100UL);
+    TEST_ASSERT_TRUE(monitor.isPressed(BTN_PANIC));
+
+    monitor.pushEdge(BTN_PANIC, false, 300UL);
+    monitor.update(400UL);
+    expectEvent(BE_RELEASED, BTN_PANIC, 300UL);
+    expectNoEvent();
+    TEST_ASSERT_FALSE(monitor.isPressed(BTN_PANIC));
+}
+
+void test_bounces_are_filtered() {
+    monitor.pushEdge(BTN_CANCEL, true, 100UL);
+    monitor.pushEdge(BTN_CANCEL, false, 103UL);
+    monitor.pushEdge(BTN_CANCEL, true, 105UL);
+    monitor.pushEdge(BTN_CANCEL, false, 109UL);
+    monitor.pushEdge(BTN_CANCEL, true, 111UL);
+    monitor.update(200UL);
+    expectEvent(BE_PRESSED, BTN_CANCEL, 111UL);
+    expectNoEvent();
+
+    monitor.pushEdge(BTN_CANCEL, false, 300UL); // Glitch shorter than the debounce...
+    monitor.pushEdge(BTN_CANCEL, true, 305UL);
+    monitor.update(400UL);
+    expectNoEvent();
+    TEST_ASSERT_TRUE(monitor.isPressed(BTN_CANCEL));
+}
+
+void test_press_made_while_loop_was_busy_keeps_its_timing() {
+    monitor.pushEdge(BTN_PANIC, true, 100UL);
+    monitor.pushEdge(BTN_PANIC, false, 250UL);
+    monitor.update(5000UL); // Loop only gets here much later...
+    expectEvent(BE_PRESSED, BTN_PANIC, 100UL);
+    expectEvent(BE_RELEASED, BTN_PANIC, 250UL);
+    expectNoEvent(); // Held 150 ms, so no long press...
+}
+
+void test_long_press_once_per_hold() {
+    monitor.pushEdge(BTN_PANIC, true, 100UL);
+    monitor.update(1099UL);
+    expectEvent(BE_PRESSED, BTN_PANIC, 100UL);
+    expectNoEvent();
+    monitor.update(1100UL);
+    expectEvent(BE_LONG_PRESS, BTN_PANIC, 1100UL);
+    monitor.update(3000UL);
+    expectNoEvent();
+}
+
+void test_chord_of_both_buttons() {
+    monitor.pushEdge(BTN_PANIC, true, 100UL);
+    monitor.pushEdge(BTN_CANCEL, true, 150UL);
+    monitor.update(200UL);
+    expectEvent(BE_PRESSED, BTN_PANIC, 100UL);
+    expectEvent(BE_PRESSED, BTN_CANCEL, 150UL);
+    expectEvent(BE_CHORD, BTN_CANCEL, 150UL);
+
+    monitor.update(5000UL); // No long press while a chord is held...
+    expectNoEvent();
+
+    monitor.pushEdge(BTN_PANIC, false, 5100UL);
+    monitor.pushEdge(BTN_CANCEL, false, 5100UL);
+    monitor.update(5200UL);
+    expectEvent(BE_RELEASED, BTN_PANIC, 5100UL);
+    expectEvent(BE_RELEASED, BTN_CANCEL, 5100UL);
+    expectNoEvent();
+}
+
+void test_edge_queue_overflow_is_flagged() {
+    for (uint32_t i = 0; i < BUTTON_EDGE_QUEUE_SIZE; i++) {
+        monitor.pushEdge(BTN_PANIC, (i & 1U) == 0U, i);
+    }
+    TEST_ASSERT_TRUE(monitor.hadOverflow());
+    TEST_ASSERT_FALSE(monitor.hadOverflow());
+
+    monitor.pushEdge(5, true, 0UL); // No such button...
+    TEST_ASSERT_TRUE(monitor.hadOverflow());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_clean_press_and_release);
+    RUN_TEST(test_bounces_are_filtered);
+    RUN_TEST(test_press_made_while_loop_was_busy_keeps_its_timing);
+    RUN_TEST(test_long_press_once_per_hold);
+    RUN_TEST(test_chord_of_both_buttons);
+    RUN_TEST(test_edge_queue_overflow_is_flagged);
+
+    return UNITY_END();
+}
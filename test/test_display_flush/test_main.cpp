@@ -0,0 +1,197 @@
+/*
+ * Tests of the budgeted display flush against a simulated SSD1306 on a
+ * 400kHz I2C bus. Besides checking that what reaches the panel matches the
+ * frame buffer, a few seconds of the main loop are simulated while the
+ * display changes the way it does through a panic, and the longest any one
+ * pass of the loop was held up by the bus is measured for the full redraw
+ * used before, for sending changes right away and for the flush budget.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include <unity.h>
+#include <stdio.h>
+#include <DisplayWrapper.h>
+
+#define LED_PIN 14
+#define RUN_PERIOD_MS 10UL
+#define CHANGE_PERIOD_MS 250UL
+#define SIMULATED_MS 6000UL
+
+static const char* const SHOWN[] = {
+    "Panic in... 5",
+    "Panic in... 4",
+    "Panic in... 3",
+    "Panic in... 2",
+    "Panic in... 1",
+    "Panic In Progress...",
+    "Sending Alerts...",
+    "Alerts Sent!",
+    "IP: 192.168.1.23",
+    "The panel shows a long message that wraps over all four lines of it!"
+};
+#define SHOWN_COUNT (sizeof(SHOWN) / sizeof(SHOWN[0]))
+
+static Adafruit_SSD1306* disp = nullptr;
+static DisplayWrapper* display = nullptr;
+
+/**
+ * @return Returns true if the panel shows what's in the frame buffer as bool.
+*/
+static bool isPanelCurrent() {
+
+    return (memcmp(fakePanel.memory, disp->getBuffer(), sizeof(fakePanel.memory)) == 0);
+}
+
+/**
+ * How the text was shown before, drawn and then the whole frame buffer sent.
+*/
+static void showWithFullRedraw(const char* text) {
+    disp->clearDisplay();
+    disp->setCursor(0, 0);
+    disp->print(text);
+    disp->display();
+}
+
+/**
+ * Simulates the main loop a millisecond at a time, with the display task
+ * running every RUN_PERIOD_MS and the text changing every CHANGE_PERIOD_MS.
+ *
+ * @return Returns the longest the bus held up one pass of the loop in ns.
+*/
+static unsigned long long simulateLoop(bool isFullRedraw) {
+    unsigned long long longest = 0ULL;
+    unsigned long nextRun = fakeMillis;
+    size_t shown = 0U;
+    for (unsigned long ms = 0UL; ms < SIMULATED_MS; ms ++) {
+        unsigned long long before = Wire.getBusyNanos();
+        if ((ms % CHANGE_PERIOD_MS) == 0UL) {
+            if (isFullRedraw) {
+                showWithFullRedraw(SHOWN[shown]);
+            } else {
+                display->show(String(SHOWN[shown]));
+            }
+            shown = (shown + 1U) % SHOWN_COUNT;
+        }
+        if ((long)(fakeMillis - nextRun) >= 0L) {
+            display->run();
+            nextRun += RUN_PERIOD_MS;
+        }
+        unsigned long long held = Wire.getBusyNanos() - before;
+        if (held > longest) {
+            longest = held;
+        }
+        fakeMillis ++;
+    }
+
+    return longest;
+}
+
+/**
+ * Runs the display task until the panel is up to date.
+ *
+ * @return Returns how many runs it took as unsigned int.
+*/
+static unsigned int runUntilFlushed() {
+    unsigned int runs = 0U;
+    while (display->isFlushing() && runs < 1000U) {
+        display->run();
+        runs ++;
+    }
+
+    return runs;
+}
+
+void setUp() {
+    fakeMillis = 0UL;
+    disp = new Adafruit_SSD1306(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1, 400000UL, 400000UL);
+    display = new DisplayWrapper(disp, LED_PIN);
+    display->begin();
+}
+
+void tearDown() {
+    delete display;
+    delete disp;
+}
+
+void test_unbudgeted_show_reaches_the_panel_before_returning() {
+    display->show(F("System Ready."));
+
+    TEST_ASSERT_FALSE(display->isFlushing());
+    TEST_ASSERT_TRUE(isPanelCurrent());
+}
+
+void test_budgeted_show_returns_without_touching_the_bus() {
+    display->setFlushBudget(64U);
+    unsigned long transmissions = Wire.getTransmissions();
+    display->show(F("Panic In Progress..."));
+
+    TEST_ASSERT_EQUAL_UINT32(transmissions, Wire.getTransmissions());
+    TEST_ASSERT_TRUE(display->isFlushing());
+    TEST_ASSERT_FALSE(isPanelCurrent());
+
+    unsigned long dataBytes = fakePanel.dataBytes;
+    display->run();
+    TEST_ASSERT_LESS_OR_EQUAL(64UL, fakePanel.dataBytes - dataBytes);
+    TEST_ASSERT_TRUE(display->isFlushing()); // 120 columns take two runs...
+    TEST_ASSERT_EQUAL_UINT(1U, runUntilFlushed());
+    TEST_ASSERT_TRUE(isPanelCurrent());
+}
+
+void test_changing_text_mid_flush_still_ends_current() {
+    display->setFlushBudget(16U);
+    display->show(F("The panel shows a long message that wraps over all four lines of it!"));
+    display->run();
+    display->run();
+    display->show(F("Alerts Sent!"));
+    runUntilFlushed();
+
+    TEST_ASSERT_TRUE(isPanelCurrent());
+}
+
+void test_only_the_changed_columns_are_sent() {
+    display->show(F("Panic in... 5"));
+    unsigned long dataBytes = fakePanel.dataBytes;
+    display->show(F("Panic in... 4"));
+
+    TEST_ASSERT_TRUE(isPanelCurrent());
+    TEST_ASSERT_LESS_OR_EQUAL(6UL, fakePanel.dataBytes - dataBytes); // One glyph...
+
+    dataBytes = fakePanel.dataBytes;
+    display->show(F("Panic in... 4"));
+    TEST_ASSERT_EQUAL_UINT32(dataBytes, fakePanel.dataBytes); // Already shown...
+}
+
+void test_loop_latency_with_and_without_the_budget() {
+    unsigned long long immediate = simulateLoop(false);
+    TEST_ASSERT_TRUE(isPanelCurrent());
+
+    display->setFlushBudget(64U);
+    unsigned long long budgeted = simulateLoop(false);
+    runUntilFlushed();
+    TEST_ASSERT_TRUE(isPanelCurrent());
+
+    unsigned long long fullRedraw = simulateLoop(true); // Last, it goes around the wrapper...
+    TEST_ASSERT_TRUE(isPanelCurrent());
+
+    char line[192];
+    snprintf(line, sizeof(line), "Longest loop pass held by the display: %llu us full redraw, %llu us changes sent at once, %llu us with a 64 byte budget",
+        fullRedraw / 1000ULL, immediate / 1000ULL, budgeted / 1000ULL);
+    TEST_MESSAGE(line);
+
+    TEST_ASSERT_LESS_OR_EQUAL(fullRedraw, immediate);
+    TEST_ASSERT_LESS_THAN(fullRedraw / 4ULL, budgeted);
+    TEST_ASSERT_LESS_THAN(2000000ULL, budgeted); // Under 2 ms a pass...
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_unbudgeted_show_reaches_the_panel_before_returning);
+    RUN_TEST(test_budgeted_show_returns_without_touching_the_bus);
+    RUN_TEST(test_changing_text_mid_flush_still_ends_current);
+    RUN_TEST(test_only_the_changed_columns_are_sent);
+    RUN_TEST(test_loop_latency_with_and_without_the_budget);
+
+    return UNITY_END();
+}
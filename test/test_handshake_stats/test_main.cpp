@@ -0,0 +1,153 @@
+/*
+ * Tests of the HandshakeStats, against the session cache stand-in which
+ * keeps its sessions the way BearSSL's LRU cache does. Each handshake is
+ * acted out the way the TLS server uses the cache, a lookup when the
+ * client offers a session ID then a save when it wasn't found, between the
+ * begin and end of an accept with the fake clock moved in between.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include <unity.h>
+#include <HandshakeStats.h>
+
+#define TEST_SESSIONS 4
+
+static BearSSL::ServerSession store[TEST_SESSIONS];
+static BearSSL::ServerSessions* cache = nullptr;
+static HandshakeStats* stats = nullptr;
+static uint8_t nextId = 1U;
+
+/**
+ * @return Returns the parameters of a session new to the cache as
+ * br_ssl_session_parameters.
+*/
+static br_ssl_session_parameters newSession() {
+    br_ssl_session_parameters params = {};
+    memset(params.session_id, nextId, sizeof(params.session_id));
+    params.session_id_len = 32U;
+    memset(params.master_secret, 0xA0 ^ nextId, sizeof(params.master_secret));
+    nextId ++;
+
+    return params;
+}
+
+/**
+ * Acts out a handshake taking the given time. A client offering a session
+ * ID has it looked up and, if not found, a full handshake saves a new one,
+ * as does a client offering none.
+ *
+ * @return Returns what endAccept returned as bool.
+*/
+static bool handshake(const br_ssl_session_parameters* offered, unsigned long ms, br_ssl_session_parameters* saved = nullptr) {
+    stats->beginAccept();
+    fakeMillis += ms;
+    br_ssl_session_parameters lookup = {};
+    bool isResumed = false;
+    if (offered != nullptr) {
+        lookup = *offered;
+        isResumed = cache->serverLoads(lookup);
+    }
+    if (!isResumed) { // Full handshake...
+        br_ssl_session_parameters created = newSession();
+        cache->serverSaves(created);
+        if (saved != nullptr) {
+            *saved = created;
+        }
+    }
+
+    return stats->endAccept(true);
+}
+
+void setUp() {
+    fakeMillis = 1000UL;
+    nextId = 1U;
+    cache = new BearSSL::ServerSessions(store, TEST_SESSIONS);
+    stats = new HandshakeStats();
+    stats->watch(store, TEST_SESSIONS);
+}
+
+void tearDown() {
+    delete stats;
+    delete cache;
+}
+
+void test_full_then_resumed_handshake() {
+    br_ssl_session_parameters session;
+    TEST_ASSERT_TRUE(handshake(nullptr, 600UL, &session));
+    TEST_ASSERT_EQUAL_UINT32(0UL, stats->getCacheHits());
+    TEST_ASSERT_EQUAL_UINT32(1UL, stats->getCacheMisses());
+    TEST_ASSERT_EQUAL_UINT32(600UL, stats->getLastMs());
+
+    TEST_ASSERT_TRUE(handshake(&session, 40UL));
+
+    TEST_ASSERT_EQUAL_UINT32(1UL, stats->getCacheHits());
+    TEST_ASSERT_EQUAL_UINT32(1UL, stats->getCacheMisses());
+    TEST_ASSERT_EQUAL_UINT32(40UL, stats->getAverageResumedMs());
+    TEST_ASSERT_EQUAL_UINT32(600UL, stats->getAverageFullMs());
+    TEST_ASSERT_EQUAL_UINT32(600UL, stats->getSlowestMs());
+}
+
+void test_client_offering_no_session_is_a_miss() {
+    for (int i = 0; i < 3; i ++) {
+        TEST_ASSERT_TRUE(handshake(nullptr, 500UL + (unsigned long)i));
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0UL, stats->getCacheHits());
+    TEST_ASSERT_EQUAL_UINT32(3UL, stats->getCacheMisses());
+    TEST_ASSERT_EQUAL_UINT32(501UL, stats->getAverageFullMs());
+}
+
+void test_session_not_found_is_a_miss() {
+    br_ssl_session_parameters unknown = newSession(); // Never saved...
+    TEST_ASSERT_TRUE(handshake(&unknown, 550UL));
+
+    TEST_ASSERT_EQUAL_UINT32(0UL, stats->getCacheHits());
+    TEST_ASSERT_EQUAL_UINT32(1UL, stats->getCacheMisses());
+}
+
+void test_evicted_session_is_a_miss() {
+    br_ssl_session_parameters first;
+    handshake(nullptr, 500UL, &first);
+    for (int i = 0; i < TEST_SESSIONS; i ++) { // Pushes the first out...
+        handshake(nullptr, 500UL);
+    }
+    TEST_ASSERT_TRUE(handshake(&first, 500UL));
+
+    TEST_ASSERT_EQUAL_UINT32(0UL, stats->getCacheHits());
+    TEST_ASSERT_EQUAL_UINT32(TEST_SESSIONS + 2UL, stats->getCacheMisses());
+}
+
+void test_repeated_hits_leave_the_saved_part_alone() {
+    br_ssl_session_parameters session;
+    handshake(nullptr, 500UL, &session);
+    for (int i = 0; i < 5; i ++) {
+        TEST_ASSERT_TRUE(handshake(&session, 30UL));
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(5UL, stats->getCacheHits());
+    TEST_ASSERT_EQUAL_UINT32(1UL, stats->getCacheMisses());
+}
+
+void test_failed_handshake_is_not_recorded() {
+    stats->beginAccept();
+    fakeMillis += 300UL;
+
+    TEST_ASSERT_FALSE(stats->endAccept(false)); // Nothing saved, nothing open...
+    TEST_ASSERT_EQUAL_UINT32(0UL, stats->getCacheHits());
+    TEST_ASSERT_EQUAL_UINT32(0UL, stats->getCacheMisses());
+    TEST_ASSERT_EQUAL_UINT32(0UL, stats->getSlowestMs());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_full_then_resumed_handshake);
+    RUN_TEST(test_client_offering_no_session_is_a_miss);
+    RUN_TEST(test_session_not_found_is_a_miss);
+    RUN_TEST(test_evicted_session_is_a_miss);
+    RUN_TEST(test_repeated_hits_leave_the_saved_part_alone);
+    RUN_TEST(test_failed_handshake_is_not_recorded);
+
+    return UNITY_END();
+}
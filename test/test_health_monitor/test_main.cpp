@@ -0,0 +1,201 @@
+/*
+ * Tests of the HealthMonitor, driven by a fake clock and fake probes which
+ * count their calls and give whatever result a test sets. It is run once a
+ * second, as the device does, to check which tier runs when, the back-off
+ * of the full check while healthy and the forced retries while not.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include <unity.h>
+#include <HealthMonitor.h>
+
+struct FakeProbe {
+    bool result;
+    int calls;
+    unsigned long lastAt;
+};
+
+static unsigned long fakeNow = 0UL;
+static FakeProbe link;
+static FakeProbe reach;
+static FakeProbe auth;
+
+static unsigned long fakeClock() {
+
+    return fakeNow;
+}
+
+static bool probe(FakeProbe &fake) {
+    fake.calls ++;
+    fake.lastAt = fakeNow;
+
+    return fake.result;
+}
+
+static bool linkProbe() {
+
+    return probe(link);
+}
+
+static bool reachProbe() {
+
+    return probe(reach);
+}
+
+static bool authProbe() {
+
+    return probe(auth);
+}
+
+/**
+ * Runs the monitor once a second up to and including the given time.
+*/
+static void runUntil(HealthMonitor &health, unsigned long until) {
+    while (fakeNow < until) {
+        fakeNow += 1000UL;
+        health.run();
+    }
+}
+
+void setUp() {
+    fakeNow = 0UL;
+    link = {true, 0, 0UL};
+    reach = {true, 0, 0UL};
+    auth = {true, 0, 0UL};
+}
+
+void tearDown() {}
+
+void test_first_run_does_every_tier() {
+    HealthMonitor health(linkProbe, reachProbe, authProbe, fakeClock);
+    health.run();
+
+    TEST_ASSERT_EQUAL_INT(1, link.calls);
+    TEST_ASSERT_EQUAL_INT(1, reach.calls);
+    TEST_ASSERT_EQUAL_INT(1, auth.calls);
+    TEST_ASSERT_TRUE(health.isHealthy());
+}
+
+void test_each_tier_runs_on_its_own_interval() {
+    HealthMonitor health(linkProbe, reachProbe, authProbe, fakeClock);
+    health.run();
+    runUntil(health, HEALTH_REACH_INTERVAL_MS - 1000UL);
+
+    TEST_ASSERT_EQUAL_INT(1 + (int)((HEALTH_REACH_INTERVAL_MS - 1000UL) / HEALTH_LINK_INTERVAL_MS), link.calls);
+    TEST_ASSERT_EQUAL_INT(1, reach.calls);
+    runUntil(health, HEALTH_REACH_INTERVAL_MS);
+    TEST_ASSERT_EQUAL_INT(2, reach.calls);
+    TEST_ASSERT_EQUAL_INT(1, auth.calls); // Still healthy, not due...
+}
+
+void test_full_check_backs_off_while_healthy() {
+    HealthMonitor health(linkProbe, reachProbe, authProbe, fakeClock);
+    health.run();
+    TEST_ASSERT_EQUAL_UINT32(2UL * HEALTH_AUTH_MIN_INTERVAL_MS, health.getAuthInterval());
+
+    unsigned long expectedAt = 2UL * HEALTH_AUTH_MIN_INTERVAL_MS;
+    runUntil(health, expectedAt - 1000UL);
+    TEST_ASSERT_EQUAL_INT(1, auth.calls);
+    runUntil(health, expectedAt);
+    TEST_ASSERT_EQUAL_INT(2, auth.calls);
+    TEST_ASSERT_EQUAL_UINT32(HEALTH_AUTH_MAX_INTERVAL_MS, health.getAuthInterval());
+
+    expectedAt += HEALTH_AUTH_MAX_INTERVAL_MS;
+    runUntil(health, expectedAt);
+    TEST_ASSERT_EQUAL_INT(3, auth.calls);
+    TEST_ASSERT_EQUAL_UINT32(expectedAt, auth.lastAt);
+    TEST_ASSERT_EQUAL_UINT32(HEALTH_AUTH_MAX_INTERVAL_MS, health.getAuthInterval()); // Capped...
+}
+
+void test_link_down_skips_the_other_tiers() {
+    HealthMonitor health(linkProbe, reachProbe, authProbe, fakeClock);
+    health.run();
+    link.result = false;
+    runUntil(health, HEALTH_LINK_INTERVAL_MS);
+
+    TEST_ASSERT_FALSE(health.isHealthy());
+    TEST_ASSERT_EQUAL_UINT32(HEALTH_AUTH_MIN_INTERVAL_MS, health.getAuthInterval());
+    runUntil(health, 10UL * HEALTH_REACH_INTERVAL_MS);
+    TEST_ASSERT_EQUAL_INT(1, reach.calls);
+    TEST_ASSERT_EQUAL_INT(1, auth.calls);
+    TEST_ASSERT_FALSE(health.isHealthy());
+
+    link.result = true; // Back, the full check must confirm it...
+    runUntil(health, fakeNow + HEALTH_LINK_INTERVAL_MS);
+
+    TEST_ASSERT_EQUAL_INT(2, auth.calls);
+    TEST_ASSERT_TRUE(health.isHealthy());
+}
+
+void test_unreachable_host_forces_a_full_check() {
+    HealthMonitor health(linkProbe, reachProbe, authProbe, fakeClock);
+    health.run();
+    reach.result = false;
+    runUntil(health, HEALTH_REACH_INTERVAL_MS);
+
+    TEST_ASSERT_EQUAL_INT(2, reach.calls);
+    TEST_ASSERT_EQUAL_INT(2, auth.calls); // Brought forward to confirm...
+    TEST_ASSERT_EQUAL_UINT32(HEALTH_REACH_INTERVAL_MS, auth.lastAt);
+    TEST_ASSERT_TRUE(health.isHealthy()); // Reachability alone doesn't decide...
+
+    runUntil(health, HEALTH_REACH_INTERVAL_MS + HEALTH_AUTH_RETRY_MS);
+    TEST_ASSERT_EQUAL_INT(2 + (int)(HEALTH_AUTH_RETRY_MS / HEALTH_LINK_INTERVAL_MS), reach.calls); // Every link interval while down...
+    TEST_ASSERT_EQUAL_INT(3, auth.calls);
+    TEST_ASSERT_EQUAL_UINT32(HEALTH_REACH_INTERVAL_MS + HEALTH_AUTH_RETRY_MS, auth.lastAt);
+
+    reach.result = true;
+    int reachCalls = reach.calls;
+    runUntil(health, fakeNow + HEALTH_REACH_INTERVAL_MS - 1000UL);
+
+    TEST_ASSERT_EQUAL_INT(reachCalls + 1, reach.calls); // Back to its own interval...
+}
+
+void test_failed_full_check_is_retried_until_it_recovers() {
+    HealthMonitor health(linkProbe, reachProbe, authProbe, fakeClock);
+    health.run();
+    auth.result = false;
+    runUntil(health, 2UL * HEALTH_AUTH_MIN_INTERVAL_MS);
+
+    TEST_ASSERT_EQUAL_INT(2, auth.calls);
+    TEST_ASSERT_FALSE(health.isHealthy());
+    TEST_ASSERT_EQUAL_UINT32(HEALTH_AUTH_MIN_INTERVAL_MS, health.getAuthInterval());
+
+    unsigned long failedAt = fakeNow;
+    runUntil(health, failedAt + HEALTH_AUTH_RETRY_MS - 1000UL);
+    TEST_ASSERT_EQUAL_INT(2, auth.calls);
+    runUntil(health, failedAt + HEALTH_AUTH_RETRY_MS);
+    TEST_ASSERT_EQUAL_INT(3, auth.calls);
+
+    auth.result = true;
+    runUntil(health, failedAt + (2UL * HEALTH_AUTH_RETRY_MS));
+
+    TEST_ASSERT_EQUAL_INT(4, auth.calls);
+    TEST_ASSERT_TRUE(health.isHealthy());
+    TEST_ASSERT_EQUAL_UINT32(2UL * HEALTH_AUTH_MIN_INTERVAL_MS, health.getAuthInterval());
+}
+
+void test_clock_wraparound() {
+    fakeNow = 0xFFFFFFFFUL - 2000UL;
+    HealthMonitor health(linkProbe, reachProbe, authProbe, fakeClock);
+    health.run();
+    fakeNow = 0xFFFFFFFFUL;
+    runUntil(health, 0xFFFFFFFFUL + HEALTH_LINK_INTERVAL_MS); // Wraps past zero...
+
+    TEST_ASSERT_EQUAL_INT(2, link.calls);
+    TEST_ASSERT_EQUAL_INT(1, auth.calls);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_run_does_every_tier);
+    RUN_TEST(test_each_tier_runs_on_its_own_interval);
+    RUN_TEST(test_full_check_backs_off_while_healthy);
+    RUN_TEST(test_link_down_skips_the_other_tiers);
+    RUN_TEST(test_unreachable_host_forces_a_full_check);
+    RUN_TEST(test_failed_full_check_is_retried_until_it_recovers);
+    RUN_TEST(test_clock_wraparound);
+
+    return UNITY_END();
+}
@@ -0,0 +1,269 @@
+/*
+ * Tests of the HTML templates split at compile time. Each page rendered
+ * through HtmlRenderer must be byte for byte what the replace() based
+ * rendering used before gives for the same values. Pages rendered through
+ * GzipOutput, with the build time compressed segments of the page and of
+ * the content in its slot, are inflated with zlib and must give the same
+ * bytes again.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include <unity.h>
+#include <string>
+#include <zlib.h>
+#include <GzipOutput.h>
+#include <HtmlRenderer.h>
+#include <HtmlContent.h>
+#include <HtmlContentGz.h>
+
+#define TEST_FIRMWARE_VERSION "1.4.2"
+#define TEST_SETTINGS_JSON "{\n  \"ssid\": \"The-Neighbourhood-Network\",\n  \"smtp_port\": 465,\n  \"panic_level\": 5\n}"
+
+static std::string rendered;
+static unsigned int chunkCount = 0U;
+static bool isEnded = false;
+
+static void collect(const char* data, size_t length) {
+    if (length == 0U) {
+        isEnded = true;
+
+        return;
+    }
+    rendered.append(data, length);
+    chunkCount ++;
+}
+
+/**
+ * The page as it was rendered before, by replacing the placeholders of a
+ * copy of the template.
+*/
+static String replacePage(const String &title, const String &heading, const String &content) {
+    String result = HTML_PAGE_TEMPLATE;
+    result.replace("${title}", title);
+    result.replace("${heading}", heading);
+    result.replace("${content}", content);
+
+    return result;
+}
+
+static String replaceRootPage() {
+    String content = ROOT_PAGE;
+    content.replace("${firmware_version}", String(TEST_FIRMWARE_VERSION));
+
+    return replacePage("Panic Button", "FriendlyNeighbor", content);
+}
+
+static String replaceAdminPage() {
+    String content = ADMIN_PAGE;
+    content.replace("${settings}", String(TEST_SETTINGS_JSON));
+
+    return replacePage("Admin", "Panic Button Administration", content);
+}
+
+/**
+ * Renders the page template with the given content template through the
+ * compile time split, the way the web server does, to the given output.
+*/
+template <size_t PAGE_SEGMENTS, size_t CONTENT_SEGMENTS>
+static void renderPageTo(ChunkedOutput &out, const char* title, const char* heading, const HtmlTemplate<CONTENT_SEGMENTS> &content, const HtmlTemplate<PAGE_SEGMENTS> &page, const HtmlDeflated* deflated, const HtmlDeflated* contentDeflated) {
+    HtmlRenderer::render(page, out, [&](uint8_t slot, ChunkedOutput &slotOut) {
+        if (slot == HS_TITLE) {
+            slotOut.print(title);
+        } else if (slot == HS_HEADING) {
+            slotOut.print(heading);
+        } else if (slot == HS_CONTENT) {
+            HtmlRenderer::render(content, slotOut, [](uint8_t contentSlot, ChunkedOutput &contentOut) {
+                if (contentSlot == HS_FIRMWARE_VERSION) {
+                    contentOut.print(F(TEST_FIRMWARE_VERSION));
+                } else if (contentSlot == HS_SETTINGS) {
+                    contentOut.print(F(TEST_SETTINGS_JSON));
+                }
+            }, contentDeflated);
+        }
+    }, deflated);
+    out.end();
+}
+
+template <size_t PAGE_SEGMENTS, size_t CONTENT_SEGMENTS>
+static void renderPage(const char* title, const char* heading, const HtmlTemplate<CONTENT_SEGMENTS> &content, const HtmlTemplate<PAGE_SEGMENTS> &page, const HtmlDeflated* deflated = nullptr) {
+    ChunkedOutput out(collect);
+    renderPageTo(out, title, heading, content, page, deflated, nullptr);
+}
+
+template <size_t PAGE_SEGMENTS, size_t CONTENT_SEGMENTS>
+static void renderGzipPage(const char* title, const char* heading, const HtmlTemplate<CONTENT_SEGMENTS> &content, const HtmlTemplate<PAGE_SEGMENTS> &page, const HtmlDeflated* contentDeflated) {
+    GzipOutput out(collect);
+    renderPageTo(out, title, heading, content, page, &HTML_PAGE_TEMPLATE_DEFLATED, contentDeflated);
+}
+
+/**
+ * Inflates a whole gzip stream with zlib, which also checks the CRC and
+ * the size in its trailer.
+ *
+ * @return Returns the inflated bytes, or an empty string with the test
+ * failed if it isn't a valid gzip stream, as std::string.
+*/
+static std::string gunzip(const std::string &gzipped) {
+    z_stream stream = {};
+    TEST_ASSERT_EQUAL_INT(Z_OK, inflateInit2(&stream, 16 + MAX_WBITS)); // Gzip wrapper only...
+    stream.next_in = (Bytef*)gzipped.data();
+    stream.avail_in = (uInt)gzipped.length();
+
+    std::string inflated;
+    char buffer[512];
+    int result = Z_OK;
+    while (result == Z_OK) {
+        stream.next_out = (Bytef*)buffer;
+        stream.avail_out = sizeof(buffer);
+        result = inflate(&stream, Z_NO_FLUSH);
+        inflated.append(buffer, sizeof(buffer) - stream.avail_out);
+    }
+    size_t unused = stream.avail_in;
+    inflateEnd(&stream);
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(Z_STREAM_END, result, stream.msg);
+    TEST_ASSERT_EQUAL_UINT32(0U, unused); // Nothing after the trailer...
+
+    return inflated;
+}
+
+/**
+ * Checks that the gzipped render inflates to exactly the plain one.
+*/
+static void assertGzipMatchesPlain(const std::string &plain) {
+    std::string inflated = gunzip(rendered);
+
+    TEST_ASSERT_TRUE(isEnded);
+    TEST_ASSERT_LESS_THAN(plain.length(), rendered.length()); // The compressed segments did their part...
+    TEST_ASSERT_EQUAL_UINT32(plain.length(), inflated.length());
+    TEST_ASSERT_EQUAL_MEMORY(plain.data(), inflated.data(), plain.length());
+}
+
+/**
+ * Puts the segments of a template back together with each slot written as
+ * its placeholder, which must give back the template's text.
+*/
+template <size_t SEGMENTS>
+static std::string rejoin(const HtmlTemplate<SEGMENTS> &parts) {
+    std::string text;
+    for (size_t i = 0; i < SEGMENTS; i ++) {
+        text.append(parts.text + parts.segments[i].offset, parts.segments[i].length);
+        if (parts.segments[i].slot != HTML_NO_SLOT) {
+            text += "${";
+            text += HTML_SLOT_NAMES[parts.segments[i].slot];
+            text += "}";
+        }
+    }
+
+    return text;
+}
+
+void setUp() {
+    rendered.clear();
+    chunkCount = 0U;
+    isEnded = false;
+}
+
+void tearDown() {}
+
+void test_segments_cover_each_template() {
+    TEST_ASSERT_EQUAL_STRING(HTML_PAGE_TEMPLATE, rejoin(HTML_PAGE_PARTS).c_str());
+    TEST_ASSERT_EQUAL_STRING(ADMIN_PAGE, rejoin(ADMIN_PAGE_PARTS).c_str());
+    TEST_ASSERT_EQUAL_STRING(ROOT_PAGE, rejoin(ROOT_PAGE_PARTS).c_str());
+
+    TEST_ASSERT_EQUAL_UINT8(HS_TITLE, HTML_PAGE_PARTS.segments[0].slot);
+    TEST_ASSERT_EQUAL_UINT8(HS_HEADING, HTML_PAGE_PARTS.segments[1].slot);
+    TEST_ASSERT_EQUAL_UINT8(HS_CONTENT, HTML_PAGE_PARTS.segments[2].slot);
+    TEST_ASSERT_EQUAL_UINT8(HTML_NO_SLOT, HTML_PAGE_PARTS.segments[3].slot);
+    TEST_ASSERT_EQUAL_UINT8(HS_SETTINGS, ADMIN_PAGE_PARTS.segments[0].slot);
+    TEST_ASSERT_EQUAL_UINT8(HS_FIRMWARE_VERSION, ROOT_PAGE_PARTS.segments[0].slot);
+}
+
+void test_split_happens_at_compile_time() {
+    constexpr auto parts = HTML_SPLIT("a${content}b${title}", HTML_SLOT_NAMES);
+    static_assert(sizeof(parts.segments) / sizeof(parts.segments[0]) == 3, "One segment per slot plus the tail");
+    static_assert(parts.segments[0].length == 1 && parts.segments[0].slot == HS_CONTENT, "Literal then slot");
+    static_assert(parts.segments[1].offset == 11 && parts.segments[1].slot == HS_TITLE, "Offset past the placeholder");
+    static_assert(parts.segments[2].length == 0 && parts.segments[2].slot == HTML_NO_SLOT, "Empty tail");
+
+    TEST_ASSERT_EQUAL_UINT16(0U, parts.segments[2].length);
+}
+
+void test_root_page_is_byte_identical_to_replace() {
+    renderPage("Panic Button", "FriendlyNeighbor", ROOT_PAGE_PARTS, HTML_PAGE_PARTS);
+    String expected = replaceRootPage();
+
+    TEST_ASSERT_TRUE(isEnded);
+    TEST_ASSERT_EQUAL_UINT32(expected.length(), rendered.length());
+    TEST_ASSERT_EQUAL_MEMORY(expected.c_str(), rendered.data(), expected.length());
+}
+
+void test_admin_page_is_byte_identical_to_replace() {
+    renderPage("Admin", "Panic Button Administration", ADMIN_PAGE_PARTS, HTML_PAGE_PARTS);
+    String expected = replaceAdminPage();
+
+    TEST_ASSERT_GREATER_THAN(CHUNKED_OUTPUT_SIZE, expected.length()); // Spans several chunks...
+    TEST_ASSERT_GREATER_THAN(1U, chunkCount);
+    TEST_ASSERT_EQUAL_UINT32(expected.length(), rendered.length());
+    TEST_ASSERT_EQUAL_MEMORY(expected.c_str(), rendered.data(), expected.length());
+}
+
+void test_plain_output_ignores_the_deflated_segments() {
+    const HtmlDeflated deflated = {HTML_PAGE_TEMPLATE_GZ, HTML_PAGE_TEMPLATE_GZ_SEGMENTS};
+    renderPage("Panic Button", "FriendlyNeighbor", ROOT_PAGE_PARTS, HTML_PAGE_PARTS, &deflated);
+    String expected = replaceRootPage();
+
+    TEST_ASSERT_EQUAL_UINT32(expected.length(), rendered.length());
+    TEST_ASSERT_EQUAL_MEMORY(expected.c_str(), rendered.data(), expected.length());
+}
+
+void test_gzip_root_page_inflates_to_the_plain_page() {
+    renderPage("Panic Button", "FriendlyNeighbor", ROOT_PAGE_PARTS, HTML_PAGE_PARTS);
+    std::string plain = rendered;
+    setUp();
+    renderGzipPage("Panic Button", "FriendlyNeighbor", ROOT_PAGE_PARTS, HTML_PAGE_PARTS, &ROOT_PAGE_DEFLATED);
+
+    assertGzipMatchesPlain(plain);
+}
+
+void test_gzip_admin_page_inflates_to_the_plain_page() {
+    renderPage("Admin", "Panic Button Administration", ADMIN_PAGE_PARTS, HTML_PAGE_PARTS);
+    std::string plain = rendered;
+    setUp();
+    renderGzipPage("Admin", "Panic Button Administration", ADMIN_PAGE_PARTS, HTML_PAGE_PARTS, &ADMIN_PAGE_DEFLATED);
+
+    assertGzipMatchesPlain(plain);
+}
+
+void test_gzip_page_with_plain_content_inflates_to_the_plain_page() {
+    renderPage("Admin", "Panic Button Administration", ADMIN_PAGE_PARTS, HTML_PAGE_PARTS);
+    std::string plain = rendered;
+    setUp();
+    renderGzipPage("Admin", "Panic Button Administration", ADMIN_PAGE_PARTS, HTML_PAGE_PARTS, nullptr); // Content all in stored blocks...
+
+    assertGzipMatchesPlain(plain);
+}
+
+void test_gzip_of_nothing_is_a_valid_stream() {
+    GzipOutput out(collect);
+    out.end();
+
+    TEST_ASSERT_EQUAL_UINT32(0U, gunzip(rendered).length());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_segments_cover_each_template);
+    RUN_TEST(test_split_happens_at_compile_time);
+    RUN_TEST(test_root_page_is_byte_identical_to_replace);
+    RUN_TEST(test_admin_page_is_byte_identical_to_replace);
+    RUN_TEST(test_plain_output_ignores_the_deflated_segments);
+    RUN_TEST(test_gzip_root_page_inflates_to_the_plain_page);
+    RUN_TEST(test_gzip_admin_page_inflates_to_the_plain_page);
+    RUN_TEST(test_gzip_page_with_plain_content_inflates_to_the_plain_page);
+    RUN_TEST(test_gzip_of_nothing_is_a_valid_stream);
+
+    return UNITY_END();
+}
@@ -0,0 +1,204 @@
+/*
+ * Fault injection tests of the settings journal. A run of panics, cancels
+ * and settings changes is persisted the way the dispatcher does, with a
+ * flush behind each change, and power is cut after every flash write and
+ * erase of the run in turn. Each time the settings are then loaded as on
+ * the next boot, which must give back what was last committed, or what
+ * was being committed when power failed, and never the factory defaults.
+ * A panic must be committed by a small append, as the dispatcher does it
+ * ahead of the first message.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include <unity.h>
+#include <stdio.h>
+#include <Settings.h>
+
+#define RUN_CYCLES 6
+
+// What a boot is expected to load, the persisted part of the settings
+struct PersistedState {
+    bool           inPanicMode                 ;
+    int            panicLevel                  ;
+    char           owner            [101]      ;
+};
+
+static const char* const OWNERS[RUN_CYCLES] = {
+    "Pat at 12 Elm Street",
+    "Pat and Sam at 12 Elm Street",
+    "Sam at 12 Elm Street",
+    "The Hendersons, 14 Elm Street",
+    "Flat 2, 14 Elm Street",
+    "Pat at 12 Elm Street, ring twice"
+};
+
+static PersistedState stateOf(Settings &target) {
+    PersistedState state = {};
+    state.inPanicMode = target.getInPanicMode();
+    state.panicLevel = target.getPanicLevel();
+    strncpy(state.owner, target.viewOwner().chars, sizeof(state.owner) - 1);
+
+    return state;
+}
+
+static bool isSameState(const PersistedState &a, const PersistedState &b) {
+
+    return (a.inPanicMode == b.inPanicMode && a.panicLevel == b.panicLevel && strcmp(a.owner, b.owner) == 0);
+}
+
+/**
+ * Flushes the settings and keeps track of what was committed, or what was
+ * being committed if power failed during the flush.
+*/
+static void flushTracked(Settings &target, PersistedState &committed, PersistedState &inFlight, bool &isInFlight) {
+    PersistedState changed = stateOf(target);
+    if (target.flush()) {
+        committed = changed;
+    } else if (!isInFlight) { // Only the flush power failed in can be part written...
+        inFlight = changed;
+        isInFlight = true;
+    }
+}
+
+/**
+ * The run of changes persisted the way the dispatcher persists them. Six
+ * full saves don't fit into the journal's sectors so it compacts several
+ * times during the run.
+*/
+static void runChanges(Settings &target, PersistedState &committed, PersistedState &inFlight, bool &isInFlight) {
+    for (int cycle = 0; cycle < RUN_CYCLES; cycle ++) {
+        target.setInPanicMode(true); // Button held...
+        flushTracked(target, committed, inFlight, isInFlight);
+        target.setPanicLevel(1 + (cycle % 5));
+        flushTracked(target, committed, inFlight, isInFlight);
+        target.setInPanicMode(false); // Canceled...
+        flushTracked(target, committed, inFlight, isInFlight);
+        target.setOwner(OWNERS[cycle]); // Configured through the portal...
+        flushTracked(target, committed, inFlight, isInFlight);
+    }
+}
+
+/**
+ * Starts from freshly defaulted settings in erased flash.
+*/
+static void startFresh() {
+    ESP.restorePower();
+    ESP.eraseAll();
+    EEPROM.clear();
+    Settings fresh;
+    fresh.factoryDefault();
+}
+
+void setUp() {
+    startFresh();
+}
+
+void tearDown() {
+    ESP.restorePower();
+}
+
+void test_run_without_power_loss_is_all_committed() {
+    Settings target;
+    TEST_ASSERT_TRUE(target.loadSettings());
+    PersistedState committed = stateOf(target);
+    PersistedState inFlight = {};
+    bool isInFlight = false;
+    unsigned long startOperations = ESP.getOperationCount();
+    runChanges(target, committed, inFlight, isInFlight);
+
+    TEST_ASSERT_FALSE(isInFlight);
+    TEST_ASSERT_GREATER_THAN(RUN_CYCLES * 4UL, ESP.getOperationCount() - startOperations);
+    Settings rebooted;
+    TEST_ASSERT_TRUE(rebooted.loadSettings());
+    TEST_ASSERT_TRUE(isSameState(committed, stateOf(rebooted)));
+    TEST_ASSERT_EQUAL_STRING(OWNERS[RUN_CYCLES - 1], rebooted.viewOwner().chars);
+}
+
+void test_power_loss_at_every_step_recovers_the_committed_state() {
+    unsigned long cuts = 0UL;
+    unsigned long inFlightLoads = 0UL;
+    for (long operations = 0L; ; operations ++) {
+        startFresh();
+        Settings target;
+        TEST_ASSERT_TRUE(target.loadSettings());
+        PersistedState committed = stateOf(target);
+        PersistedState inFlight = {};
+        bool isInFlight = false;
+
+        ESP.losePowerAfter(operations);
+        runChanges(target, committed, inFlight, isInFlight);
+        if (!ESP.isPowerLost()) { // Whole run fit before the cut, every step has been covered...
+            break;
+        }
+        cuts ++;
+        ESP.restorePower();
+
+        Settings rebooted;
+        char message[96];
+        snprintf(message, sizeof(message), "Power cut after %ld flash operations", operations);
+        TEST_ASSERT_TRUE_MESSAGE(rebooted.loadSettings(), message);
+        PersistedState loaded = stateOf(rebooted);
+        if (isInFlight && isSameState(inFlight, loaded)) { // Cut only tore what followed the record...
+            inFlightLoads ++;
+        } else {
+            TEST_ASSERT_TRUE_MESSAGE(isSameState(committed, loaded), message);
+        }
+
+        // The journal must keep working after the damaged record...
+        rebooted.setPanicLevel(2);
+        rebooted.setOwner("After the power cut");
+        TEST_ASSERT_TRUE_MESSAGE(rebooted.flush(), message);
+        Settings again;
+        TEST_ASSERT_TRUE_MESSAGE(again.loadSettings(), message);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE("After the power cut", again.viewOwner().chars, message);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(2, again.getPanicLevel(), message);
+    }
+
+    char line[96];
+    snprintf(line, sizeof(line), "Power cut at %lu points, %lu loaded the write that was cut", cuts, inFlightLoads);
+    TEST_MESSAGE(line);
+    TEST_ASSERT_GREATER_THAN(RUN_CYCLES * 4UL, cuts);
+}
+
+void test_committed_panic_survives_a_cut_during_the_next_save() {
+    Settings target;
+    TEST_ASSERT_TRUE(target.loadSettings());
+    target.setInPanicMode(true);
+    TEST_ASSERT_TRUE(target.flush());
+
+    target.setOwner("Half written owner");
+    ESP.losePowerAfter(1L); // The record header goes, its payload doesn't...
+    TEST_ASSERT_FALSE(target.flush());
+    ESP.restorePower();
+
+    Settings rebooted;
+    TEST_ASSERT_TRUE(rebooted.loadSettings());
+    TEST_ASSERT_TRUE(rebooted.getInPanicMode());
+    TEST_ASSERT_TRUE(rebooted.isOwnerFactory());
+}
+
+void test_panic_is_committed_by_one_small_append() {
+    Settings target;
+    TEST_ASSERT_TRUE(target.loadSettings());
+    target.setInPanicMode(true);
+    unsigned long before = ESP.getOperationCount();
+    TEST_ASSERT_TRUE(target.flush()); // Ahead of the first message...
+    unsigned long operations = ESP.getOperationCount() - before;
+    Settings rebooted; // Power failed while the message was sent...
+
+    TEST_ASSERT_LESS_OR_EQUAL(2UL, operations); // No erase, no snapshot...
+    TEST_ASSERT_TRUE(rebooted.loadSettings());
+    TEST_ASSERT_TRUE(rebooted.getInPanicMode());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_run_without_power_loss_is_all_committed);
+    RUN_TEST(test_power_loss_at_every_step_recovers_the_committed_state);
+    RUN_TEST(test_committed_panic_survives_a_cut_during_the_next_save);
+    RUN_TEST(test_panic_is_committed_by_one_small_append);
+
+    return UNITY_END();
+}
@@ -0,0 +1,228 @@
+/*
+ * Tests of the hex decoding in ParseUtils, done through the HEX_NIBBLES
+ * table. Every character is checked by hexNibble, every pair of characters
+ * by decodeHexPair, and parseHex and hexStringToInt are checked against
+ * strtoul including overflow. Ends with a benchmark over random hex input
+ * of the table against strtoul and against the per character conditionals
+ * and pow() the conversion used before. URL decoding, which is built on the
+ * pairs, is tested in test_url_decode.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include <unity.h>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <errno.h>
+#include <stdio.h>
+#include <ParseUtils.h>
+
+#define RANDOM_HEX_STRINGS 200000UL
+#define BENCHMARK_STRINGS 4096U
+#define BENCHMARK_RUNS 200UL
+
+static std::mt19937 random32(20261016UL);
+
+static int referenceNibble(int c) {
+    if (c >= '0' && c <= '9') {
+
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+
+        return c - 'A' + 10;
+    }
+
+    return -1;
+}
+
+/**
+ * The conversion as it was before, kept to benchmark against.
+*/
+static unsigned int legacyHexStringToInt(std::string hex) {
+    unsigned int result = 0;
+    for (unsigned int i = 0; i < hex.length(); i++) {
+        char c = hex.at(i);
+        unsigned int temp = c - '0';
+        if (temp <= 9) {
+            result += (temp * pow(16, (hex.length() - i - 1)));
+        } else {
+            temp = c - 'A' + 10;
+            if (temp >= 0xA && temp <= 0xF) {
+                result += (temp * pow(16, (hex.length() - i - 1)));
+            } else {
+                temp = c - 'a' + 10;
+                if (temp >= 0xA && temp <= 0xF) {
+                    result += (temp * pow(16, (hex.length() - i - 1)));
+                } else {
+
+                    return 0;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Checks parseHex and both hexStringToInt against strtoul, which only
+ * stands for what parseHex does when every character is a hex digit, as
+ * strtoul also takes whitespace, a sign and a "0x".
+*/
+static void assertHexMatchesStrtoul(const std::string &text) {
+    uint32_t value = 0xDEADBEEFUL;
+    bool isParsed = ParseUtils::parseHex(text.data(), text.length(), value);
+    bool isAllHex = !text.empty() && text.find_first_not_of("0123456789abcdefABCDEF") == std::string::npos;
+    unsigned long expected = 0UL;
+    bool isInRange = false;
+    if (isAllHex) {
+        errno = 0;
+        expected = strtoul(text.c_str(), nullptr, 16);
+        isInRange = (errno != ERANGE && expected <= 0xFFFFFFFFUL);
+    }
+
+    TEST_ASSERT_EQUAL_MESSAGE(isAllHex && isInRange, isParsed, text.c_str());
+    if (isParsed) {
+        TEST_ASSERT_EQUAL_HEX32_MESSAGE(expected, value, text.c_str());
+    } else {
+        TEST_ASSERT_EQUAL_HEX32_MESSAGE(0xDEADBEEFUL, value, text.c_str()); // Left alone...
+    }
+    String arduinoText = text.c_str();
+    TEST_ASSERT_EQUAL_HEX32_MESSAGE(isParsed ? expected : 0UL, ParseUtils::hexStringToInt(text), text.c_str());
+    TEST_ASSERT_EQUAL_HEX32_MESSAGE(isParsed ? expected : 0UL, ParseUtils::hexStringToInt(arduinoText), text.c_str());
+}
+
+static std::string randomHex(size_t length) {
+    static const char DIGITS[] = "0123456789abcdefABCDEF";
+    std::string hex;
+    for (size_t i = 0U; i < length; i ++) {
+        hex += DIGITS[random32() % (sizeof(DIGITS) - 1U)];
+    }
+
+    return hex;
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_every_character_as_a_nibble() {
+    for (int c = 0; c < 256; c ++) {
+        TEST_ASSERT_EQUAL_INT_MESSAGE(referenceNibble(c), ParseUtils::hexNibble((char)c), std::to_string(c).c_str());
+    }
+}
+
+void test_every_pair_of_characters() {
+    char pair[2];
+    for (int high = 0; high < 256; high ++) {
+        for (int low = 0; low < 256; low ++) {
+            pair[0] = (char)high;
+            pair[1] = (char)low;
+            int expected = (referenceNibble(high) < 0 || referenceNibble(low) < 0) ? -1 : ((referenceNibble(high) << 4) | referenceNibble(low));
+            if (ParseUtils::decodeHexPair(pair) != expected) {
+                TEST_ASSERT_EQUAL_INT_MESSAGE(expected, ParseUtils::decodeHexPair(pair), (std::to_string(high) + "," + std::to_string(low)).c_str());
+            }
+        }
+    }
+}
+
+void test_every_short_string_matches_strtoul() {
+    const char alphabet[] = "09afAFgG x-+";
+    std::string text;
+    for (size_t a = 0U; a < sizeof(alphabet); a ++) { // Up to 3 characters, the terminator standing for none...
+        for (size_t b = 0U; b < sizeof(alphabet); b ++) {
+            for (size_t c = 0U; c < sizeof(alphabet); c ++) {
+                text.clear();
+                for (size_t index : {a, b, c}) {
+                    if (alphabet[index] != '\0') {
+                        text += alphabet[index];
+                    }
+                }
+                assertHexMatchesStrtoul(text);
+            }
+        }
+    }
+}
+
+void test_random_hex_matches_strtoul() {
+    for (unsigned long i = 0UL; i < RANDOM_HEX_STRINGS; i ++) {
+        std::string text = std::string(random32() % 4U, '0') + randomHex(1U + (random32() % 10U));
+        assertHexMatchesStrtoul(text);
+    }
+}
+
+void test_overflow_is_rejected() {
+    assertHexMatchesStrtoul("FFFFFFFF");
+    assertHexMatchesStrtoul("0000000000FFFFFFFF");
+    assertHexMatchesStrtoul("100000000");
+    assertHexMatchesStrtoul("FFFFFFFFF");
+    assertHexMatchesStrtoul("0x1F"); // No prefix...
+    assertHexMatchesStrtoul("");
+
+    uint32_t value = 0UL;
+    TEST_ASSERT_TRUE(ParseUtils::parseHex("2B00", 2U, value)); // Stops at the length given...
+    TEST_ASSERT_EQUAL_HEX32(0x2BUL, value);
+}
+
+void test_benchmark_over_random_hex() {
+    std::vector<std::string> samples;
+    for (unsigned int i = 0U; i < BENCHMARK_STRINGS; i ++) {
+        samples.push_back(randomHex(1U + (i % 8U)));
+    }
+    unsigned long legacySum = 0UL;
+    unsigned long strtoulSum = 0UL;
+    unsigned long tableSum = 0UL;
+
+    auto started = std::chrono::steady_clock::now();
+    for (unsigned long run = 0UL; run < BENCHMARK_RUNS; run ++) {
+        for (const std::string &sample : samples) {
+            legacySum += legacyHexStringToInt(sample);
+        }
+    }
+    double legacyNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started).count() / (BENCHMARK_RUNS * BENCHMARK_STRINGS);
+
+    started = std::chrono::steady_clock::now();
+    for (unsigned long run = 0UL; run < BENCHMARK_RUNS; run ++) {
+        for (const std::string &sample : samples) {
+            strtoulSum += strtoul(sample.c_str(), nullptr, 16);
+        }
+    }
+    double strtoulNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started).count() / (BENCHMARK_RUNS * BENCHMARK_STRINGS);
+
+    started = std::chrono::steady_clock::now();
+    for (unsigned long run = 0UL; run < BENCHMARK_RUNS; run ++) {
+        for (const std::string &sample : samples) {
+            uint32_t value = 0UL;
+            ParseUtils::parseHex(sample.data(), sample.length(), value);
+            tableSum += value;
+        }
+    }
+    double tableNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started).count() / (BENCHMARK_RUNS * BENCHMARK_STRINGS);
+
+    char report[160];
+    snprintf(report, sizeof(report), "Per hex string of 1 to 8 digits: conditionals and pow %.1f ns, strtoul %.1f ns, nibble table %.1f ns", legacyNs, strtoulNs, tableNs);
+    TEST_MESSAGE(report);
+
+    TEST_ASSERT_EQUAL_UINT32(strtoulSum, tableSum);
+    TEST_ASSERT_EQUAL_UINT32(strtoulSum, legacySum);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_every_character_as_a_nibble);
+    RUN_TEST(test_every_pair_of_characters);
+    RUN_TEST(test_every_short_string_matches_strtoul);
+    RUN_TEST(test_random_hex_matches_strtoul);
+    RUN_TEST(test_overflow_is_rejected);
+    RUN_TEST(test_benchmark_over_random_hex);
+
+    return UNITY_END();
+}
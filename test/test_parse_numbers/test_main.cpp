@@ -0,0 +1,271 @@
+/*
+ * Tests of ParseUtils parseLong and parseDouble against strtol and strtod.
+ * Every short string over the characters a number is made of is parsed
+ * by both, random doubles are parsed back from how printf writes them, and
+ * inputs too long for the stack buffer check the digits handed to strtod
+ * in their place. The value, the error and the length consumed must all
+ * agree, bit for bit for doubles, with ERANGE from either overflow or
+ * underflow standing for PE_OUT_OF_RANGE. Ends with a benchmark of each against
+ * the C library.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include <unity.h>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <math.h>
+#include <errno.h>
+#include <stdio.h>
+#include <ParseUtils.h>
+
+#define EXHAUSTIVE_LENGTH 5U
+#define RANDOM_DOUBLES 200000UL
+#define LONG_INPUTS 5000UL
+#define BENCHMARK_RUNS 200UL
+
+static std::mt19937_64 random64(20261016ULL);
+
+/**
+ * Calls the given function with every string up to the given length made
+ * of the given characters.
+*/
+template <typename Check>
+static void forEveryString(const char* alphabet, size_t maxLength, Check check) {
+    size_t letters = strlen(alphabet);
+    std::string text;
+    for (size_t length = 0U; length <= maxLength; length ++) {
+        std::vector<size_t> digits(length, 0U);
+        while (true) {
+            text.clear();
+            for (size_t digit : digits) {
+                text += alphabet[digit];
+            }
+            check(text);
+
+            size_t i = 0U;
+            while (i < length && ++ digits[i] == letters) {
+                digits[i ++] = 0U;
+            }
+            if (i == length) {
+                break;
+            }
+        }
+    }
+}
+
+static void assertLongMatchesStrtol(const std::string &text) {
+    LongParse parsed = ParseUtils::parseLong(text.data(), text.length());
+    errno = 0;
+    char* end = nullptr;
+    long expected = strtol(text.c_str(), &end, 10);
+    size_t consumed = end - text.c_str();
+    if (consumed == 0U) { // strtol gives 0 for nothing parsed...
+        TEST_ASSERT_EQUAL_INT_MESSAGE(PE_INVALID, parsed.error, text.c_str());
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(0U, parsed.consumed, text.c_str());
+
+        return;
+    }
+    TEST_ASSERT_EQUAL_INT_MESSAGE((errno == ERANGE) ? PE_OUT_OF_RANGE : PE_OK, parsed.error, text.c_str());
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(consumed, parsed.consumed, text.c_str());
+    TEST_ASSERT_TRUE_MESSAGE(expected == parsed.value, text.c_str());
+}
+
+static void assertDoubleMatchesStrtod(const std::string &text) {
+    DoubleParse parsed = ParseUtils::parseDouble(text.data(), text.length());
+    errno = 0;
+    char* end = nullptr;
+    double expected = strtod(text.c_str(), &end);
+    size_t consumed = end - text.c_str();
+    if (consumed == 0U) {
+        TEST_ASSERT_EQUAL_INT_MESSAGE(PE_INVALID, parsed.error, text.c_str());
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(0U, parsed.consumed, text.c_str());
+
+        return;
+    }
+    TEST_ASSERT_EQUAL_INT_MESSAGE((errno == ERANGE) ? PE_OUT_OF_RANGE : PE_OK, parsed.error, text.c_str());
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(consumed, parsed.consumed, text.c_str());
+    TEST_ASSERT_TRUE_MESSAGE(memcmp(&expected, &parsed.value, sizeof(double)) == 0, text.c_str()); // Same bits, even -0.0...
+}
+
+/**
+ * @return Returns a random string of digits of the given length as std::string.
+*/
+static std::string randomDigits(size_t length) {
+    std::string digits;
+    for (size_t i = 0U; i < length; i ++) {
+        digits += (char)('0' + (random64() % 10ULL));
+    }
+
+    return digits;
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_every_short_string_matches_strtol() {
+    forEveryString("0159-+.ex", EXHAUSTIVE_LENGTH, assertLongMatchesStrtol);
+}
+
+void test_long_limits_match_strtol() {
+    char text[32];
+    const long limits[] = {LONG_MAX, LONG_MIN, LONG_MAX - 1L, LONG_MIN + 1L, 0L};
+    for (long limit : limits) {
+        snprintf(text, sizeof(text), "%ld", limit);
+        assertLongMatchesStrtol(text);
+    }
+    assertLongMatchesStrtol("9223372036854775808");
+    assertLongMatchesStrtol("-9223372036854775809");
+    assertLongMatchesStrtol("18446744073709551616");
+    assertLongMatchesStrtol("-0");
+    assertLongMatchesStrtol(std::string(400U, '9') + "x");
+    assertLongMatchesStrtol("-" + std::string(400U, '0') + "42");
+}
+
+void test_long_differs_from_strtol_only_where_intended() {
+    LongParse parsed = ParseUtils::parseLong(" 42", 3U); // No leading whitespace...
+    TEST_ASSERT_EQUAL_INT(PE_INVALID, parsed.error);
+    TEST_ASSERT_EQUAL_UINT32(0U, parsed.consumed);
+
+    parsed = ParseUtils::parseLong("0", 1U); // Tells "0" apart from nothing...
+    TEST_ASSERT_EQUAL_INT(PE_OK, parsed.error);
+    TEST_ASSERT_EQUAL_UINT32(1U, parsed.consumed);
+
+    parsed = ParseUtils::parseLong("12345", 3U); // Stops at the length given...
+    TEST_ASSERT_EQUAL_INT32(123, parsed.value);
+}
+
+void test_every_short_string_matches_strtod() {
+    forEveryString("0159-+.eE", EXHAUSTIVE_LENGTH, assertDoubleMatchesStrtod);
+}
+
+void test_random_doubles_match_strtod() {
+    char text[64];
+    const char* formats[] = {"%.17g", "%.*g", "%.*e", "%.*f"};
+    for (unsigned long i = 0UL; i < RANDOM_DOUBLES; i ++) {
+        uint64_t bits = random64();
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        if (!isfinite(value)) {
+            continue;
+        }
+        int precision = (int)(random64() % 20ULL);
+        size_t format = i % 4UL;
+        if (format == 3UL && fabs(value) > 1e30) { // Keeps %f short enough to read...
+            value = ldexp(value, -ilogb(value) + (int)(random64() % 60ULL));
+        }
+        if (format == 0UL) {
+            snprintf(text, sizeof(text), formats[format], value);
+        } else {
+            snprintf(text, sizeof(text), formats[format], precision, value);
+        }
+        assertDoubleMatchesStrtod(text);
+    }
+}
+
+void test_long_inputs_match_strtod() {
+    for (unsigned long i = 0UL; i < LONG_INPUTS; i ++) {
+        std::string text = (random64() & 1ULL) ? "-" : "";
+        text += std::string(random64() % 4ULL, '0') + randomDigits(1U + (random64() % 300ULL));
+        if (random64() & 1ULL) {
+            text += "." + randomDigits(random64() % 300ULL);
+        }
+        if (random64() & 1ULL) {
+            text += "e" + std::to_string((long)(random64() % 700ULL) - 350L);
+        }
+        assertDoubleMatchesStrtod(text);
+    }
+}
+
+void test_sticky_digit_rounds_past_the_buffer() {
+    std::string halfway = "9007199254740993"; // Halfway between two doubles...
+    std::string zeros(80U, '0');
+
+    assertDoubleMatchesStrtod(halfway + "." + zeros); // Ties to even, down
+    assertDoubleMatchesStrtod(halfway + "." + zeros + "1"); // Just past, up
+    assertDoubleMatchesStrtod("0." + zeros + halfway + zeros + "1e96");
+    assertDoubleMatchesStrtod(std::string(400U, '9') + "e-400");
+    assertDoubleMatchesStrtod("1" + zeros + zeros + zeros + zeros + "e-10");
+    assertDoubleMatchesStrtod("-" + std::string(320U, '9')); // Too large, -HUGE_VAL...
+}
+
+void test_underflow_is_out_of_range() {
+    std::string zeros(400U, '0');
+    const std::string tooSmall[] = {"1e-400", "-1e-400", "4.9e-324", "2.2e-310", "0." + zeros + "1", "-0." + zeros + "25e10"};
+    for (const std::string &text : tooSmall) {
+        assertDoubleMatchesStrtod(text);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(PE_OUT_OF_RANGE, ParseUtils::parseDouble(text.data(), text.length()).error, text.c_str());
+    }
+    const std::string inRange[] = {"0e-400", "0." + zeros, "2.2250738585072014e-308", "1e-300"}; // Zero itself, smallest normal...
+    for (const std::string &text : inRange) {
+        assertDoubleMatchesStrtod(text);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(PE_OK, ParseUtils::parseDouble(text.data(), text.length()).error, text.c_str());
+    }
+    errno = EDOM;
+    ParseUtils::parseDouble("1e-400", 6U);
+
+    TEST_ASSERT_EQUAL_INT(EDOM, errno); // Caller's errno left alone...
+}
+
+void test_double_differs_from_strtod_only_where_intended() {
+    const char* unsupported[] = {"0x1p3", "inf", "nan", " 1.5"};
+    const size_t consumed[] = {1U, 0U, 0U, 0U};
+    for (size_t i = 0U; i < 4U; i ++) {
+        DoubleParse parsed = ParseUtils::parseDouble(unsupported[i], strlen(unsupported[i]));
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(consumed[i], parsed.consumed, unsupported[i]);
+    }
+    DoubleParse parsed = ParseUtils::parseDouble("2.5e", 4U); // Exponent without digits isn't part of it...
+
+    TEST_ASSERT_EQUAL_UINT32(3U, parsed.consumed);
+    TEST_ASSERT_EQUAL_DOUBLE(2.5, parsed.value);
+}
+
+void test_benchmark_against_the_c_library() {
+    const char* samples[] = {"587", "465", "25", "3", "-17", "2147483647", "12.5", "0.001", "-3.25e2", "6.02214076e23", "1.7976931348623157e308", "0.1"};
+    const size_t SAMPLE_COUNT = sizeof(samples) / sizeof(samples[0]);
+    size_t lengths[SAMPLE_COUNT];
+    for (size_t i = 0U; i < SAMPLE_COUNT; i ++) {
+        lengths[i] = strlen(samples[i]);
+    }
+    volatile double sink = 0.0;
+
+    auto started = std::chrono::steady_clock::now();
+    for (unsigned long run = 0UL; run < BENCHMARK_RUNS * 1000UL; run ++) {
+        const char* text = samples[run % SAMPLE_COUNT];
+        sink = sink + (double)strtol(text, nullptr, 10) + strtod(text, nullptr);
+    }
+    double libraryNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started).count() / (BENCHMARK_RUNS * 1000UL);
+
+    started = std::chrono::steady_clock::now();
+    for (unsigned long run = 0UL; run < BENCHMARK_RUNS * 1000UL; run ++) {
+        size_t i = run % SAMPLE_COUNT;
+        sink = sink + (double)ParseUtils::parseLong(samples[i], lengths[i]).value + ParseUtils::parseDouble(samples[i], lengths[i]).value;
+    }
+    double parseNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started).count() / (BENCHMARK_RUNS * 1000UL);
+
+    char report[160];
+    snprintf(report, sizeof(report), "One long and one double parsed: strtol and strtod %.1f ns, parseLong and parseDouble %.1f ns", libraryNs, parseNs);
+    TEST_MESSAGE(report);
+
+    TEST_ASSERT_TRUE(sink != 0.0);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_every_short_string_matches_strtol);
+    RUN_TEST(test_long_limits_match_strtol);
+    RUN_TEST(test_long_differs_from_strtol_only_where_intended);
+    RUN_TEST(test_every_short_string_matches_strtod);
+    RUN_TEST(test_random_doubles_match_strtod);
+    RUN_TEST(test_long_inputs_match_strtod);
+    RUN_TEST(test_sticky_digit_rounds_past_the_buffer);
+    RUN_TEST(test_underflow_is_out_of_range);
+    RUN_TEST(test_double_differs_from_strtod_only_where_intended);
+    RUN_TEST(test_benchmark_against_the_c_library);
+
+    return UNITY_END();
+}
@@ -0,0 +1,195 @@
+/*
+ * Tests of ParseUtils replace, replaceInPlace and countMatches. Random text
+ * and patterns are checked against a plain std::string::find scan, which
+ * is the reference for the memchr and memcmp search they use. Ends with a
+ * benchmark over large inputs of each against the reference.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include <unity.h>
+#include <HeapTracker.h>
+#include <chrono>
+#include <random>
+#include <string>
+#include <stdio.h>
+#include <ParseUtils.h>
+
+#define PROPERTY_CASES 20000UL
+#define BENCHMARK_TEXT_LENGTH (1024UL * 1024UL)
+#define BENCHMARK_RUNS 20UL
+
+static std::mt19937 random32(20261016UL);
+
+/**
+ * @return Returns text of the given length over the first letters of the
+ * alphabet, few enough that patterns match often, as std::string.
+*/
+static std::string randomText(size_t length, char letters) {
+    std::uniform_int_distribution<int> pick(0, letters - 1);
+    std::string text;
+    for (size_t i = 0U; i < length; i ++) {
+        text += (char)('a' + pick(random32));
+    }
+
+    return text;
+}
+
+/**
+ * The reference count, without overlap, the same as replace walks it.
+*/
+static unsigned int referenceCount(const std::string &text, const std::string &pattern) {
+    if (pattern.empty()) {
+
+        return 0U;
+    }
+    unsigned int count = 0U;
+    for (size_t at = text.find(pattern); at != std::string::npos; at = text.find(pattern, at + pattern.length())) {
+        count ++;
+    }
+
+    return count;
+}
+
+static std::string referenceReplace(const std::string &text, const std::string &find, const std::string &replaceWith) {
+    if (find.empty()) {
+
+        return text;
+    }
+    std::string result;
+    size_t from = 0U;
+    for (size_t at = text.find(find); at != std::string::npos; at = text.find(find, from)) {
+        result.append(text, from, at - from);
+        result += replaceWith;
+        from = at + find.length();
+    }
+    result.append(text, from, std::string::npos);
+
+    return result;
+}
+
+/**
+ * @return Returns a pattern which is sometimes cut out of the text, so it
+ * is sure to match, and sometimes made up, as std::string.
+*/
+static std::string randomPattern(const std::string &text, size_t maxLength, char letters) {
+    std::uniform_int_distribution<size_t> lengthOf(1U, maxLength);
+    size_t length = lengthOf(random32);
+    if ((random32() & 1U) && length <= text.length()) {
+        std::uniform_int_distribution<size_t> startOf(0U, text.length() - length);
+
+        return text.substr(startOf(random32), length);
+    }
+
+    return randomText(length, letters);
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_matches_the_reference_on_random_text() {
+    std::uniform_int_distribution<size_t> lengthOf(0U, 300U);
+    std::uniform_int_distribution<size_t> replaceLengthOf(0U, 6U);
+    for (unsigned long i = 0UL; i < PROPERTY_CASES; i ++) {
+        char letters = (char)(2 + (i % 3UL));
+        std::string text = randomText(lengthOf(random32), letters);
+        std::string find = randomPattern(text, 8U, letters);
+        std::string replaceWith = randomText(replaceLengthOf(random32), 'z' - 'a' + 1);
+
+        TEST_ASSERT_EQUAL_UINT32(referenceCount(text, find), ParseUtils::countMatches(text.data(), text.length(), find.data(), find.length()));
+        TEST_ASSERT_EQUAL_UINT32(referenceCount(text, find), ParseUtils::occurrences(text, find));
+        std::string expected = referenceReplace(text, find, replaceWith);
+        TEST_ASSERT_EQUAL_STRING(expected.c_str(), ParseUtils::replace(text, find, replaceWith).c_str());
+        std::string inPlace = text;
+        ParseUtils::replaceInPlace(inPlace, find, replaceWith);
+        TEST_ASSERT_EQUAL_STRING(expected.c_str(), inPlace.c_str());
+    }
+}
+
+void test_long_patterns_match_the_reference() {
+    for (unsigned long i = 0UL; i < 500UL; i ++) {
+        std::string text = randomText(2000U, 2);
+        std::string find = randomPattern(text, 400U, 2);
+        TEST_ASSERT_EQUAL_UINT32(referenceCount(text, find), ParseUtils::countMatches(text.data(), text.length(), find.data(), find.length()));
+    }
+    std::string block(300U, 'q');
+    std::string text = "x" + block + "y" + block + block;
+
+    TEST_ASSERT_EQUAL_UINT32(3U, ParseUtils::occurrences(text, block));
+    TEST_ASSERT_EQUAL_STRING("x-y--", ParseUtils::replace(text, block, "-").c_str());
+}
+
+void test_edge_cases() {
+    std::string empty;
+    std::string text = "aaaa";
+
+    TEST_ASSERT_EQUAL_UINT32(0U, ParseUtils::occurrences(text, empty));
+    TEST_ASSERT_EQUAL_STRING("aaaa", ParseUtils::replace(text, "", "b").c_str());
+    TEST_ASSERT_EQUAL_UINT32(0U, ParseUtils::occurrences(empty, std::string("a")));
+    TEST_ASSERT_EQUAL_UINT32(2U, ParseUtils::occurrences(text, std::string("aa"))); // No overlap...
+    TEST_ASSERT_EQUAL_STRING("ba", ParseUtils::replace(text, "aaa", "b").c_str());
+    TEST_ASSERT_EQUAL_STRING("", ParseUtils::replace(text, "a", "").c_str());
+    std::string slots = "a${x}b${x}c";
+    TEST_ASSERT_EQUAL_STRING("a-b-c", ParseUtils::replace(slots, "${x}", "-").c_str());
+    std::string tail = "head${x}tail";
+    TEST_ASSERT_EQUAL_STRING("head=tail", ParseUtils::replace(tail, "${x}", "=").c_str()); // Keeps what follows the last match...
+}
+
+void test_in_place_does_not_allocate_when_not_longer() {
+    std::string text = randomText(4096U, 3);
+    std::string find = "abc";
+    std::string shorter = "Z";
+    std::string expected = referenceReplace(text, find, shorter);
+    allocationCount = 0UL;
+    ParseUtils::replaceInPlace(text, find, shorter);
+
+    TEST_ASSERT_EQUAL_UINT32(0UL, allocationCount);
+    TEST_ASSERT_EQUAL_STRING(expected.c_str(), text.c_str());
+
+    std::string longer = "[abc]";
+    expected = referenceReplace(text, "Z", longer);
+    allocationCount = 0UL;
+    std::string result = ParseUtils::replace(text, "Z", longer);
+
+    TEST_ASSERT_EQUAL_UINT32(1UL, allocationCount); // Sized once up front...
+    TEST_ASSERT_EQUAL_STRING(expected.c_str(), result.c_str());
+}
+
+void test_benchmark_against_the_reference() {
+    std::string text = randomText(BENCHMARK_TEXT_LENGTH, 4);
+    std::string find = "abcdabca";
+    std::string replaceWith = "${replaced}";
+    text.replace(BENCHMARK_TEXT_LENGTH / 2UL, find.length(), find);
+    unsigned long checksum = 0UL;
+
+    auto started = std::chrono::steady_clock::now();
+    for (unsigned long i = 0UL; i < BENCHMARK_RUNS; i ++) {
+        checksum += referenceCount(text, find) + referenceReplace(text, find, replaceWith).length();
+    }
+    double referenceMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count() / BENCHMARK_RUNS;
+
+    started = std::chrono::steady_clock::now();
+    for (unsigned long i = 0UL; i < BENCHMARK_RUNS; i ++) {
+        checksum -= ParseUtils::countMatches(text.data(), text.length(), find.data(), find.length()) + ParseUtils::replace(text, find, replaceWith).length();
+    }
+    double searchMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count() / BENCHMARK_RUNS;
+
+    char report[160];
+    snprintf(report, sizeof(report), "Count and replace over %lu KiB: std::string::find %.3f ms, ParseUtils %.3f ms", BENCHMARK_TEXT_LENGTH / 1024UL, referenceMs, searchMs);
+    TEST_MESSAGE(report);
+
+    TEST_ASSERT_EQUAL_UINT32(0UL, checksum); // Both gave the same...
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_matches_the_reference_on_random_text);
+    RUN_TEST(test_long_patterns_match_the_reference);
+    RUN_TEST(test_edge_cases);
+    RUN_TEST(test_in_place_does_not_allocate_when_not_longer);
+    RUN_TEST(test_benchmark_against_the_reference);
+
+    return UNITY_END();
+}
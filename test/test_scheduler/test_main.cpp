@@ -0,0 +1,173 @@
+/*
+ * Tests of the Scheduler, driven by a fake clock so time only moves when a
+ * test moves it.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include <unity.h>
+#include <Scheduler.h>
+
+static unsigned long fakeNow = 0UL;
+static int runsA = 0;
+static int runsB = 0;
+static int order[8];
+static int orderCount = 0;
+
+static unsigned long fakeClock() {
+
+    return fakeNow;
+}
+
+static void taskA() {
+    runsA ++;
+    order[orderCount++ & 7] = 1;
+}
+
+static void taskB() {
+    runsB ++;
+    order[orderCount++ & 7] = 2;
+}
+
+void setUp() {
+    fakeNow = 0UL;
+    runsA = 0;
+    runsB = 0;
+    orderCount = 0;
+}
+
+void tearDown() {}
+
+void test_periodic_task_runs_on_first_tick_then_each_interval() {
+    Scheduler scheduler(fakeClock);
+    scheduler.every(100UL, taskA);
+
+    scheduler.run();
+    TEST_ASSERT_EQUAL_INT(1, runsA);
+    fakeNow = 99UL;
+    scheduler.run();
+    TEST_ASSERT_EQUAL_INT(1, runsA);
+    fakeNow = 100UL;
+    scheduler.run();
+    TEST_ASSERT_EQUAL_INT(2, runsA);
+    fakeNow = 250UL;
+    scheduler.run();
+    TEST_ASSERT_EQUAL_INT(3, runsA);
+    fakeNow = 300UL; // Stays on its original beat...
+    scheduler.run();
+    TEST_ASSERT_EQUAL_INT(4, runsA);
+}
+
+void test_periodic_task_resyncs_instead_of_catching_up() {
+    Scheduler scheduler(fakeClock);
+    scheduler.every(100UL, taskA);
+    scheduler.run();
+
+    fakeNow = 1000UL; // Loop was blocked for many intervals...
+    scheduler.run();
+    scheduler.run();
+    TEST_ASSERT_EQUAL_INT(2, runsA);
+    TEST_ASSERT_EQUAL_UINT32(100UL, scheduler.timeUntilNext());
+}
+
+void test_one_shot_runs_once_after_its_delay() {
+    Scheduler scheduler(fakeClock);
+    int id = scheduler.after(50UL, taskA);
+    TEST_ASSERT_TRUE(scheduler.isScheduled(id));
+
+    fakeNow = 49UL;
+    scheduler.run();
+    TEST_ASSERT_EQUAL_INT(0, runsA);
+    fakeNow = 50UL;
+    scheduler.run();
+    fakeNow = 500UL;
+    scheduler.run();
+    TEST_ASSERT_EQUAL_INT(1, runsA);
+    TEST_ASSERT_FALSE(scheduler.isScheduled(id));
+}
+
+void test_due_tasks_run_in_registration_order() {
+    Scheduler scheduler(fakeClock);
+    scheduler.after(10UL, taskB);
+    scheduler.after(5UL, taskA);
+
+    fakeNow = 10UL;
+    scheduler.run();
+    TEST_ASSERT_EQUAL_INT(2, orderCount);
+    TEST_ASSERT_EQUAL_INT(2, order[0]);
+    TEST_ASSERT_EQUAL_INT(1, order[1]);
+}
+
+void test_cancel_and_reschedule() {
+    Scheduler scheduler(fakeClock);
+    int a = scheduler.after(10UL, taskA);
+    int b = scheduler.after(10UL, taskB);
+    scheduler.cancel(a);
+    fakeNow = 5UL;
+    scheduler.reschedule(b, 20UL);
+
+    fakeNow = 24UL;
+    scheduler.run();
+    TEST_ASSERT_EQUAL_INT(0, runsA);
+    TEST_ASSERT_EQUAL_INT(0, runsB);
+    fakeNow = 25UL;
+    scheduler.run();
+    TEST_ASSERT_EQUAL_INT(1, runsB);
+}
+
+void test_stale_id_does_not_touch_task_reusing_its_slot() {
+    Scheduler scheduler(fakeClock);
+    int stale = scheduler.after(10UL, taskA);
+    fakeNow = 10UL;
+    scheduler.run(); // Slot is released...
+
+    int reused = scheduler.after(10UL, taskB);
+    TEST_ASSERT_NOT_EQUAL(stale, reused);
+    TEST_ASSERT_FALSE(scheduler.isScheduled(stale));
+
+    scheduler.cancel(stale);
+    scheduler.reschedule(stale, 1000UL);
+    TEST_ASSERT_TRUE(scheduler.isScheduled(reused));
+    fakeNow = 20UL;
+    scheduler.run();
+    TEST_ASSERT_EQUAL_INT(1, runsB);
+}
+
+void test_full_table_and_bad_ids() {
+    Scheduler scheduler(fakeClock);
+    for (int i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        TEST_ASSERT_NOT_EQUAL(SCHEDULER_NO_TASK, scheduler.every(10UL, taskA));
+    }
+    TEST_ASSERT_EQUAL_INT(SCHEDULER_NO_TASK, scheduler.every(10UL, taskA));
+    TEST_ASSERT_EQUAL_INT(SCHEDULER_NO_TASK, Scheduler(fakeClock).after(1UL, nullptr));
+    TEST_ASSERT_FALSE(scheduler.isScheduled(SCHEDULER_NO_TASK));
+    TEST_ASSERT_FALSE(scheduler.isScheduled(SCHEDULER_MAX_TASKS));
+}
+
+void test_deadlines_survive_clock_wraparound() {
+    Scheduler scheduler(fakeClock);
+    fakeNow = 0xFFFFFFF0UL;
+    scheduler.after(0x20UL, taskA); // Due after the clock wraps...
+
+    scheduler.run();
+    TEST_ASSERT_EQUAL_INT(0, runsA);
+    TEST_ASSERT_EQUAL_UINT32(0x20UL, scheduler.timeUntilNext());
+    fakeNow = 0x10UL;
+    scheduler.run();
+    TEST_ASSERT_EQUAL_INT(1, runsA);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_periodic_task_runs_on_first_tick_then_each_interval);
+    RUN_TEST(test_periodic_task_resyncs_instead_of_catching_up);
+    RUN_TEST(test_one_shot_runs_once_after_its_delay);
+    RUN_TEST(test_due_tasks_run_in_registration_order);
+    RUN_TEST(test_cancel_and_reschedule);
+    RUN_TEST(test_stale_id_does_not_touch_task_reusing_its_slot);
+    RUN_TEST(test_full_table_and_bad_ids);
+    RUN_TEST(test_deadlines_survive_clock_wraparound);
+
+    return UNITY_END();
+}
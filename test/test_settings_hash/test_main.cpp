@@ -0,0 +1,352 @@
+/*
+ * Tests of the settings hash and the header stored ahead of the settings,
+ * including the migration of settings stored by older firmware. Ends with
+ * a benchmark of the String built MD5 the settings were hashed with before
+ * against the CRC32 the fields are streamed into now, giving the time and
+ * the peak heap of each.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include <unity.h>
+#include <HeapTracker.h>
+#include <chrono>
+#include <string>
+#include <stdio.h>
+#include <Settings.h>
+
+#define BENCHMARK_HASHES 20000UL
+
+static Settings* settings = nullptr;
+
+/**
+ * The hash as it was before, a copy of the struct and an MD5 over a String
+ * built up from every field, which is also the sentinel of format v1.
+*/
+static String legacyHash(struct NonVolatileSettings nvSet) {
+    String content = "";
+    content = content + String(nvSet.ssid);
+    content = content + String(nvSet.pwd);
+    content = content + String(nvSet.owner);
+    content = content + String(nvSet.message);
+    content = content + String(nvSet.smtpHost);
+    content = content + String(nvSet.smtpPort);
+    content = content + String(nvSet.smtpUser);
+    content = content + String(nvSet.smtpPwd);
+    content = content + String(nvSet.fromEmail);
+    content = content + String(nvSet.fromName);
+    content = content + String(nvSet.recipients);
+    content = content + String(nvSet.inPanicMode);
+    content = content + String(nvSet.panicLevel);
+
+    MD5Builder builder = MD5Builder();
+    builder.begin();
+    builder.add(content);
+    builder.calculate();
+
+    return builder.toString();
+}
+
+/**
+ * The hash as it is now, worked out apart from Settings so that the hash
+ * in the stored header can be checked against it.
+*/
+static uint32_t streamedHash(const NonVolatileSettings &nvSet) {
+    uint32_t crc = 0xFFFFFFFFUL;
+    SettingField field;
+    for (uint8_t i = 0; i < SETTING_FIELD_COUNT; i ++) {
+        Settings::readField(i, field);
+        if (!(field.flags & SETTING_HASHED)) {
+            continue;
+        }
+        if (field.type == SETTING_TYPE_TEXT) {
+            const char* text = Settings::textOf(nvSet, field);
+            crc = CrcUtils::crc32Update(crc, text, strnlen(text, field.size - 1) + 1U);
+        } else if (field.type == SETTING_TYPE_BOOL) {
+            uint8_t flag = (Settings::readNumber(nvSet, field) ? 1U : 0U);
+            crc = CrcUtils::crc32Update(crc, &flag, sizeof(flag));
+        } else {
+            crc = CrcUtils::crc32Update(crc, ((const uint8_t*)&nvSet) + field.offset, field.size);
+        }
+    }
+
+    return ~crc;
+}
+
+/**
+ * Settings as they would be on a configured device.
+*/
+static NonVolatileSettings configuredSettings() {
+    NonVolatileSettings nvSet = {};
+    strcpy(nvSet.ssid, "The-Neighbourhood-Network");
+    strcpy(nvSet.pwd, "a-fairly-long-wifi-password");
+    strcpy(nvSet.owner, "Pat at 12 Elm Street");
+    strcpy(nvSet.message, "Please send help ASAP!");
+    strcpy(nvSet.smtpHost, "smtp.mail-provider.example.com");
+    nvSet.smtpPort = 587U;
+    strcpy(nvSet.smtpUser, "panic-button@mail-provider.example.com");
+    strcpy(nvSet.smtpPwd, "an-smtp-app-password");
+    strcpy(nvSet.fromEmail, "panic-button@mail-provider.example.com");
+    strcpy(nvSet.fromName, "FriendlyNeighbor PanicButton");
+    strcpy(nvSet.recipients, "first.person@example.com;second.person@example.com");
+    nvSet.inPanicMode = true;
+    nvSet.panicLevel = 3;
+
+    return nvSet;
+}
+
+/**
+ * Finds the newest snapshot in the fake flash and reads its header and
+ * settings, as laid out by the journal.
+ *
+ * @return Returns true if a snapshot was found as bool.
+*/
+static bool readStoredSnapshot(SettingsHeader &header, NonVolatileSettings &nvSet) {
+    uint32_t firstSector = (fakeEepromOffset / JOURNAL_SECTOR_SIZE) - (SETTINGS_JOURNAL_SECTORS - 1);
+    bool isFound = false;
+    uint32_t newest = 0UL;
+    for (uint32_t i = 0; i < SETTINGS_JOURNAL_SECTORS; i ++) {
+        const uint8_t* sector = ESP.getFlash() + ((firstSector + i) * JOURNAL_SECTOR_SIZE);
+        JournalSectorHeader sectorHeader;
+        memcpy(&sectorHeader, sector, sizeof(sectorHeader));
+        if (sectorHeader.magic != JOURNAL_MAGIC || (isFound && (int32_t)(sectorHeader.generation - newest) <= 0)) {
+            continue;
+        }
+        const uint8_t* record = sector + sizeof(JournalSectorHeader) + sizeof(JournalRecordHeader);
+        memcpy(&header, record, sizeof(header));
+        memcpy(&nvSet, record + sizeof(header), sizeof(nvSet));
+        newest = sectorHeader.generation;
+        isFound = true;
+    }
+
+    return isFound;
+}
+
+/**
+ * Stores settings through EEPROM the way older firmware did, as format v1.
+*/
+static void storeLegacySettings(NonVolatileSettings nvSet, const char* sentinel) {
+    strncpy(nvSet.sentinel, sentinel, sizeof(nvSet.sentinel) - 1);
+    EEPROM.begin(sizeof(NonVolatileSettings));
+    EEPROM.put(0, nvSet);
+    EEPROM.commit();
+    EEPROM.end();
+}
+
+void setUp() {
+    ESP.restorePower();
+    ESP.eraseAll();
+    EEPROM.clear();
+    fakeFsEndOffset = 0x3FA000UL;
+    settings = new Settings();
+}
+
+void tearDown() {
+    delete settings;
+    fakeFsEndOffset = 0x3FA000UL;
+}
+
+void test_crc32_gives_the_standard_check_value() {
+    uint32_t crc = ~CrcUtils::crc32Update(0xFFFFFFFFUL, "123456789", 9U);
+
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926UL, crc);
+}
+
+void test_crc32_streamed_in_pieces_matches_one_pass() {
+    NonVolatileSettings nvSet = configuredSettings();
+    uint32_t whole = CrcUtils::crc32Update(0xFFFFFFFFUL, &nvSet, sizeof(nvSet));
+    uint32_t pieces = 0xFFFFFFFFUL;
+    const uint8_t* bytes = (const uint8_t*)&nvSet;
+    for (size_t at = 0U, piece = 1U; at < sizeof(nvSet); at += piece, piece = (piece % 13U) + 1U) {
+        pieces = CrcUtils::crc32Update(pieces, bytes + at, ((at + piece) > sizeof(nvSet)) ? (sizeof(nvSet) - at) : piece);
+    }
+
+    TEST_ASSERT_EQUAL_HEX32(whole, pieces);
+}
+
+void test_stored_header_identifies_format_and_hash() {
+    NonVolatileSettings configured = configuredSettings();
+    settings->applyFields(configured, SETTING_HASHED);
+    TEST_ASSERT_TRUE(settings->saveSettings());
+
+    SettingsHeader header;
+    NonVolatileSettings stored;
+    TEST_ASSERT_TRUE(readStoredSnapshot(header, stored));
+    TEST_ASSERT_EQUAL_HEX32(SETTINGS_MAGIC, header.magic);
+    TEST_ASSERT_EQUAL_UINT16(SETTINGS_FORMAT_VERSION, header.version);
+    TEST_ASSERT_EQUAL_UINT16(SETTINGS_HASH_CRC32, header.hashType);
+    TEST_ASSERT_EQUAL_HEX32(streamedHash(stored), header.hash);
+    TEST_ASSERT_EQUAL_HEX32(streamedHash(configured), header.hash);
+}
+
+void test_hash_ignores_what_follows_a_terminator() {
+    NonVolatileSettings first = configuredSettings();
+    NonVolatileSettings second = configuredSettings();
+    memset(second.owner + strlen(second.owner) + 1U, 'z', 20U); // Leftovers of a longer owner...
+    memset(second.sentinel, 'q', sizeof(second.sentinel)); // Not hashed at all...
+
+    settings->applyFields(first, SETTING_HASHED);
+    TEST_ASSERT_TRUE(settings->saveSettings());
+    SettingsHeader firstHeader;
+    NonVolatileSettings stored;
+    TEST_ASSERT_TRUE(readStoredSnapshot(firstHeader, stored));
+
+    settings->applyFields(second, SETTING_HASHED);
+    TEST_ASSERT_TRUE(settings->saveSettings());
+    SettingsHeader secondHeader;
+    TEST_ASSERT_TRUE(readStoredSnapshot(secondHeader, stored));
+
+    TEST_ASSERT_EQUAL_HEX32(firstHeader.hash, secondHeader.hash);
+
+    settings->setPanicLevel(4);
+    TEST_ASSERT_TRUE(settings->saveSettings());
+    TEST_ASSERT_TRUE(readStoredSnapshot(secondHeader, stored));
+    TEST_ASSERT_NOT_EQUAL(firstHeader.hash, secondHeader.hash);
+}
+
+void test_saved_settings_load_back() {
+    settings->applyFields(configuredSettings(), SETTING_HASHED);
+    TEST_ASSERT_TRUE(settings->saveSettings());
+
+    Settings loaded;
+    TEST_ASSERT_TRUE(loaded.loadSettings());
+    TEST_ASSERT_EQUAL_STRING("Pat at 12 Elm Street", loaded.viewOwner().chars);
+    TEST_ASSERT_EQUAL_UINT(587U, loaded.getSmtpPort());
+    TEST_ASSERT_TRUE(loaded.getInPanicMode());
+    TEST_ASSERT_EQUAL_INT(3, loaded.getPanicLevel());
+}
+
+void test_eeprom_settings_with_a_bad_hash_are_defaulted() {
+    fakeFsEndOffset = fakeEepromOffset; // Filesystem runs up to EEPROM, no journal...
+    Settings eepromOnly;
+    eepromOnly.applyFields(configuredSettings(), SETTING_HASHED);
+    TEST_ASSERT_TRUE(eepromOnly.saveSettings());
+
+    SettingsHeader header;
+    NonVolatileSettings nvSet;
+    EEPROM.begin(sizeof(SettingsHeader) + sizeof(NonVolatileSettings));
+    EEPROM.get(0, header);
+    EEPROM.get(sizeof(SettingsHeader), nvSet);
+    TEST_ASSERT_EQUAL_HEX32(streamedHash(nvSet), header.hash);
+    nvSet.owner[0] = 'R'; // One changed byte...
+    EEPROM.put(sizeof(SettingsHeader), nvSet);
+    EEPROM.commit();
+    EEPROM.end();
+
+    Settings loaded;
+    TEST_ASSERT_FALSE(loaded.loadSettings());
+    TEST_ASSERT_TRUE(loaded.isOwnerFactory());
+    TEST_ASSERT_TRUE(loaded.isFactoryDefault());
+}
+
+void test_eeprom_only_layout_round_trips() {
+    fakeFsEndOffset = fakeEepromOffset;
+    Settings eepromOnly;
+    eepromOnly.applyFields(configuredSettings(), SETTING_HASHED);
+    TEST_ASSERT_TRUE(eepromOnly.saveSettings());
+
+    Settings loaded;
+    TEST_ASSERT_TRUE(loaded.loadSettings());
+    TEST_ASSERT_EQUAL_STRING("Pat at 12 Elm Street", loaded.viewOwner().chars);
+    TEST_ASSERT_EQUAL_INT(3, loaded.getPanicLevel());
+
+    Serial.captured.clear();
+    Serial.isCapturing = true;
+    loaded.setInPanicMode(false);
+    TEST_ASSERT_TRUE(loaded.flush()); // Even the panic state rewrites it all...
+    Serial.isCapturing = false;
+    TEST_ASSERT_TRUE(Serial.captured.find("Saving all settings to EEPROM") != std::string::npos);
+
+    SettingsHeader header;
+    NonVolatileSettings stored;
+    TEST_ASSERT_FALSE(readStoredSnapshot(header, stored)); // Journal is left alone...
+}
+
+void test_legacy_settings_are_migrated_into_the_journal() {
+    NonVolatileSettings legacy = configuredSettings();
+    storeLegacySettings(legacy, legacyHash(legacy).c_str());
+
+    TEST_ASSERT_TRUE(settings->loadSettings());
+    TEST_ASSERT_EQUAL_STRING("Pat at 12 Elm Street", settings->viewOwner().chars);
+    TEST_ASSERT_EQUAL_STRING("first.person@example.com;second.person@example.com", settings->viewRecipients().chars);
+    TEST_ASSERT_EQUAL_INT(3, settings->getPanicLevel());
+
+    SettingsHeader header;
+    NonVolatileSettings stored;
+    TEST_ASSERT_TRUE(readStoredSnapshot(header, stored));
+    TEST_ASSERT_EQUAL_HEX32(streamedHash(legacy), header.hash);
+    TEST_ASSERT_EQUAL_STRING("NA", stored.sentinel);
+
+    EEPROM.clear(); // Journal alone must now hold them...
+    Settings migrated;
+    TEST_ASSERT_TRUE(migrated.loadSettings());
+    TEST_ASSERT_EQUAL_STRING("Pat at 12 Elm Street", migrated.viewOwner().chars);
+}
+
+void test_legacy_settings_with_a_bad_sentinel_are_defaulted() {
+    NonVolatileSettings legacy = configuredSettings();
+    String sentinel = legacyHash(legacy);
+    legacy.panicLevel = 1; // Changed after the sentinel was made...
+    storeLegacySettings(legacy, sentinel.c_str());
+
+    TEST_ASSERT_FALSE(settings->loadSettings());
+    TEST_ASSERT_TRUE(settings->isFactoryDefault());
+}
+
+void test_benchmark_streamed_hash_against_legacy_hash() {
+    NonVolatileSettings nvSet = configuredSettings();
+    volatile uint32_t sink = 0UL;
+
+    resetHeapStats();
+    size_t legacyBase = heapInUse;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long i = 0; i < BENCHMARK_HASHES; i ++) {
+        nvSet.panicLevel = (int)(i & 3UL);
+        sink = sink + legacyHash(nvSet).length();
+    }
+    auto legacyNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    size_t legacyPeak = heapPeak - legacyBase;
+    unsigned long legacyAllocations = allocationCount;
+
+    resetHeapStats();
+    size_t streamedBase = heapInUse;
+    start = std::chrono::steady_clock::now();
+    for (unsigned long i = 0; i < BENCHMARK_HASHES; i ++) {
+        nvSet.panicLevel = (int)(i & 3UL);
+        sink = sink + streamedHash(nvSet);
+    }
+    auto streamedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    size_t streamedPeak = heapPeak - streamedBase;
+    unsigned long streamedAllocations = allocationCount;
+
+    char line[160];
+    snprintf(line, sizeof(line), "Legacy MD5 hash: %lld ns each, %lu allocations, peak heap %u bytes, %u byte struct copy",
+        (long long)(legacyNs / BENCHMARK_HASHES), legacyAllocations / BENCHMARK_HASHES, (unsigned int)legacyPeak, (unsigned int)sizeof(nvSet));
+    TEST_MESSAGE(line);
+    snprintf(line, sizeof(line), "Streamed CRC32 hash: %lld ns each, %lu allocations, peak heap %u bytes, no struct copy",
+        (long long)(streamedNs / BENCHMARK_HASHES), streamedAllocations / BENCHMARK_HASHES, (unsigned int)streamedPeak);
+    TEST_MESSAGE(line);
+
+    TEST_ASSERT_EQUAL_UINT32(0UL, streamedAllocations);
+    TEST_ASSERT_EQUAL_UINT32(0U, streamedPeak);
+    TEST_ASSERT_GREATER_THAN(BENCHMARK_HASHES * 13UL, legacyAllocations); // A String per field at least...
+    TEST_ASSERT_GREATER_THAN(strlen(nvSet.recipients), legacyPeak);
+    (void)sink;
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_crc32_gives_the_standard_check_value);
+    RUN_TEST(test_crc32_streamed_in_pieces_matches_one_pass);
+    RUN_TEST(test_stored_header_identifies_format_and_hash);
+    RUN_TEST(test_hash_ignores_what_follows_a_terminator);
+    RUN_TEST(test_saved_settings_load_back);
+    RUN_TEST(test_eeprom_settings_with_a_bad_hash_are_defaulted);
+    RUN_TEST(test_eeprom_only_layout_round_trips);
+    RUN_TEST(test_legacy_settings_are_migrated_into_the_journal);
+    RUN_TEST(test_legacy_settings_with_a_bad_sentinel_are_defaulted);
+    RUN_TEST(test_benchmark_streamed_hash_against_legacy_hash);
+
+    return UNITY_END();
+}
@@ -0,0 +1,208 @@
+/*
+ * Tests of staging a settings update from the admin page. Every validation
+ * message of the update is produced, word for word, from an update which
+ * is otherwise valid, and a valid update must stage trimmed values without
+ * touching the live settings.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include <unity.h>
+#include <string>
+#include <SettingsUpdate.h>
+
+// *****************************************************************************
+// A setting of the update along with a valid value, an invalid value and the
+// messages expected for each way it can fail.
+// *****************************************************************************
+struct UpdateCase {
+    const char*    key                         ;
+    std::string    valid                       ; // As JSON
+    std::string    invalid                     ; // As JSON
+    const char*    invalidMessage              ;
+    const char*    requiredMessage             ;
+};
+
+static std::string quoted(const std::string &text) {
+
+    return "\"" + text + "\"";
+}
+
+static const UpdateCase CASES[] = {
+    {"ssid", quoted("Home-Net"), quoted(std::string(33, 's')), "SSID must not be longer than 32 characters!", "SSID is required for configuration!"},
+    {"pwd", quoted("wifi-pass"), quoted(std::string(64, 'p')), "Pwd must not be longer than 63 characters!", "Pwd is required for configuration!"},
+    {"owner", quoted("Pat at 12 Elm Street"), quoted(std::string(101, 'o')), "Owner must be no longer than 100 characters in length!", "Owner is required for configuration!"},
+    {"message", quoted("Please come quickly!"), quoted(std::string(101, 'm')), "Message must be no longer than 100 characters in length!", "Message is required for configuration!"},
+    {"smtp_host", quoted("smtp.example.com"), quoted(std::string(121, 'h')), "SMTP Host must not be longer than 120 characters!", "SMTP Host is required for configuration!"},
+    {"smtp_port", "587", "65536", "SMTP Port must be within valid port range!", "SMTP Port is required for configuration!"},
+    {"smtp_user", quoted("user@example.com"), quoted(std::string(121, 'u')), "SMTP User must be no longer than 120 characters in length!", "SMTP User is required for configuration!"},
+    {"smtp_pwd", quoted("an-app-password"), quoted(std::string(121, 'w')), "SMTP Password must be no longer than 120 characters in length!", "SMTP Password is required for configuration!"},
+    {"from_email", quoted("panic@example.com"), quoted(std::string(121, 'f')), "The 'From Email' must be no longer than 120 characters in length!", "The 'From Email' is required for configuration!"},
+    {"from_name", quoted("Panic Button"), quoted(std::string(51, 'n')), "The 'From Name' must be no longer than 50 characters in length!", "The 'From Name' is required for configuration!"},
+    {"recipients", quoted(" first@example.com ;; second@example.com; "), quoted("first@example.com;not-an-address"), "Recipients must be up to 16 valid emails split by ';' (509 chars max)!", "Recipients are required for configuration!"},
+    {"panic_level", "3", "6", "Panic Level must be greater than 0 and less than 6!", "Panic Level is required for configuration!"}
+};
+#define CASE_COUNT (sizeof(CASES) / sizeof(CASES[0]))
+
+static NonVolatileSettings staged;
+
+/**
+ * Builds an update with every setting valid, except for the one given by
+ * index which is given the value passed, or left out when that is null.
+*/
+static std::string buildUpdate(size_t index = CASE_COUNT, const char* value = "") {
+    std::string json = "{\"firmware\": \"ignored\"";
+    for (size_t i = 0; i < CASE_COUNT; i ++) {
+        if (i == index && value == nullptr) {
+            continue;
+        }
+        json += ", " + quoted(CASES[i].key) + ": " + ((i == index) ? std::string(value) : CASES[i].valid);
+    }
+    json += "}";
+
+    return json;
+}
+
+/**
+ * Parses and stages the given update the way the update endpoint does.
+ *
+ * @return Returns the message of the first problem, or "" if there was none, as std::string.
+*/
+static std::string stageUpdate(const std::string &json) {
+    JsonDocument filter;
+    SettingsUpdate::buildFilter(filter);
+    JsonDocument doc;
+    DeserializationError err = deserializeJson(doc, json.c_str(), json.length(), DeserializationOption::Filter(filter));
+    TEST_ASSERT_TRUE_MESSAGE(err.code() == DeserializationError::Ok, json.c_str());
+    const __FlashStringHelper* problem = SettingsUpdate::stage(doc.as<JsonObjectConst>(), staged);
+
+    return (problem == nullptr) ? std::string() : std::string(reinterpret_cast<const char*>(problem));
+}
+
+void setUp() {
+    memset(&staged, 0, sizeof(staged));
+}
+
+void tearDown() {}
+
+void test_cases_cover_every_exported_setting() {
+    SettingField field;
+    size_t exported = 0U;
+    for (uint8_t i = 0; i < SETTING_FIELD_COUNT; i ++) {
+        Settings::readField(i, field);
+        if (field.flags & SETTING_EXPORTED) {
+            TEST_ASSERT_EQUAL_STRING(CASES[exported].key, field.key);
+            exported ++;
+        }
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(CASE_COUNT, exported);
+}
+
+void test_valid_update_is_staged_trimmed() {
+    TEST_ASSERT_EQUAL_STRING("", stageUpdate(buildUpdate()).c_str());
+
+    TEST_ASSERT_EQUAL_STRING("Home-Net", staged.ssid);
+    TEST_ASSERT_EQUAL_STRING("Pat at 12 Elm Street", staged.owner);
+    TEST_ASSERT_EQUAL_UINT(587U, staged.smtpPort);
+    TEST_ASSERT_EQUAL_INT(3, staged.panicLevel);
+    TEST_ASSERT_EQUAL_STRING("first@example.com;second@example.com", staged.recipients);
+}
+
+void test_every_required_message() {
+    for (size_t i = 0; i < CASE_COUNT; i ++) {
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(CASES[i].requiredMessage, stageUpdate(buildUpdate(i, nullptr)).c_str(), CASES[i].key);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(CASES[i].requiredMessage, stageUpdate(buildUpdate(i, "\"  \"")).c_str(), CASES[i].key);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(CASES[i].requiredMessage, stageUpdate(buildUpdate(i, "null")).c_str(), CASES[i].key);
+    }
+}
+
+void test_every_invalid_message() {
+    for (size_t i = 0; i < CASE_COUNT; i ++) {
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(CASES[i].invalidMessage, stageUpdate(buildUpdate(i, CASES[i].invalid.c_str())).c_str(), CASES[i].key);
+    }
+}
+
+void test_factory_values_count_as_missing_where_not_allowed() {
+    SettingField field;
+    for (uint8_t i = 0; i < SETTING_FIELD_COUNT; i ++) {
+        Settings::readField(i, field);
+        if (!(field.flags & SETTING_EXPORTED) || field.type != SETTING_TYPE_TEXT) {
+            continue;
+        }
+        size_t index = 0U;
+        while (strcmp(CASES[index].key, field.key) != 0) {
+            index ++;
+        }
+        std::string factory = quoted(field.factoryText);
+        std::string result = stageUpdate(buildUpdate(index, factory.c_str()));
+        if (field.flags & SETTING_NOT_FACTORY) {
+            TEST_ASSERT_EQUAL_STRING_MESSAGE(CASES[index].requiredMessage, result.c_str(), field.key);
+        } else {
+            TEST_ASSERT_EQUAL_STRING_MESSAGE("", result.c_str(), field.key);
+        }
+    }
+}
+
+void test_numbers_given_as_text_or_fractions() {
+    size_t port = 5U;
+    size_t level = 11U;
+    TEST_ASSERT_EQUAL_STRING("", stageUpdate(buildUpdate(port, "\" 2525 \"")).c_str());
+    TEST_ASSERT_EQUAL_UINT(2525U, staged.smtpPort);
+    TEST_ASSERT_EQUAL_STRING("", stageUpdate(buildUpdate(level, "5.9")).c_str()); // Fraction dropped...
+    TEST_ASSERT_EQUAL_INT(5, staged.panicLevel);
+
+    TEST_ASSERT_EQUAL_STRING(CASES[port].invalidMessage, stageUpdate(buildUpdate(port, "\"25x\"")).c_str());
+    TEST_ASSERT_EQUAL_STRING(CASES[port].invalidMessage, stageUpdate(buildUpdate(port, "0")).c_str());
+    TEST_ASSERT_EQUAL_STRING(CASES[level].invalidMessage, stageUpdate(buildUpdate(level, "6.5")).c_str());
+    TEST_ASSERT_EQUAL_STRING(CASES[level].invalidMessage, stageUpdate(buildUpdate(level, "\"-1\"")).c_str());
+    TEST_ASSERT_EQUAL_STRING(CASES[level].requiredMessage, stageUpdate(buildUpdate(level, "true")).c_str());
+}
+
+void test_recipients_are_limited_in_count() {
+    size_t recipients = 10U;
+    std::string list;
+    for (int i = 0; i < SETTINGS_MAX_RECIPIENTS; i ++) {
+        list += std::string(list.empty() ? "" : ";") + "r" + std::to_string(i) + "@example.com";
+    }
+    std::string atLimit = quoted(list);
+    TEST_ASSERT_EQUAL_STRING("", stageUpdate(buildUpdate(recipients, atLimit.c_str())).c_str());
+
+    std::string overLimit = quoted(list + ";one.more@example.com");
+    TEST_ASSERT_EQUAL_STRING(CASES[recipients].invalidMessage, stageUpdate(buildUpdate(recipients, overLimit.c_str())).c_str());
+}
+
+void test_first_problem_in_table_order_is_reported() {
+    std::string json = "{\"ssid\": \"\", \"panic_level\": 9}";
+
+    TEST_ASSERT_EQUAL_STRING(CASES[0].requiredMessage, stageUpdate(json).c_str());
+}
+
+void test_trim_range_matches_string_trim() {
+    const char* samples[] = {"", "   ", "abc", "  abc", "abc \t\r\n", " \ta b c\n "};
+    for (const char* sample : samples) {
+        const char* text = sample;
+        size_t length = strlen(sample);
+        SettingsUpdate::trimRange(text, length);
+        String expected = sample;
+        expected.trim();
+        TEST_ASSERT_EQUAL_UINT32(expected.length(), length);
+        TEST_ASSERT_EQUAL_STRING(expected.c_str(), std::string(text, length).c_str());
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_cases_cover_every_exported_setting);
+    RUN_TEST(test_valid_update_is_staged_trimmed);
+    RUN_TEST(test_every_required_message);
+    RUN_TEST(test_every_invalid_message);
+    RUN_TEST(test_factory_values_count_as_missing_where_not_allowed);
+    RUN_TEST(test_numbers_given_as_text_or_fractions);
+    RUN_TEST(test_recipients_are_limited_in_count);
+    RUN_TEST(test_first_problem_in_table_order_is_reported);
+    RUN_TEST(test_trim_range_matches_string_trim);
+
+    return UNITY_END();
+}
@@ -0,0 +1,157 @@
+/*
+ * Tests of the allocation free views of the text settings. Every heap
+ * allocation is counted, which stands in for the heap churn that fragments
+ * the ESP8266's heap over a long uptime. A month of health checks, one a
+ * minute, is simulated through the String getters the callers used before
+ * and through the views they use now.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include <unity.h>
+#include <HeapTracker.h>
+#include <Settings.h>
+
+#define CHECKS_PER_MONTH (30UL * 24UL * 60UL)
+
+static Settings* settings = nullptr;
+
+/**
+ * Gives every setting used by a health check or an alert a value longer 
+ * than the host's small string buffer, so a String copy allocates here the
+ * same as it does on the device.
+*/
+static void setLongValues(Settings &target) {
+    target.setSsid("The-Neighbourhood-Network");
+    target.setPwd("a-fairly-long-wifi-password");
+    target.setSmtpHost("smtp.mail-provider.example.com");
+    target.setSmtpUser("panic-button@mail-provider.example.com");
+    target.setSmtpPwd("an-smtp-app-password-of-some-length");
+    target.setFromEmail("panic-button@mail-provider.example.com");
+    target.setFromName("FriendlyNeighbor PanicButton");
+    target.setRecipients("first.person@example.com;second.person@example.com");
+}
+
+/**
+ * What a health check and the alert setup read, through the String getters.
+*/
+static size_t checkWithStrings(Settings &target) {
+    size_t total = 0U;
+    total += target.getSmtpHost().length();
+    total += target.getSmtpUser().length();
+    total += target.getSmtpPwd().length();
+    total += target.getFromEmail().length();
+    total += target.getFromName().length();
+    total += target.getRecipients().length();
+    total += (String(target.getSsid()) == String("SET_ME")) ? 0U : 1U; // How the factory checks were done
+    total += (String(target.getPwd()) == String("SET_ME")) ? 0U : 1U;
+
+    return total;
+}
+
+/**
+ * The same reads through the views.
+*/
+static size_t checkWithViews(Settings &target) {
+    size_t total = 0U;
+    total += target.viewSmtpHost().length;
+    total += target.viewSmtpUser().length;
+    total += target.viewSmtpPwd().length;
+    total += target.viewFromEmail().length;
+    total += target.viewFromName().length;
+    total += target.viewRecipients().length;
+    total += target.isNetworkSet() ? 2U : 0U;
+
+    return total;
+}
+
+void setUp() {
+    settings = new Settings();
+    setLongValues(*settings);
+}
+
+void tearDown() {
+    delete settings;
+}
+
+void test_views_point_at_the_stored_text() {
+    SettingView view = settings->viewSmtpHost();
+    TEST_ASSERT_EQUAL_UINT32(strlen("smtp.mail-provider.example.com"), view.length);
+    TEST_ASSERT_EQUAL_STRING("smtp.mail-provider.example.com", view.chars);
+    TEST_ASSERT_EQUAL_STRING(settings->getSmtpHost().c_str(), view.chars);
+
+    TEST_ASSERT_EQUAL_UINT8(2U, settings->getRecipientCount());
+    TextSlice second = settings->viewRecipient(1U);
+    TEST_ASSERT_EQUAL_UINT32(strlen("second.person@example.com"), second.length);
+    TEST_ASSERT_EQUAL_STRING_LEN("second.person@example.com", second.chars, second.length);
+    TEST_ASSERT_EQUAL_UINT32(0U, settings->viewRecipient(2U).length);
+}
+
+void test_view_length_stops_at_the_field_capacity() {
+    NonVolatileSettings staged = {};
+    memset(staged.fromName, 'x', sizeof(staged.fromName)); // No terminator, as from corrupt flash...
+    memset(staged.recipients, 'y', sizeof(staged.recipients));
+    settings->applyFields(staged, SETTING_EXPORTED);
+
+    TEST_ASSERT_EQUAL_UINT32(sizeof(staged.fromName), settings->viewFromName().length);
+}
+
+void test_factory_checks_follow_the_stored_text() {
+    Settings fresh;
+    TEST_ASSERT_TRUE(fresh.isSsidFactory());
+    TEST_ASSERT_FALSE(fresh.isNetworkSet());
+    fresh.setSsid("home");
+    TEST_ASSERT_FALSE(fresh.isSsidFactory());
+    TEST_ASSERT_FALSE(fresh.isNetworkSet());
+    fresh.setPwd("secret-secret");
+    TEST_ASSERT_TRUE(fresh.isNetworkSet());
+}
+
+void test_views_and_factory_checks_never_allocate() {
+    unsigned long before = allocationCount;
+    TEST_ASSERT_GREATER_THAN(0U, checkWithViews(*settings));
+    settings->isSsidFactory();
+    settings->isSmtpHostFactory();
+    settings->isRecipientsFactory();
+    settings->viewRecipient(0U);
+    TEST_ASSERT_EQUAL_UINT32(before, allocationCount);
+}
+
+void test_month_of_health_checks_heap_churn() {
+    unsigned long countBefore = allocationCount;
+    unsigned long bytesBefore = allocatedBytes;
+    size_t stringTotal = 0U;
+    for (unsigned long i = 0; i < CHECKS_PER_MONTH; i++) {
+        stringTotal += checkWithStrings(*settings);
+    }
+    unsigned long stringCount = allocationCount - countBefore;
+    unsigned long stringBytes = allocatedBytes - bytesBefore;
+
+    countBefore = allocationCount;
+    bytesBefore = allocatedBytes;
+    size_t viewTotal = 0U;
+    for (unsigned long i = 0; i < CHECKS_PER_MONTH; i++) {
+        viewTotal += checkWithViews(*settings);
+    }
+    unsigned long viewCount = allocationCount - countBefore;
+    unsigned long viewBytes = allocatedBytes - bytesBefore;
+
+    char line[160];
+    snprintf(line, sizeof(line), "Month of health checks: String getters made %lu allocations (%lu bytes), views made %lu (%lu bytes)", stringCount, stringBytes, viewCount, viewBytes);
+    TEST_MESSAGE(line);
+    TEST_ASSERT_EQUAL_UINT32(stringTotal, viewTotal); // Same answers either way...
+    TEST_ASSERT_GREATER_OR_EQUAL(CHECKS_PER_MONTH * 6UL, stringCount);
+    TEST_ASSERT_EQUAL_UINT32(0UL, viewCount);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_views_point_at_the_stored_text);
+    RUN_TEST(test_view_length_stops_at_the_field_capacity);
+    RUN_TEST(test_factory_checks_follow_the_stored_text);
+    RUN_TEST(test_views_and_factory_checks_never_allocate);
+    RUN_TEST(test_month_of_health_checks_heap_churn);
+
+    return UNITY_END();
+}
@@ -0,0 +1,164 @@
+/*
+ * Tests of the SmtpConnection against the stand-in SMTP server, which takes
+ * 1.5 s of fake time for a full connect and drops sessions idle for more
+ * than 5 minutes. Besides checking when the session is reused, verified or
+ * reconnected, the time an alert waits for a ready session is compared
+ * with connecting for every alert as was done before.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include <unity.h>
+#include <SmtpConnection.h>
+
+static Session_Config config;
+
+/**
+ * Sends an alert the way the dispatcher does, through a ready session.
+ *
+ * @return Returns how long the alert waited for the session in millis as
+ * unsigned long.
+*/
+static unsigned long sendAlert(SmtpConnection &connection) {
+    unsigned long start = millis();
+    TEST_ASSERT_TRUE(connection.ensureConnected());
+    unsigned long waited = millis() - start;
+    TEST_ASSERT_TRUE(connection.getSession()->sendCustomCommand(F("DATA"), nullptr));
+    connection.markActive();
+
+    return waited;
+}
+
+/**
+ * Moves the fake clock on, calling keepWarm every 10 seconds as the
+ * scheduler does if asked to.
+*/
+static void idle(SmtpConnection &connection, unsigned long ms, bool isKeptWarm) {
+    for (unsigned long waited = 0UL; waited < ms; waited += 10000UL) {
+        fakeMillis += 10000UL;
+        if (isKeptWarm) {
+            connection.keepWarm();
+        }
+    }
+}
+
+void setUp() {
+    fakeMillis = 1000UL;
+    SMTPSession::isServerUp = true;
+    SMTPSession::connects = 0UL;
+    SMTPSession::commands = 0UL;
+}
+
+void tearDown() {}
+
+void test_open_session_is_reused_without_a_round_trip() {
+    SmtpConnection connection(&config);
+    sendAlert(connection);
+    unsigned long commands = SMTPSession::commands;
+
+    fakeMillis += SMTP_IDLE_VERIFY_MS - 1000UL;
+    TEST_ASSERT_TRUE(connection.ensureConnected());
+    TEST_ASSERT_EQUAL_UINT32(commands, SMTPSession::commands);
+    TEST_ASSERT_EQUAL_UINT32(1UL, connection.getConnectCount());
+    TEST_ASSERT_EQUAL_UINT32(1UL, connection.getReuseCount());
+}
+
+void test_idle_session_is_verified_with_noop_before_reuse() {
+    SmtpConnection connection(&config);
+    sendAlert(connection);
+    unsigned long commands = SMTPSession::commands;
+
+    fakeMillis += SMTP_IDLE_VERIFY_MS + 1000UL; // Still within the server's timeout...
+    TEST_ASSERT_TRUE(connection.ensureConnected());
+    TEST_ASSERT_EQUAL_UINT32(commands + 1UL, SMTPSession::commands);
+    TEST_ASSERT_EQUAL_UINT32(1UL, SMTPSession::connects);
+}
+
+void test_dropped_session_is_found_and_reconnected() {
+    SmtpConnection connection(&config);
+    sendAlert(connection);
+
+    idle(connection, 10UL * 60000UL, false); // Server drops it...
+    TEST_ASSERT_TRUE(connection.getSession()->connected()); // Client doesn't know yet...
+    sendAlert(connection);
+    TEST_ASSERT_EQUAL_UINT32(2UL, SMTPSession::connects);
+}
+
+void test_keep_warm_holds_the_session_open_while_idle() {
+    SmtpConnection connection(&config);
+    sendAlert(connection);
+
+    idle(connection, 60UL * 60000UL, true);
+    TEST_ASSERT_EQUAL_UINT32(0UL, sendAlert(connection));
+    TEST_ASSERT_EQUAL_UINT32(1UL, SMTPSession::connects);
+}
+
+void test_keep_warm_is_quiet_while_in_use_and_never_connects() {
+    SmtpConnection connection(&config);
+    TEST_ASSERT_FALSE(connection.keepWarm()); // Nothing open...
+    TEST_ASSERT_EQUAL_UINT32(0UL, SMTPSession::connects);
+
+    sendAlert(connection);
+    unsigned long commands = SMTPSession::commands;
+    fakeMillis += SMTP_KEEP_ALIVE_MS - 1000UL;
+    TEST_ASSERT_TRUE(connection.keepWarm());
+    TEST_ASSERT_EQUAL_UINT32(commands, SMTPSession::commands);
+
+    SMTPSession::isServerUp = false;
+    fakeMillis += 2000UL;
+    TEST_ASSERT_FALSE(connection.keepWarm()); // Stale, closed for the next check to reconnect...
+    TEST_ASSERT_FALSE(connection.getSession()->connected());
+    TEST_ASSERT_EQUAL_UINT32(1UL, SMTPSession::connects);
+}
+
+void test_health_check_reconnects_when_nothing_is_open() {
+    SmtpConnection connection(&config);
+    TEST_ASSERT_TRUE(connection.keepAlive());
+    TEST_ASSERT_EQUAL_UINT32(1UL, SMTPSession::connects);
+    TEST_ASSERT_TRUE(connection.keepAlive());
+    TEST_ASSERT_EQUAL_UINT32(1UL, SMTPSession::connects);
+
+    SMTPSession::isServerUp = false;
+    TEST_ASSERT_FALSE(connection.keepAlive());
+}
+
+void test_time_to_ready_against_connecting_for_every_alert() {
+    const unsigned long GAPS[] = {5000UL, 40000UL, 200000UL, 900000UL, 3600000UL, 20000UL, 7200000UL, 60000UL};
+    const int ALERTS = sizeof(GAPS) / sizeof(GAPS[0]);
+
+    SmtpConnection warm(&config);
+    unsigned long warmTotal = 0UL;
+    for (int i = 0; i < ALERTS; i++) {
+        idle(warm, GAPS[i], true);
+        warmTotal += sendAlert(warm);
+    }
+
+    unsigned long coldTotal = 0UL;
+    for (int i = 0; i < ALERTS; i++) { // The old way, a fresh session each time...
+        SmtpConnection cold(&config);
+        fakeMillis += GAPS[i];
+        coldTotal += sendAlert(cold);
+        cold.close();
+    }
+
+    char line[120];
+    snprintf(line, sizeof(line), "Average wait for a ready session: %lu ms warm, %lu ms connecting each time", warmTotal / ALERTS, coldTotal / ALERTS);
+    TEST_MESSAGE(line);
+    TEST_ASSERT_EQUAL_UINT32((unsigned long)ALERTS * SMTPSession::connectMs, coldTotal);
+    TEST_ASSERT_EQUAL_UINT32(1UL, warm.getConnectCount()); // Only the first alert connected...
+    TEST_ASSERT_LESS_THAN(coldTotal / 4UL, warmTotal);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_open_session_is_reused_without_a_round_trip);
+    RUN_TEST(test_idle_session_is_verified_with_noop_before_reuse);
+    RUN_TEST(test_dropped_session_is_found_and_reconnected);
+    RUN_TEST(test_keep_warm_holds_the_session_open_while_idle);
+    RUN_TEST(test_keep_warm_is_quiet_while_in_use_and_never_connects);
+    RUN_TEST(test_health_check_reconnects_when_nothing_is_open);
+    RUN_TEST(test_time_to_ready_against_connecting_for_every_alert);
+
+    return UNITY_END();
+}
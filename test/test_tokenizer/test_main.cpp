@@ -0,0 +1,198 @@
+/*
+ * Tests of the TokenIterator the recipients are walked through with. The
+ * tokens are checked against splitting, trimming and dropping empty pieces
+ * with std::string, for a trailing separator, doubled and blank separators,
+ * an empty list and a list filling all 509 characters of the setting. No
+ * token is ever copied, so walking a list must not allocate.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include <unity.h>
+#include <HeapTracker.h>
+#include <string>
+#include <vector>
+#include <Settings.h>
+
+#define RECIPIENTS_CAPACITY (sizeof(((NonVolatileSettings*)nullptr)->recipients) - 1U)
+
+/**
+ * The reference, splitting on every separator then trimming each piece
+ * and leaving out the empty ones.
+*/
+static std::vector<std::string> referenceTokens(const std::string &list, char separator) {
+    std::vector<std::string> tokens;
+    size_t from = 0U;
+    while (from <= list.length()) {
+        size_t to = list.find(separator, from);
+        if (to == std::string::npos) {
+            to = list.length();
+        }
+        std::string piece = list.substr(from, to - from);
+        size_t first = piece.find_first_not_of(" \t\r\n");
+        if (first != std::string::npos) {
+            tokens.push_back(piece.substr(first, piece.find_last_not_of(" \t\r\n") - first + 1U));
+        }
+        from = to + 1U;
+    }
+
+    return tokens;
+}
+
+static std::vector<std::string> iteratorTokens(TokenIterator tokens) {
+    std::vector<std::string> result;
+    TextSlice token;
+    while (tokens.next(token)) {
+        result.push_back(std::string(token.chars, token.length));
+    }
+
+    return result;
+}
+
+static void assertSameTokens(const std::string &list) {
+    std::vector<std::string> expected = referenceTokens(list, ';');
+    std::vector<std::string> actual = iteratorTokens(ParseUtils::tokenize(list, ';'));
+
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(expected.size(), actual.size(), list.c_str());
+    for (size_t i = 0U; i < expected.size(); i ++) {
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(expected[i].c_str(), actual[i].c_str(), list.c_str());
+    }
+}
+
+/**
+ * @return Returns a list of the most recipients allowed which is exactly
+ * as long as the setting can hold as std::string.
+*/
+static std::string fullRecipientList() {
+    std::string list;
+    size_t addressLength = (RECIPIENTS_CAPACITY - (SETTINGS_MAX_RECIPIENTS - 1U)) / SETTINGS_MAX_RECIPIENTS;
+    size_t longer = (RECIPIENTS_CAPACITY - (SETTINGS_MAX_RECIPIENTS - 1U)) % SETTINGS_MAX_RECIPIENTS;
+    for (size_t i = 0U; i < SETTINGS_MAX_RECIPIENTS; i ++) {
+        std::string address = std::string(1U, (char)('a' + i)) + "@example.com";
+        address.insert(1U, addressLength + ((i < longer) ? 1U : 0U) - address.length(), 'x');
+        list += (list.empty() ? "" : ";") + address;
+    }
+
+    return list;
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_edge_cases_match_the_reference() {
+    const char* lists[] = {
+        "", ";", ";;;", "   ", " ; ; ", "a@b.co", "a@b.co;", "a@b.co;;", ";a@b.co", ";;a@b.co;;c@d.co;;",
+        "a@b.co; ;c@d.co", " a@b.co ;\tc@d.co\r\n", "a@b.co;;;;;c@d.co", "a b@c.co ; d"
+    };
+    for (const char* list : lists) {
+        assertSameTokens(list);
+    }
+    std::vector<std::string> tokens = iteratorTokens(ParseUtils::tokenize(std::string(" first@example.com ;; second@example.com; "), ';'));
+
+    TEST_ASSERT_EQUAL_UINT32(2U, tokens.size());
+    TEST_ASSERT_EQUAL_STRING("first@example.com", tokens[0].c_str());
+    TEST_ASSERT_EQUAL_STRING("second@example.com", tokens[1].c_str());
+}
+
+void test_empty_list_has_no_tokens() {
+    TextSlice token = {nullptr, 0U};
+    TokenIterator tokens(nullptr, 0U, ';');
+
+    TEST_ASSERT_FALSE(tokens.next(token));
+    TEST_ASSERT_FALSE(tokens.next(token)); // Stays ended...
+    TEST_ASSERT_NULL(token.chars);
+}
+
+void test_every_mix_of_separators_and_blanks_matches_the_reference() {
+    const char pieces[] = {';', ' ', 'a', 'b'};
+    for (unsigned int mix = 0U; mix < (1U << 16); mix ++) { // Every list of 8 pieces...
+        std::string list;
+        for (unsigned int i = 0U; i < 8U; i ++) {
+            list += pieces[(mix >> (i * 2U)) & 0x03U];
+        }
+        assertSameTokens(list);
+    }
+}
+
+void test_stops_at_the_length_given() {
+    const char buffer[] = "a@b.co;c@d.co;e@f.co";
+    TokenIterator tokens(buffer, 9U, ';'); // Ends part way into the second...
+    std::vector<std::string> actual = iteratorTokens(tokens);
+
+    TEST_ASSERT_EQUAL_UINT32(2U, actual.size());
+    TEST_ASSERT_EQUAL_STRING("c@", actual[1].c_str());
+}
+
+void test_full_length_recipient_list() {
+    std::string list = fullRecipientList();
+    TEST_ASSERT_EQUAL_UINT32(509U, RECIPIENTS_CAPACITY);
+    TEST_ASSERT_EQUAL_UINT32(RECIPIENTS_CAPACITY, list.length());
+    assertSameTokens(list);
+    assertSameTokens(list + ";");
+    std::vector<std::string> expected = referenceTokens(list, ';');
+    TEST_ASSERT_EQUAL_UINT32(SETTINGS_MAX_RECIPIENTS, expected.size());
+
+    char stored[RECIPIENTS_CAPACITY + 1U];
+    strcpy(stored, list.c_str());
+    TEST_ASSERT_TRUE(Settings::normalizeRecipients(stored));
+    TEST_ASSERT_EQUAL_STRING(list.c_str(), stored);
+
+    ESP.eraseAll();
+    EEPROM.clear();
+    Settings settings;
+    settings.setRecipients(list.c_str());
+    TEST_ASSERT_EQUAL_UINT8(SETTINGS_MAX_RECIPIENTS, settings.getRecipientCount());
+    for (uint8_t i = 0U; i < SETTINGS_MAX_RECIPIENTS; i ++) {
+        TextSlice recipient = settings.viewRecipient(i);
+        TEST_ASSERT_EQUAL_STRING(expected[i].c_str(), std::string(recipient.chars, recipient.length).c_str());
+    }
+}
+
+void test_invalid_stored_recipients_are_reported() {
+    ESP.eraseAll();
+    EEPROM.clear();
+    Settings settings;
+    Serial.captured.clear();
+    Serial.isCapturing = true;
+    settings.setRecipients("first@example.com;not an address;second@example.com"); // As stored by older firmware...
+    Serial.isCapturing = false;
+
+    TEST_ASSERT_EQUAL_UINT8(2U, settings.getRecipientCount());
+    TEST_ASSERT_TRUE(Serial.captured.find("'not an address' is not a valid email address") != std::string::npos);
+    TextSlice second = settings.viewRecipient(1U);
+    TEST_ASSERT_EQUAL_STRING("second@example.com", std::string(second.chars, second.length).c_str());
+}
+
+void test_walking_a_list_does_not_allocate() {
+    std::string list = fullRecipientList();
+    String arduinoList = list.c_str();
+    size_t total = 0U;
+    allocationCount = 0UL;
+    TextSlice token;
+    TokenIterator tokens = ParseUtils::tokenize(list, ';');
+    while (tokens.next(token)) {
+        total += token.length;
+    }
+    TokenIterator arduinoTokens = ParseUtils::tokenize(arduinoList, ';');
+    while (arduinoTokens.next(token)) {
+        total += token.length;
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0UL, allocationCount);
+    TEST_ASSERT_EQUAL_UINT32(2U * (RECIPIENTS_CAPACITY - (SETTINGS_MAX_RECIPIENTS - 1U)), total);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_edge_cases_match_the_reference);
+    RUN_TEST(test_empty_list_has_no_tokens);
+    RUN_TEST(test_every_mix_of_separators_and_blanks_matches_the_reference);
+    RUN_TEST(test_stops_at_the_length_given);
+    RUN_TEST(test_full_length_recipient_list);
+    RUN_TEST(test_invalid_stored_recipients_are_reported);
+    RUN_TEST(test_walking_a_list_does_not_allocate);
+
+    return UNITY_END();
+}
@@ -0,0 +1,235 @@
+/*
+ * Tests of the URL decoding in ParseUtils. decodeUrl is checked for every
+ * escape, for '+' and for escapes which are cut short or aren't hex, then
+ * both decodeUrlString overloads are checked against a plain decoder over
+ * random input. Decoding in place is checked not to touch the heap. Ends
+ * with a benchmark over a 1 KB form body of decodeUrl and decodeUrlString
+ * against the 34 replace() passes the String overload made before.
+ *
+ * Written by: Scott Griffis
+ * Date: 10-16-2026
+*/
+
+#include <unity.h>
+#include <HeapTracker.h>
+#include <chrono>
+#include <random>
+#include <string>
+#include <ctype.h>
+#include <stdio.h>
+#include <ParseUtils.h>
+
+#define RANDOM_URLS 20000UL
+#define FORM_BODY_SIZE 1024U
+#define BENCHMARK_RUNS 2000UL
+
+static std::mt19937 random32(20261016UL);
+
+/**
+ * The plain decoder URL decoding is checked against.
+*/
+static std::string referenceDecodeUrl(const std::string &encoded) {
+    std::string decoded;
+    for (size_t i = 0U; i < encoded.length(); i ++) {
+        if (encoded[i] == '+') {
+            decoded += ' ';
+        } else if (encoded[i] == '%' && (i + 2U) < encoded.length() && isxdigit((unsigned char)encoded[i + 1U]) && isxdigit((unsigned char)encoded[i + 2U])) {
+            decoded += (char)strtoul(encoded.substr(i + 1U, 2U).c_str(), nullptr, 16);
+            i += 2U;
+        } else {
+            decoded += encoded[i];
+        }
+    }
+
+    return decoded;
+}
+
+/**
+ * The String decoding as it was before, kept to benchmark against.
+*/
+static String legacyDecodeUrlString(String &str) {
+    str.replace("%20", " ");
+    str.replace("%21", "!");
+    str.replace("%23", "#");
+    str.replace("%24", "$");
+    str.replace("%26", "&");
+    str.replace("%27", "'");
+    str.replace("%28", "(");
+    str.replace("%29", ")");
+    str.replace("%2A", "*");
+    str.replace("+", " ");
+    str.replace("%2B", "+");
+    str.replace("%2C", ",");
+    str.replace("%2F", "/");
+    str.replace("%3A", ":");
+    str.replace("%3B", ";");
+    str.replace("%3D", "=");
+    str.replace("%3F", "?");
+    str.replace("%40", "@");
+    str.replace("%5B", "[");
+    str.replace("%2D", "]");
+    str.replace("%22", "\"");
+    str.replace("%25", "%");
+    str.replace("%2D", "-");
+    str.replace("%2E", ".");
+    str.replace("%3C", "<");
+    str.replace("%3E", ">");
+    str.replace("%5C", "\\");
+    str.replace("%5E", "^");
+    str.replace("%5F", "_");
+    str.replace("%60", "`");
+    str.replace("%7B", "{");
+    str.replace("%7C", "|");
+    str.replace("%7D", "}");
+    str.replace("%7E", "~");
+
+    return str;
+}
+
+/**
+ * @return Returns the text decoded through decodeUrl as std::string.
+*/
+static std::string decoded(const std::string &encoded) {
+    std::string text = encoded;
+    text.resize(ParseUtils::decodeUrl(&text[0], text.length()));
+
+    return text;
+}
+
+/**
+ * @return Returns a form body of about FORM_BODY_SIZE characters, like the
+ * admin page posts, of fields whose values are mostly plain text with
+ * spaces as '+' and punctuation escaped, as std::string.
+*/
+static std::string formBody() {
+    static const char* const FIELDS[] = {
+        "ssid=Home+Network%202.4GHz",
+        "pwd=p%40ss%21w0rd%23%24%25",
+        "owner=Jane+Q.+Public",
+        "message=Please+send+help+ASAP%21+I%27m+at+home.",
+        "smtp_host=smtp.example.com",
+        "smtp_port=465",
+        "smtp_user=alerts%40example.com",
+        "from_name=FriendlyNeighbor+PanicButton",
+        "recipients=a%40example.com%3Bb%40example.com%3Bc%40example.com"
+    };
+    std::string body;
+    for (size_t i = 0U; body.length() < FORM_BODY_SIZE; i ++) {
+        if (!body.empty()) {
+            body += '&';
+        }
+        body += FIELDS[i % (sizeof(FIELDS) / sizeof(FIELDS[0]))];
+    }
+    body.resize(FORM_BODY_SIZE);
+
+    return body;
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_every_escape_is_decoded() {
+    char encoded[4];
+    for (int c = 0; c < 256; c ++) {
+        for (const char* format : {"%%%02X", "%%%02x"}) {
+            snprintf(encoded, sizeof(encoded), format, c);
+            std::string text = decoded(encoded);
+            TEST_ASSERT_EQUAL_UINT32_MESSAGE(1U, text.length(), encoded);
+            TEST_ASSERT_EQUAL_HEX32_MESSAGE((uint32_t)c, (uint32_t)(uint8_t)text[0], encoded);
+        }
+    }
+}
+
+void test_plus_and_cut_short_escapes() {
+    TEST_ASSERT_EQUAL_STRING("a b c", decoded("a+b%20c").c_str());
+    TEST_ASSERT_EQUAL_STRING("+", decoded("%2B").c_str()); // Not turned to a space after...
+    TEST_ASSERT_EQUAL_STRING("%", decoded("%").c_str());
+    TEST_ASSERT_EQUAL_STRING("%4", decoded("%4").c_str());
+    TEST_ASSERT_EQUAL_STRING("%GG", decoded("%GG").c_str());
+    TEST_ASSERT_EQUAL_STRING("%4G", decoded("%4G").c_str());
+    TEST_ASSERT_EQUAL_STRING("%A", decoded("%%41").c_str());
+    TEST_ASSERT_EQUAL_STRING("%25", decoded("%2525").c_str()); // Decoded only once...
+    TEST_ASSERT_EQUAL_STRING("", decoded("").c_str());
+}
+
+void test_url_decoding_matches_the_reference() {
+    const char pieces[][4] = {"%", "%2", "%20", "%2B", "%2b", "%GG", "%%", "%41", "+", "a", "Z", "%0", "%e9", "%25"};
+    for (unsigned long i = 0UL; i < RANDOM_URLS; i ++) {
+        std::string encoded;
+        size_t count = random32() % 8U;
+        for (size_t j = 0U; j < count; j ++) {
+            encoded += pieces[random32() % (sizeof(pieces) / sizeof(pieces[0]))];
+        }
+        std::string expected = referenceDecodeUrl(encoded);
+        std::string text = encoded;
+        ParseUtils::decodeUrlString(text);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(expected.length(), text.length(), encoded.c_str());
+        TEST_ASSERT_EQUAL_MEMORY_MESSAGE(expected.data(), text.data(), expected.length(), encoded.c_str());
+        String arduinoText = encoded;
+        ParseUtils::decodeUrlString(arduinoText);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(expected.length(), arduinoText.length(), encoded.c_str());
+        TEST_ASSERT_EQUAL_MEMORY_MESSAGE(expected.data(), arduinoText.c_str(), expected.length(), encoded.c_str());
+    }
+}
+
+void test_decoding_in_place_allocates_nothing() {
+    std::string body = formBody();
+    std::string expected = referenceDecodeUrl(body);
+
+    resetHeapStats();
+    size_t length = ParseUtils::decodeUrl(&body[0], body.length());
+    TEST_ASSERT_EQUAL_UINT32(0UL, allocationCount);
+    TEST_ASSERT_EQUAL_UINT32(expected.length(), length);
+    TEST_ASSERT_EQUAL_MEMORY(expected.data(), body.data(), length);
+}
+
+void test_benchmark_over_a_form_body() {
+    const std::string body = formBody();
+    const String arduinoBody = body;
+    std::string buffer;
+    buffer.reserve(body.length());
+    size_t decodeLength = 0U;
+    size_t stringLength = 0U;
+    size_t legacyLength = 0U;
+
+    auto started = std::chrono::steady_clock::now();
+    for (unsigned long run = 0UL; run < BENCHMARK_RUNS; run ++) {
+        String text = arduinoBody;
+        legacyLength += legacyDecodeUrlString(text).length();
+    }
+    double legacyUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count() / BENCHMARK_RUNS;
+
+    started = std::chrono::steady_clock::now();
+    for (unsigned long run = 0UL; run < BENCHMARK_RUNS; run ++) {
+        String text = arduinoBody;
+        stringLength += ParseUtils::decodeUrlString(text).length();
+    }
+    double stringUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count() / BENCHMARK_RUNS;
+
+    started = std::chrono::steady_clock::now();
+    for (unsigned long run = 0UL; run < BENCHMARK_RUNS; run ++) {
+        buffer.assign(body);
+        decodeLength += ParseUtils::decodeUrl(&buffer[0], buffer.length());
+    }
+    double decodeUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count() / BENCHMARK_RUNS;
+
+    char report[200];
+    snprintf(report, sizeof(report), "Per %u byte form body: 34 replace() passes %.2f us, decodeUrlString %.2f us, decodeUrl %.2f us (copy included)", FORM_BODY_SIZE, legacyUs, stringUs, decodeUs);
+    TEST_MESSAGE(report);
+
+    TEST_ASSERT_EQUAL_UINT32(referenceDecodeUrl(body).length() * BENCHMARK_RUNS, decodeLength);
+    TEST_ASSERT_EQUAL_UINT32(decodeLength, stringLength);
+    TEST_ASSERT_EQUAL_UINT32(decodeLength, legacyLength); // Every escape in the body is one it knew...
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_every_escape_is_decoded);
+    RUN_TEST(test_plus_and_cut_short_escapes);
+    RUN_TEST(test_url_decoding_matches_the_reference);
+    RUN_TEST(test_decoding_in_place_allocates_nothing);
+    RUN_TEST(test_benchmark_over_a_form_body);
+
+    return UNITY_END();
+}